@@ -0,0 +1,148 @@
+// Banc d'essai des analyseurs de partitions texte : parseMusicFile (un std::stringstream par ligne)
+// contre ScoreTextParser (analyse en place sur le fichier projeté).
+//
+// Usage : MusicaLauParserBench [--lines N] [--runs R] [--file chemin] [--keep]
+//
+// Génère une partition de N lignes (1 000 000 par défaut), la lit R fois avec chaque analyseur et
+// garde le meilleur temps. Vérifie que les deux donnent les mêmes notes aux mêmes trames, affiche
+// le temps jusqu'à la première tranche en mode flux, puis le rapport de vitesse (objectif : 10x).
+// Code de retour 0 si l'objectif est atteint et les résultats identiques.
+// Les chiffres n'ont de sens qu'en Release (cmake -DCMAKE_BUILD_TYPE=Release).
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../include/Audio/MusicFileReader.h"
+#include "../include/Audio/CompiledScore.h"
+#include "../include/Audio/ScoreTextParser.h"
+
+using MusicApp::Audio::CompiledScore;
+using MusicApp::Audio::ScoreEventRecord;
+using MusicApp::Audio::ScoreTextParser;
+
+namespace {
+    const double TARGET_SPEEDUP = 10.0;
+
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Partition représentative : dièses, bémols, boutons 8-bit, silences, durées de longueurs variées
+    bool writeScore(const std::string &path, long long lines) {
+        static const char *const PITCHES[] = {"C4", "D4", "E4", "F#4", "G4", "A4", "Bb4", "C5",
+                                              "Db3", "G#5", "8bit_3", "8bit_17", "0", "Unknown"};
+        static const char *const DURATIONS[] = {"0.25", "0.5", "0.125", "1", "0.375", "1.5", "0.0625"};
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::fprintf(stderr, "Could not create %s\n", path.c_str());
+            return false;
+        }
+        Uint32 state = 12345u; // Générateur congruentiel : même fichier à chaque exécution
+        std::string line;
+        for (long long i = 0; i < lines; ++i) {
+            state = state * 1664525u + 1013904223u;
+            line = PITCHES[(state >> 8) % SDL_arraysize(PITCHES)];
+            line += ' ';
+            line += DURATIONS[(state >> 20) % SDL_arraysize(DURATIONS)];
+            line += '\n';
+            file << line;
+        }
+        return static_cast<bool>(file);
+    }
+
+    bool sameEvents(const std::vector<ScoreEventRecord> &a, const std::vector<ScoreEventRecord> &b) {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(), [](const ScoreEventRecord &x, const ScoreEventRecord &y) {
+                   return x.onsetFrame == y.onsetFrame && x.durationFrames == y.durationFrames &&
+                          x.midiNumber == y.midiNumber && x.velocity == y.velocity;
+               });
+    }
+}
+
+int main(int argc, char *argv[]) {
+    long long lines = 1000000;
+    int runs = 3;
+    std::string path = "score_parser_bench.txt";
+    bool keepFile = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--lines") == 0 && i + 1 < argc) {
+            lines = std::max(1LL, std::atoll(argv[++i]));
+        } else if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--file") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else if (std::strcmp(argv[i], "--keep") == 0) {
+            keepFile = true;
+        } else {
+            std::fprintf(stderr, "Usage: %s [--lines N] [--runs R] [--file path] [--keep]\n", argv[0]);
+            return 2;
+        }
+    }
+
+#if defined(__GNUC__) && !defined(__OPTIMIZE__)
+    std::printf("Warning: built without optimizations, configure with -DCMAKE_BUILD_TYPE=Release.\n");
+#endif
+
+    if (!writeScore(path, lines)) {
+        return 2;
+    }
+
+    // Référence : analyse ligne par ligne, puis conversion en trames comme le faisait SongPlayer
+    double baselineMs = 0.0;
+    std::vector<MusicalEvent> baselineEvents;
+    for (int run = 0; run < runs; ++run) {
+        const Clock::time_point start = Clock::now();
+        baselineEvents = parseMusicFile(path);
+        const double elapsed = millisecondsSince(start);
+        baselineMs = run == 0 ? elapsed : std::min(baselineMs, elapsed);
+    }
+    Uint64 baselineLength = 0;
+    const std::vector<ScoreEventRecord> baselineRecords = CompiledScore::fromMusicalEvents(baselineEvents,
+                                                                                         baselineLength);
+
+    double fastMs = 0.0;
+    ScoreTextParser::Result fast;
+    for (int run = 0; run < runs; ++run) {
+        const Clock::time_point start = Clock::now();
+        fast = ScoreTextParser::parseFile(path);
+        const double elapsed = millisecondsSince(start);
+        fastMs = run == 0 ? elapsed : std::min(fastMs, elapsed);
+    }
+
+    // Mode flux : délai avant que SongPlayer puisse commencer à jouer
+    const Clock::time_point streamStart = Clock::now();
+    ScoreTextParser streamingParser;
+    std::vector<ScoreEventRecord> firstChunk;
+    if (streamingParser.open(path)) {
+        streamingParser.parseChunk(firstChunk);
+    }
+    const double firstChunkMs = millisecondsSince(streamStart);
+
+    const bool identical = fast.opened && fast.errorCount == 0 && sameEvents(baselineRecords, fast.events) &&
+                           baselineLength == fast.lengthFrames;
+    const double speedup = fastMs > 0.0 ? baselineMs / fastMs : 0.0;
+
+    std::printf("Score: %lld lines, %zu notes, best of %d runs\n", lines, fast.events.size(), runs);
+    std::printf("  parseMusicFile      %10.2f ms  %8.1f Mlines/s\n", baselineMs, lines / (baselineMs * 1e3));
+    std::printf("  ScoreTextParser     %10.2f ms  %8.1f Mlines/s\n", fastMs, lines / (fastMs * 1e3));
+    std::printf("  first chunk (%zu)  %10.3f ms\n", ScoreTextParser::DEFAULT_CHUNK_EVENTS, firstChunkMs);
+    std::printf("  results             %s\n", identical ? "identical" : "DIFFERENT");
+    std::printf("  speedup             %10.1fx (target %.0fx: %s)\n", speedup, TARGET_SPEEDUP,
+                speedup >= TARGET_SPEEDUP ? "PASS" : "FAIL");
+
+    if (!keepFile) {
+        std::remove(path.c_str());
+    }
+    return identical && speedup >= TARGET_SPEEDUP ? 0 : 1;
+}
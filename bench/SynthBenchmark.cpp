@@ -0,0 +1,162 @@
+// Banc d'essai hors ligne du moteur de synthèse : aucun périphérique audio n'est ouvert.
+//
+// Usage : MusicaLauBench [--seconds S] [--kernels scalar|sse2|avx2] [--csv]
+//
+// Pour chaque timbre (piano, xylophone, 8-bit), chaque polyphonie et chaque taille de bloc,
+// rend S secondes de notes tenues et affiche le coût par trame stéréo, le coût par voix et par
+// trame (rapporté aux voix réellement actives), et le facteur temps réel (durée audio / durée de calcul).
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "../include/Audio/Synthesizer.h"
+
+using MusicApp::Audio::AudioCommand;
+using MusicApp::Audio::InstrumentId;
+using MusicApp::Audio::Synthesizer;
+namespace MixKernels = MusicApp::Audio::MixKernels;
+
+namespace {
+    struct Instrument {
+        const char *name;
+        InstrumentId id;
+    };
+
+    const Instrument INSTRUMENTS[] = {
+            {"piano",     InstrumentId::Piano},
+            {"xylophone", InstrumentId::Xylophone},
+            {"8bit",      InstrumentId::Chiptune8Bit},
+            {"guitar",    InstrumentId::Guitar},
+    };
+    const int POLYPHONY_LEVELS[] = {1, 8, 16, 32, 64, 128};
+    const int BLOCK_SIZES[] = {64, 256, 1024, 4096};
+
+    struct Result {
+        double nsPerFrame;
+        double nsPerVoiceFrame;
+        double realtimeFactor;
+    };
+
+    const int PITCH_SPAN = 60; // 5 octaves à partir de C2
+
+    // Faux si le synthétiseur n'a pas autant de voix actives que demandé : le coût par voix serait faux
+    bool run(const Instrument &instrument, int polyphony, int blockFrames, double seconds, Result &result) {
+        Synthesizer synthesizer(static_cast<std::size_t>(polyphony));
+        synthesizer.setMaxBlockFrames(blockFrames);
+
+        // Voix tenues réparties sur 5 octaves à partir de C2, toutes avec la même vélocité.
+        // Au-delà de 5 octaves, les hauteurs se répètent dans une autre session : (instrument, hauteur,
+        // session) reste unique et aucune voix n'en remplace une autre
+        for (int voice = 0; voice < polyphony; ++voice) {
+            AudioCommand noteOn;
+            noteOn.type = AudioCommand::Type::NoteOn;
+            noteOn.instrumentId = instrument.id;
+            noteOn.pitchId = static_cast<Uint8>(36 + voice % PITCH_SPAN);
+            noteOn.sessionId = static_cast<MusicApp::Audio::SessionId>(voice / PITCH_SPAN);
+            noteOn.frequency = 440.0f * std::pow(2.0f, (static_cast<float>(noteOn.pitchId) - 69.0f) / 12.0f);
+            noteOn.velocity = 0.8f;
+            synthesizer.applyCommand(noteOn);
+        }
+
+        const std::size_t activeVoices = synthesizer.getActiveVoiceCount();
+        if (activeVoices != static_cast<std::size_t>(polyphony)) {
+            std::fprintf(stderr, "%s: %zu active voices for a polyphony of %d\n", instrument.name, activeVoices,
+                         polyphony);
+            return false;
+        }
+
+        // Un bloc de chauffe hors mesure (caches, tables)
+        synthesizer.renderBlock(blockFrames);
+
+        const long long totalFrames = static_cast<long long>(seconds * Synthesizer::SAMPLE_RATE);
+        const long long blocks = std::max(1LL, totalFrames / blockFrames);
+        volatile float sink = 0.0f; // Empêche le compilateur d'éliminer le rendu
+
+        // Voix réellement rendues à chaque bloc : une corde pincée s'éteint avant la fin de la mesure
+        double renderedVoiceBlocks = 0.0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (long long block = 0; block < blocks; ++block) {
+            renderedVoiceBlocks += static_cast<double>(synthesizer.getActiveVoiceCount());
+            sink = sink + synthesizer.renderBlock(blockFrames)[0];
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        const double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        const double renderedFrames = static_cast<double>(blocks * blockFrames);
+        const double meanActiveVoices = renderedVoiceBlocks / static_cast<double>(blocks);
+        result.nsPerFrame = elapsedNs / renderedFrames;
+        result.nsPerVoiceFrame = meanActiveVoices > 0.0 ? result.nsPerFrame / meanActiveVoices : 0.0;
+        result.realtimeFactor = (renderedFrames / Synthesizer::SAMPLE_RATE) / (elapsedNs * 1e-9);
+        return true;
+    }
+
+    void printUsage(const char *program) {
+        std::printf("Usage: %s [--seconds S] [--kernels scalar|sse2|avx2] [--csv]\n", program);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    double seconds = 2.0;
+    bool csv = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = std::atof(argv[++i]);
+            if (seconds <= 0.0) seconds = 2.0;
+        } else if (std::strcmp(argv[i], "--kernels") == 0 && i + 1 < argc) {
+            const std::string kernels = argv[++i];
+            if (kernels == "scalar") {
+                MixKernels::forceInstructionSet(MixKernels::InstructionSet::Scalar);
+            } else if (kernels == "sse2") {
+                MixKernels::forceInstructionSet(MixKernels::InstructionSet::SSE2);
+            } else if (kernels == "avx2") {
+                MixKernels::forceInstructionSet(MixKernels::InstructionSet::AVX2);
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    MixKernels::prepare();
+    const char *kernelsName = MixKernels::instructionSetName(MixKernels::activeInstructionSet());
+
+    if (csv) {
+        std::printf("instrument,polyphony,block_frames,kernels,ns_per_frame,ns_per_voice_frame,realtime_factor\n");
+    } else {
+        std::printf("MusicaLauBench: %.1f s per case, %u Hz, kernels: %s\n\n", seconds, Synthesizer::SAMPLE_RATE,
+                    kernelsName);
+        std::printf("%-10s %5s %6s %14s %16s %12s\n", "instrument", "voices", "block", "ns/frame", "ns/voice/frame",
+                    "realtime x");
+    }
+
+    for (const Instrument &instrument: INSTRUMENTS) {
+        for (int polyphony: POLYPHONY_LEVELS) {
+            for (int blockFrames: BLOCK_SIZES) {
+                Result result;
+                if (!run(instrument, polyphony, blockFrames, seconds, result)) return 1;
+                if (csv) {
+                    std::printf("%s,%d,%d,%s,%.2f,%.2f,%.1f\n", instrument.name, polyphony, blockFrames, kernelsName,
+                                result.nsPerFrame, result.nsPerVoiceFrame, result.realtimeFactor);
+                } else {
+                    std::printf("%-10s %5d %6d %14.2f %16.2f %12.1f\n", instrument.name, polyphony, blockFrames,
+                                result.nsPerFrame, result.nsPerVoiceFrame, result.realtimeFactor);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -8,9 +8,11 @@
 #include "Controller/PianoAppController.h"
 #include "Controller/XylophoneAppController.h"
 #include "Controller/VideoGameAppController.h"
+#include "Controller/NoteInputMap.h"
 #include "Utils/DropdownMenu.h"
 #include "Audio/SDLAudioEngine.h"
 #include "audio/SongPlayer.h"
+#include "Audio/SongSessionManager.h"
 
 // Structure pour mapper les touches du clavier aux notes musicales
 struct KeyboardMapping {
@@ -22,7 +24,8 @@ struct KeyboardMapping {
 enum class InstrumentType {
     PIANO,
     XYLOPHONE,
-    VIDEO_GAME
+    VIDEO_GAME,
+    GUITAR      // Joué avec le clavier du piano
 };
 
 class Application {
@@ -32,7 +35,8 @@ private:
     Controller *mainController;
     MusicApp::Audio::AudioEngine *audioEngine;
     MusicApp::Audio::SDLAudioEngine *sdlAudioEngine;
-    MusicApp::Audio::SongPlayer *songPlayer;
+    MusicApp::Audio::SongSessionManager *songSessions; // Owns every SongPlayer, including songPlayer
+    MusicApp::Audio::SongPlayer *songPlayer;          // Session of the imported song (owned by songSessions)
     int windowWidth;
     int windowHeight;
     bool initialized;
@@ -43,24 +47,48 @@ private:
 
     // Mapping des touches du clavier
     std::vector<KeyboardMapping> keyboardMappings;
-    std::unordered_map<SDL_Keycode, bool> keyboardNotesState; // true = pressed, false = released
+    // Touches enfoncées et la note jouée à l'appui : le relâchement arrête exactement celle-ci,
+    // même si l'instrument ou la disposition ont changé entre-temps
+    std::unordered_map<SDL_Keycode, NoteTrigger> heldKeyNotes;
 
     // Méthodes pour le contrôle clavier
     void initializeKeyboardMappings();
 
-    void handleKeyPress(SDL_Keycode key);
+    // timestampNs : horodatage SDL de l'événement, pour la mesure de latence entrée -> premier échantillon
+    void handleKeyPress(SDL_Keycode key, Uint64 timestampNs = 0);
 
     void handleKeyRelease(SDL_Keycode key);
 
-    std::string getNoteForKey(SDL_Keycode key);
-
     float getVelocityForKey(); // Pourrait être paramétré plus tard
 
+    // Lance la chanson chargée (partition texte ou compilée) avec l'instrument donné
+    void playLoadedSong(const std::string &instrumentName);
+
+    // Flèches, Début, F5-F7 pendant la lecture d'une chanson ; false si la touche n'est pas un raccourci de transport
+    bool handleTransportKey(SDL_Keycode key);
+
+    double loopStartMarkSeconds; // Point A posé par F5 (négatif tant qu'aucun)
+
+    // Chemin direct entrée -> note-on : zones des notes et touches du clavier de l'instrument affiché,
+    // reconstruites quand le contrôleur change ou que sa disposition change
+    NoteInputMap noteInputMap;
+    bool noteInputMapValid;
+    Uint32 noteInputLayoutVersion;
+
+    void refreshNoteInputMap();
+
+    // Joue la note sous le pointeur dès l'événement de clic ; false si aucune note n'est à cet endroit
+    bool pressNoteAt(float x, float y, Uint64 timestampNs);
+
+    void releaseMouseNote();
+
     // Pour suivre la note actuellement jouée via la souris
-    std::string currentPlayingNote;
+    NoteTrigger mouseNote;
     bool isMouseButtonDown;
     Uint32 lastNotePlayTime;
 
+    bool vsyncEnabled; // SDL_RenderPresent attend la synchronisation verticale
+
 public:
     Application(int width = 1440, int height = 1024);
 
@@ -73,4 +101,7 @@ public:
     void cleanup();
 
     void setInstrument(InstrumentType instrument);
+
+    // Diapason et tempérament du moteur audio (à appeler après initialize())
+    void setTuning(const MusicApp::Audio::TuningTable &tuning);
 };
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef MUSICAPP_AUDIO_AUDIOMETRICS_H
+#define MUSICAPP_AUDIO_AUDIOMETRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+        // Copie cohérente (à quelques callbacks près) des mesures du thread audio, lue côté interface.
+        // Les durées sont en microsecondes ; la charge est le rapport durée de rendu / budget.
+        struct AudioMetricsSnapshot {
+            Uint64 callbackCount = 0;
+            Uint64 xrunCount = 0;       // Callbacks qui ont dépassé leur budget
+            double lastRenderUs = 0.0;
+            double averageRenderUs = 0.0;
+            double p99RenderUs = 0.0;   // Précision d'une case d'histogramme (HISTOGRAM_BUCKET_US)
+            double maxRenderUs = 0.0;
+            double lastBudgetUs = 0.0;  // Trames demandées / fréquence d'échantillonnage
+            double averageLoad = 0.0;   // Somme des rendus / somme des budgets
+            Uint32 activeVoices = 0;
+            Uint32 peakVoices = 0;
+
+            // Latence entrée → premier échantillon des note-on jouées au clavier ou à la souris : de l'horodatage
+            // de l'événement SDL au début du callback qui rend leur premier échantillon. La sortie ajoute encore
+            // outputBufferUs (tampon du périphérique) avant que le son soit audible.
+            Uint64 inputNoteCount = 0;
+            double lastInputLatencyUs = 0.0;
+            double averageInputLatencyUs = 0.0;
+            double maxInputLatencyUs = 0.0;
+            double outputBufferUs = 0.0;
+        };
+
+/**
+ * @brief Compteurs sans verrou remplis par le callback audio : durée de rendu, budget, dépassements, voix.
+ *
+ * recordCallback() n'est appelé que par le thread audio et n'utilise que des atomiques relâchés ;
+ * snapshot() et reset() peuvent être appelés depuis n'importe quel autre thread, sans jamais
+ * bloquer le callback.
+ */
+        class AudioMetrics {
+        public:
+            static constexpr std::size_t HISTOGRAM_BUCKETS = 256;
+            static constexpr Uint32 HISTOGRAM_BUCKET_US = 50; // La dernière case regroupe tout ce qui dépasse 12,75 ms
+
+            AudioMetrics();
+
+            /**
+             * @brief Enregistre un callback (thread audio uniquement).
+             * @param renderNs Durée passée à rendre le bloc.
+             * @param budgetNs Durée audio produite par ce callback.
+             * @param activeVoices Voix actives à la fin du callback.
+             */
+            void recordCallback(Uint64 renderNs, Uint64 budgetNs, Uint32 activeVoices);
+
+            /**
+             * @brief Enregistre la latence d'une note-on en direct (thread audio uniquement).
+             * @param latencyNs Durée entre l'événement d'entrée et le début du callback qui rend la note.
+             */
+            void recordInputLatency(Uint64 latencyNs);
+
+            // Durée du tampon du périphérique, fixée à l'ouverture du flux (n'importe quel thread)
+            void setOutputBufferNs(Uint64 bufferNs) { outputBufferNs_.store(bufferNs, std::memory_order_relaxed); }
+
+            AudioMetricsSnapshot snapshot() const;
+
+            // Remet les compteurs à zéro. Un callback concurrent peut survivre en partie à la remise à zéro.
+            void reset();
+
+        private:
+            std::atomic<Uint64> callbackCount_;
+            std::atomic<Uint64> xrunCount_;
+            std::atomic<Uint64> totalRenderNs_;
+            std::atomic<Uint64> totalBudgetNs_;
+            std::atomic<Uint64> lastRenderNs_;
+            std::atomic<Uint64> lastBudgetNs_;
+            std::atomic<Uint64> maxRenderNs_;
+            std::atomic<Uint32> activeVoices_;
+            std::atomic<Uint32> peakVoices_;
+            std::atomic<Uint64> inputNoteCount_;
+            std::atomic<Uint64> totalInputLatencyNs_;
+            std::atomic<Uint64> lastInputLatencyNs_;
+            std::atomic<Uint64> maxInputLatencyNs_;
+            std::atomic<Uint64> outputBufferNs_;        // Pas remis à zéro par reset()
+            std::array<std::atomic<Uint32>, HISTOGRAM_BUCKETS> histogram_; // Durées de rendu par cases de 50 µs
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_AUDIOMETRICS_H
@@ -0,0 +1,92 @@
+#ifndef MUSICAPP_AUDIO_COMPILEDSCORE_H
+#define MUSICAPP_AUDIO_COMPILEDSCORE_H
+
+#include "MusicFileReader.h" // For MusicalEvent
+#include "../utils/file_utils.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+        // Un événement de partition compilée : enregistrement de taille fixe, lu tel quel depuis le fichier projeté.
+        // Les positions sont en trames à CompiledScore::Header::sampleRate (Synthesizer::SAMPLE_RATE).
+        struct ScoreEventRecord {
+            Uint32 onsetFrame;     // Début de la note depuis le début du morceau
+            Uint32 durationFrames;
+            Uint8 midiNumber;      // 0..127 (C4 = 60)
+            Uint8 velocity;        // 1..127
+            Uint8 channel;         // Piste / canal d'origine (0 pour le format texte)
+            Uint8 reserved;        // Toujours 0
+        };
+
+        static_assert(sizeof(ScoreEventRecord) == 12, "ScoreEventRecord is a 12-byte on-disk record");
+
+/**
+ * @brief Partition binaire (.mlsc) projetée en mémoire et jouable sans analyse.
+ *
+ * Disposition (petit-boutiste) : un en-tête de 24 octets, puis eventCount enregistrements
+ * ScoreEventRecord triés par onsetFrame. open() ne vérifie que l'en-tête et la taille du
+ * fichier ; les événements sont lus directement dans la projection.
+ */
+        class CompiledScore {
+        public:
+            static constexpr const char *FILE_EXTENSION = ".mlsc";
+            static constexpr Uint16 VERSION = 1;
+
+            struct Header {
+                char magic[4];         // "MLSC"
+                Uint16 version;
+                Uint16 recordSize;     // sizeof(ScoreEventRecord)
+                Uint32 sampleRate;
+                Uint32 eventCount;
+                Uint64 lengthFrames;   // Durée totale, silences de fin compris
+            };
+
+            static_assert(sizeof(Header) == 24, "CompiledScore::Header is a 24-byte on-disk header");
+
+            CompiledScore() = default;
+
+            /**
+             * @brief Projette une partition compilée.
+             * @return false (avec un message sur std::cerr) si le fichier est absent, tronqué ou d'un autre format.
+             */
+            bool open(const std::string &filePath);
+
+            void close();
+
+            bool isOpen() const { return header_ != nullptr; }
+
+            const ScoreEventRecord *events() const { return events_; }
+
+            std::size_t eventCount() const { return header_ ? header_->eventCount : 0; }
+
+            Uint64 lengthFrames() const { return header_ ? header_->lengthFrames : 0; }
+
+            /**
+             * @brief Place les événements texte bout à bout sur l'axe des trames (les silences ne font qu'avancer).
+             * Les notes inconnues sont ignorées avec un avertissement.
+             * @param lengthFrames Reçoit la durée totale du morceau.
+             */
+            static std::vector<ScoreEventRecord> fromMusicalEvents(const std::vector<MusicalEvent> &events,
+                                                                   Uint64 &lengthFrames);
+
+            // Écrit une partition compilée (les événements sont triés par onsetFrame avant l'écriture)
+            static bool write(const std::string &filePath, std::vector<ScoreEventRecord> events, Uint64 lengthFrames);
+
+            // Convertit une partition texte ("C4 0.5" par ligne) en partition compilée ; les lignes fautives sont
+            // signalées sur std::cerr et ignorées
+            static bool convertTextScore(const std::string &textPath, const std::string &binaryPath);
+
+        private:
+            MappedFile file_;
+            const Header *header_ = nullptr;
+            const ScoreEventRecord *events_ = nullptr;
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_COMPILEDSCORE_H
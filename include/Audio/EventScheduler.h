@@ -0,0 +1,69 @@
+#ifndef MUSICAPP_AUDIO_EVENTSCHEDULER_H
+#define MUSICAPP_AUDIO_EVENTSCHEDULER_H
+
+#include "Synthesizer.h" // For AudioCommand
+#include <cstddef>
+#include <vector>
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+/**
+ * @brief File de priorité à capacité fixe des commandes datées en trames.
+ *
+ * Tas binaire préalloué : push() et pop() n'allouent jamais, ce qui permet de l'utiliser
+ * depuis le callback audio. Les commandes de même trame ressortent dans leur ordre
+ * d'arrivée (un note-off suivi d'un note-on sur la même trame reste dans cet ordre).
+ */
+        class EventScheduler {
+        public:
+            static constexpr std::size_t DEFAULT_CAPACITY = 512;
+            static constexpr Uint64 NO_EVENT = ~static_cast<Uint64>(0);
+
+            explicit EventScheduler(std::size_t capacity = DEFAULT_CAPACITY);
+
+            /**
+             * @brief Ajoute une commande datée par command.frame.
+             * @return false si la file est pleine.
+             */
+            bool push(const AudioCommand &command);
+
+            /**
+             * @brief Retire la prochaine commande si elle est due à la trame donnée (frame <= position).
+             */
+            bool popDue(Uint64 position, AudioCommand &command);
+
+            // Trame de la prochaine commande, NO_EVENT si la file est vide
+            Uint64 nextFrame() const { return heap_.empty() ? NO_EVENT : heap_.front().command.frame; }
+
+            void clear() { heap_.clear(); }
+
+            // Retire les commandes d'une session sans toucher aux autres (ni allocation, ni changement d'ordre)
+            void clearSession(SessionId sessionId);
+
+            bool empty() const { return heap_.empty(); }
+
+            std::size_t size() const { return heap_.size(); }
+
+        private:
+            struct Entry {
+                AudioCommand command;
+                Uint64 sequence; // Ordre d'arrivée, départage les commandes de même trame
+            };
+
+            // Ordre de tas « le plus tôt en tête » pour std::push_heap / std::pop_heap
+            static bool later(const Entry &a, const Entry &b) {
+                if (a.command.frame != b.command.frame) return a.command.frame > b.command.frame;
+                return a.sequence > b.sequence;
+            }
+
+            std::vector<Entry> heap_;
+            std::size_t capacity_;
+            Uint64 sequence_;
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_EVENTSCHEDULER_H
@@ -0,0 +1,53 @@
+#ifndef MUSICAPP_AUDIO_MIDIFILEREADER_H
+#define MUSICAPP_AUDIO_MIDIFILEREADER_H
+
+#include "CompiledScore.h" // For ScoreEventRecord
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+/**
+ * @brief Lecture des fichiers MIDI standard (SMF formats 0 et 1) en événements datés en trames.
+ *
+ * Toutes les pistes sont fusionnées en une seule liste polyphonique triée par onsetFrame ; les
+ * positions en ticks passent par la carte des tempos (ou la division SMPTE) puis sont arrondies
+ * à Synthesizer::SAMPLE_RATE. Le statut courant (running status) est pris en charge. Un note-off
+ * termine le plus ancien note-on encore ouvert de la même touche ; les notes jamais fermées
+ * s'arrêtent à la fin de leur piste. Le canal 10 (percussions General MIDI) est ignoré : nos
+ * instruments sont tous accordés.
+ */
+        class MidiFileReader {
+        public:
+            static constexpr int PERCUSSION_CHANNEL = 9; // Canal 10, compté à partir de 0
+
+            struct Result {
+                std::vector<ScoreEventRecord> events; // channel = canal MIDI d'origine
+                Uint64 lengthFrames = 0;               // Jusqu'à la fin de la piste la plus longue
+                Uint16 format = 0;
+                Uint16 trackCount = 0;
+                std::size_t tempoChangeCount = 0;
+                std::size_t skippedPercussionNotes = 0;
+            };
+
+            // Vrai pour les extensions .mid et .midi (sans tenir compte de la casse)
+            static bool isMidiPath(const std::string &filePath);
+
+            /**
+             * @brief Lit un fichier .mid.
+             * @return false (avec un message sur std::cerr) si le fichier est illisible, d'un format non pris
+             * en charge (SMF 2) ou ne contient aucune note.
+             */
+            static bool read(const std::string &filePath, Result &result);
+
+            static bool parse(const unsigned char *data, std::size_t size, const std::string &sourceName,
+                              Result &result);
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_MIDIFILEREADER_H
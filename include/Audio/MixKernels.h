@@ -0,0 +1,61 @@
+#ifndef MUSICAPP_AUDIO_MIXKERNELS_H
+#define MUSICAPP_AUDIO_MIXKERNELS_H
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+/**
+ * @brief Noyaux de rendu par bloc utilisés par les générateurs de voix.
+ *
+ * Chaque noyau existe en version scalaire, SSE2 et AVX2 ; la meilleure version prise en
+ * charge par le processeur est choisie une seule fois à l'exécution (SDL_HasAVX2, SDL_HasSSE2).
+ * Les tampons n'ont pas besoin d'être alignés.
+ */
+        namespace MixKernels {
+            enum class InstructionSet {
+                Scalar,
+                SSE2,
+                AVX2
+            };
+
+            // Oscillateur à table d'onde (voir Wavetable) lu sur un bloc ; phase et level sont avancés par le noyau
+            struct WavetableBlock {
+                const float *mip;      // Wavetable::mipFor
+                int layers;            // Couches entrelacées de la table, de 1 à 4
+                const float *weights;  // Un poids par couche
+                Uint32 phase;
+                Uint32 increment;      // Wavetable::phaseIncrement
+                float level;           // Gain de l'échantillon courant, multiplié par levelDecay à chaque échantillon
+                float levelDecay;
+            };
+
+            // Au-dessous de ce niveau d'enveloppe, l'échantillon est considéré comme silencieux
+            static constexpr float ENVELOPE_GATE = 0.0001f;
+
+            // Choisit les versions des noyaux ; à appeler hors du thread audio (sans effet les fois suivantes)
+            void prepare();
+
+            InstructionSet activeInstructionSet();
+
+            const char *instructionSetName(InstructionSet instructionSet);
+
+            // Force une version (bancs d'essai, comparaisons) ; retombe sur le scalaire si le CPU ne la gère pas
+            void forceInstructionSet(InstructionSet instructionSet);
+
+            // voice[i] = envelope[i] > ENVELOPE_GATE ? voice[i] * envelope[i] * gain : 0
+            void applyEnvelope(float *voice, const float *envelope, float gain, int frames);
+
+            // out[i] = level * somme des weights[l] * couche l (interpolée à la phase de l'échantillon i) ;
+            // ajouté à out au lieu de le remplacer si accumulate
+            void renderWavetable(WavetableBlock &block, float *out, int frames, bool accumulate);
+
+            // bus entrelacé stéréo : bus[2i] += mono[i] * leftGain, bus[2i + 1] += mono[i] * rightGain
+            void accumulateStereo(float *bus, const float *mono, float leftGain, float rightGain, int frames);
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_MIXKERNELS_H
@@ -0,0 +1,99 @@
+#ifndef MUSICAPP_AUDIO_OFFLINERENDERER_H
+#define MUSICAPP_AUDIO_OFFLINERENDERER_H
+
+#include "Synthesizer.h"
+#include "MusicFileReader.h" // For MusicalEvent
+#include "Tuning.h"
+#include "CompiledScore.h"
+#include "../model/Score.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MusicApp {
+    namespace Audio {
+
+/**
+ * @brief Rendu hors ligne d'une partition vers un fichier WAV ou PCM brut.
+ *
+ * Utilise le même Synthesizer que le moteur temps réel, mais sans périphérique audio :
+ * les événements sont placés à la trame près et le rendu avance aussi vite que le
+ * processeur le permet. Chaque appel part d'un état de voix vierge.
+ */
+        class OfflineRenderer {
+        public:
+            enum class FileFormat {
+                Wav,   // RIFF/WAVE PCM 16 bits stéréo
+                RawPcm // Échantillons 16 bits little-endian entrelacés, sans en-tête
+            };
+
+            static constexpr int CHANNELS = 2;
+
+            explicit OfflineRenderer(std::size_t polyphony = VoicePool::DEFAULT_POLYPHONY);
+
+            /**
+             * @brief Rend la partition en PCM 16 bits stéréo entrelacé à Synthesizer::SAMPLE_RATE.
+             * @return Un tampon vide si aucun événement n'est jouable.
+             */
+            std::vector<int16_t> render(const std::vector<MusicalEvent> &events, const std::string &instrumentName);
+
+            // Même rendu à partir d'enregistrements datés en trames (partition compilée, triée par onsetFrame)
+            std::vector<int16_t> render(const ScoreEventRecord *events, std::size_t eventCount, Uint64 lengthFrames,
+                                        const std::string &instrumentName);
+
+            // Partition polyphonique triée : chaque note est rendue avec son propre instrument
+            std::vector<int16_t> render(const Model::Score &score);
+
+            /**
+             * @brief Rend la partition et l'écrit dans filePath.
+             * @return false si le rendu est vide ou si le fichier ne peut pas être écrit.
+             */
+            bool renderToFile(const std::vector<MusicalEvent> &events, const std::string &instrumentName,
+                              const std::string &filePath, FileFormat format = FileFormat::Wav);
+
+            bool renderToFile(const CompiledScore &score, const std::string &instrumentName,
+                              const std::string &filePath, FileFormat format = FileFormat::Wav);
+
+            bool renderToFile(const ScoreEventRecord *events, std::size_t eventCount, Uint64 lengthFrames,
+                              const std::string &instrumentName, const std::string &filePath,
+                              FileFormat format = FileFormat::Wav);
+
+            bool renderToFile(const Model::Score &score, const std::string &filePath,
+                              FileFormat format = FileFormat::Wav);
+
+            // Durée maximale laissée aux relâchements après la dernière note (1 s par défaut)
+            void setTailSeconds(float seconds) { tailSeconds_ = seconds < 0.0f ? 0.0f : seconds; }
+
+            // Taille des blocs de rendu ; les blocs sont aussi coupés à chaque événement
+            void setBlockFrames(int frames) { blockFrames_ = frames < 1 ? 1 : frames; }
+
+            void setDitherEnabled(bool enabled) { ditherEnabled_ = enabled; }
+
+            // Table d'accord des notes rendues (tempérament égal à 440 Hz par défaut)
+            void setTuning(const TuningTable &tuning) { tuning_ = tuning; }
+
+            static bool writeWavFile(const std::string &filePath, const std::vector<int16_t> &samples);
+
+            static bool writeRawPcmFile(const std::string &filePath, const std::vector<int16_t> &samples);
+
+        private:
+            bool writeRendered(const std::vector<int16_t> &samples, const std::string &filePath, FileFormat format,
+                               Uint64 startTicks);
+
+            struct ScheduledCommand {
+                Uint64 frame;
+                AudioCommand command;
+            };
+
+            std::size_t polyphony_;
+            float tailSeconds_;
+            int blockFrames_;
+            bool ditherEnabled_;
+            TuningTable tuning_;
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_OFFLINERENDERER_H
@@ -0,0 +1,50 @@
+#ifndef MUSICAPP_AUDIO_OUTPUTSTAGE_H
+#define MUSICAPP_AUDIO_OUTPUTSTAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+/**
+ * @brief Étage de sortie unique du bus de mixage float32.
+ *
+ * Les voix sont accumulées sans écrêtage dans le bus ; cet étage applique une seule fois par
+ * échantillon un écrêtage doux (linéaire jusqu'au genou, puis saturation progressive vers ±1),
+ * puis, si la sortie est en 16 bits, un dither TPDF optionnel avant quantification.
+ */
+        class OutputStage {
+        public:
+            // Au-dessous de ce niveau le signal passe sans modification
+            static constexpr float SOFT_CLIP_KNEE = 0.7f;
+
+            OutputStage();
+
+            /**
+             * @brief Écrêtage doux en place de numSamples échantillons.
+             */
+            void softClip(float *samples, std::size_t numSamples) const;
+
+            /**
+             * @brief Convertit le bus (déjà limité) en 16 bits, avec dither TPDF si activé.
+             */
+            void convertToS16(const float *samples, int16_t *output, std::size_t numSamples);
+
+            void setDitherEnabled(bool enabled) { ditherEnabled_ = enabled; }
+
+            bool isDitherEnabled() const { return ditherEnabled_; }
+
+        private:
+            // Générateur xorshift32 : pas d'état global ni de verrou, contrairement à std::rand
+            float nextUniform();
+
+            bool ditherEnabled_;
+            Uint32 rngState_;
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_OUTPUTSTAGE_H
@@ -0,0 +1,44 @@
+#ifndef MUSICAPP_AUDIO_REALTIMEALLOCATIONTRACKER_H
+#define MUSICAPP_AUDIO_REALTIMEALLOCATIONTRACKER_H
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+/**
+ * @brief Mode de diagnostic qui compte les allocations sur le tas faites par le thread audio.
+ *
+ * Actif uniquement si le projet est compilé avec MUSICALAU_AUDIO_ALLOC_CHECK (option CMake du
+ * même nom) : les opérateurs new/delete globaux sont alors remplacés et chaque allocation faite
+ * pendant un Scope est comptée (et déclenche un SDL_assert). Sans l'option, tout est sans effet.
+ */
+        namespace RealtimeAllocationTracker {
+
+            /**
+             * @brief Marque le thread courant comme temps réel pour la durée de vie de l'objet.
+             */
+            class Scope {
+            public:
+                Scope();
+
+                ~Scope();
+
+                Scope(const Scope &) = delete;
+
+                Scope &operator=(const Scope &) = delete;
+
+            private:
+                bool previous_;
+            };
+
+            bool isEnabled();
+
+            Uint64 allocationCount();
+
+        } // namespace RealtimeAllocationTracker
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_REALTIMEALLOCATIONTRACKER_H
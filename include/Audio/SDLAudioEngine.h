@@ -2,11 +2,19 @@
 #define MUSICAPP_AUDIO_SDLAUDIOENGINE_H
 
 #include "AudioEngine.h"
+#include "SpscQueue.h"
+#include "Synthesizer.h"
+#include "EventScheduler.h"
+#include "RealtimeAllocationTracker.h"
+#include "AudioMetrics.h"
+#include "Tuning.h"
 #include "../Core/Note.h"
 #include <string>
 #include <vector>
-#include <map>
-#include <unordered_map>
+#include <array>
+#include <bitset>
+#include <atomic>
+#include <memory>
 #include <cmath>
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_mutex.h> // For SDL_Mutex
@@ -14,38 +22,10 @@
 namespace MusicApp {
     namespace Audio {
 
-        struct ActiveNote {
-            std::string instrumentName;
-            std::string pitchName;
-            float frequency;
-            bool isPlaying;          // True if note is in Attack, Decay, or Sustain phase
-            Uint32 systemStartTimeMs; // SDL_GetTicks() when playSound was called
-            float velocity;          // Between 0.0 and 1.0, representing the strength of the note
-
-            float currentTimeInSamples; // Current sample position in the note's lifecycle (for ADSR or release phase)
-            bool needsRelease;       // Flag to indicate if release envelope should be played
-            float currentEnvelopeValue; // To allow smooth transition to release from any point
-
-            // Variables pour éviter les bruits parasites
-            float phase;             // Phase continue pour la génération d'onde sonore
-            float prevSampleLeft;    // Échantillon gauche précédent pour le crossfading
-            float prevSampleRight;   // Échantillon droit précédent pour le crossfading
-
-            // ADSR parameters (durations in samples at a fixed sample rate)
-            // These assume SAMPLE_RATE is 44100. Define them with that assumption.
-            static constexpr float ATTACK_DURATION_SAMPLES = 44100 * 0.01f; // 10ms
-            static constexpr float DECAY_DURATION_SAMPLES = 44100 * 0.1f;   // 100ms
-            static constexpr float SUSTAIN_LEVEL = 0.7f;
-            static constexpr float RELEASE_DURATION_SAMPLES = 44100 * 0.2f; // 200ms
-
-            ActiveNote() : frequency(0.0f), isPlaying(false), systemStartTimeMs(0), velocity(1.0f),
-                           currentTimeInSamples(0.0f), needsRelease(false), currentEnvelopeValue(0.0f),
-                           phase(0.0f), prevSampleLeft(0.0f), prevSampleRight(0.0f) {}
-        };
-
         class SDLAudioEngine : public AudioEngine {
         public:
-            SDLAudioEngine();
+            // polyphony: nombre de voix préallouées (64 ou 128 conseillé)
+            explicit SDLAudioEngine(std::size_t polyphony = VoicePool::DEFAULT_POLYPHONY);
 
             ~SDLAudioEngine() override;
 
@@ -59,34 +39,132 @@ namespace MusicApp {
 
             void stopSound(const std::string &instrumentName, const Core::Note &note);
 
+            // Live note-on by instrument ID and MIDI note number, for input handlers that resolved the note
+            // beforehand (see NoteInputMap): no name lookup, no logging. inputTimestampNs is the SDL event
+            // timestamp (SDL_GetTicksNS() clock); when non-zero, the input-to-first-sample latency is recorded
+            // in getMetrics(). Returns false if the note is already held or could not be queued.
+            bool noteOn(InstrumentId instrumentId, int midiNumber, float velocity, Uint64 inputTimestampNs = 0);
+
+            void noteOff(InstrumentId instrumentId, int midiNumber);
+
+            // Changes the velocity of a held note without retriggering it.
+            void setNoteVelocity(const std::string &instrumentName, const Core::Note &note, float velocity);
+
+            // True while the note is held (note-on sent, no note-off yet). Answered from the
+            // control-side bookkeeping so it never waits on the audio thread.
             bool isNotePlaying(const std::string &instrumentName, const Core::Note &note);
 
             void cleanupLongPlayingNotes(Uint32 maxDurationMs = 5000);
 
+            // Frames rendered so far by the audio callback: the clock used for scheduling
+            Uint64 getFramePosition() const { return framePosition_.load(std::memory_order_acquire); }
+
+            static constexpr unsigned int getSampleRate() { return Synthesizer::SAMPLE_RATE; }
+
+            // Sample-accurate note-on/off at an absolute stream frame (see getFramePosition()). Scheduled
+            // notes bypass the held-note bookkeeping; a frame already rendered fires at the next block.
+            bool scheduleNoteOn(const std::string &instrumentName, const Core::Note &note, float velocity,
+                                Uint64 frame);
+
+            bool scheduleNoteOff(const std::string &instrumentName, const Core::Note &note, Uint64 frame);
+
+            // Same, by instrument ID and MIDI note number: what SongPlayer uses for pre-parsed scores. A note-off
+            // only releases the voice started by the same session.
+            bool scheduleNoteOn(InstrumentId instrumentId, int midiNumber, float velocity, Uint64 frame,
+                                SessionId sessionId = LIVE_SESSION);
+
+            bool scheduleNoteOff(InstrumentId instrumentId, int midiNumber, Uint64 frame,
+                                 SessionId sessionId = LIVE_SESSION);
+
+            // Drops every command of the session that has not fired yet (already sounding notes keep playing);
+            // the other sessions are not affected
+            void cancelScheduledEvents(SessionId sessionId = LIVE_SESSION);
+
+            // Reserves a playback session (one per concurrent SongPlayer); LIVE_SESSION if all are taken
+            SessionId acquireSession();
+
+            // Cancels the session's pending commands and frees it; its sounding notes finish their release
+            void releaseSession(SessionId sessionId);
+
+            // Mix gain of every voice of the session, applied from the next audio block (0 mutes it)
+            void setSessionGain(SessionId sessionId, float gain);
+
+            // Remplace la table d'accord (diapason, tempérament) utilisée par les note-on suivantes. L'échange est
+            // atomique : les notes qui sonnent déjà gardent leur fréquence.
+            void setTuning(const TuningTable &table);
+
+            std::shared_ptr<const TuningTable> getTuning() const { return std::atomic_load(&tuning_); }
+
+            // TPDF dither before 16-bit quantisation (only used when the device is not float)
+            void setDitherEnabled(bool enabled) { synthesizer_.getOutputStage().setDitherEnabled(enabled); }
+
+            // Number of heap allocations seen on the audio thread (always 0 unless built with
+            // MUSICALAU_AUDIO_ALLOC_CHECK).
+            Uint64 getRealtimeAllocationCount() const;
+
+            // Durée de rendu des callbacks (moyenne, p99, max) rapportée au budget, dépassements et voix actives.
+            // Lu sans verrou : peut être appelé à chaque image depuis le thread de l'interface.
+            AudioMetricsSnapshot getMetrics() const { return metrics_.snapshot(); }
+
+            void resetMetrics() { metrics_.reset(); }
+
         private:
             // Static audio callback function
             static void audioCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount);
 
-            // Generates a chunk of waveform data for a single note
-            void generateAudioChunk(ActiveNote &note, std::vector<int16_t> &buffer, int numStereoSampleFrames);
+            // Renders one block through the synthesizer and, in S16 mode, quantises it into outputBuffer_
+            // (numStereoSampleFrames <= synthesizer_.getMaxBlockFrames()). Returns the data to hand to SDL.
+            const void *renderBlock(int numStereoSampleFrames);
 
-            // Generates xylophone sound specifically (brighter, shorter decay)
-            void generateXylophoneAudioChunk(ActiveNote &note, std::vector<int16_t> &buffer, int numStereoSampleFrames);
+            static std::size_t heldNoteIndex(InstrumentId instrumentId, Uint8 pitchId) {
+                return static_cast<std::size_t>(instrumentId) * PITCH_COUNT + pitchId;
+            }
 
-            // Generates 8-bit chiptune sound for video game console
-            void generate8BitAudioChunk(ActiveNote &note, std::vector<int16_t> &buffer, int numStereoSampleFrames);
+            // Sends a note-off for a held note. Caller must hold commandMutex_.
+            void releaseHeldNote(InstrumentId instrumentId, Uint8 pitchId);
 
-            float getFrequencyForNote(const std::string &pitchName) const;
+            // Pushes a command to the audio thread. Caller must hold commandMutex_.
+            bool enqueueCommand(const AudioCommand &command);
+
+            // Applies every pending immediate command to the voice pool and moves timed ones to
+            // scheduledCommands_, recording the input latency of live note-ons. Audio thread only.
+            void drainCommands(Uint64 callbackStartNs);
+
+            // Applies the scheduled commands due at framePosition_. Audio thread only.
+            void applyDueCommands();
 
             bool isInitialized_;
             SDL_AudioStream *audioStream_;      // Audio stream for the callback
             SDL_AudioDeviceID audioDevice_;     // Audio device ID
 
-            std::unordered_map<std::string, ActiveNote> activeNotes_; // Protected by activeNotesMutex_
-            SDL_Mutex *activeNotesMutex_;       // Mutex for thread-safe access to activeNotes
+            // Synthesis core (voices, generators, float bus). Owned by the audio thread once init() succeeded.
+            Synthesizer synthesizer_;
+            std::vector<int16_t> outputBuffer_; // Only used when the device is not float, sized in init()
+            SDL_AudioFormat outputFormat_;      // SDL_AUDIO_F32 when the device accepts it, SDL_AUDIO_S16 otherwise
+
+            // Note-on/off/velocity events, UI and SongPlayer -> audio callback. The callback is the only
+            // consumer and never locks; commandMutex_ only serialises the producers between themselves.
+            static constexpr std::size_t COMMAND_QUEUE_CAPACITY = 1024;
+            SpscQueue<AudioCommand, COMMAND_QUEUE_CAPACITY> commandQueue_;
+            SDL_Mutex *commandMutex_;
+
+            // Timed commands waiting for their frame, ordered by frame, all sessions together. Audio thread only.
+            static constexpr std::size_t SCHEDULER_CAPACITY = EventScheduler::DEFAULT_CAPACITY * 4;
+            EventScheduler scheduledCommands_;
+            std::atomic<Uint64> framePosition_; // Written by the audio thread only
+
+            // Table d'accord courante, lue et remplacée avec std::atomic_load/std::atomic_store (côté contrôle)
+            std::shared_ptr<const TuningTable> tuning_;
+
+            AudioMetrics metrics_;              // Written by the audio thread only
+            Uint64 performanceFrequency_;       // SDL_GetPerformanceFrequency(), cached for the callback
+
+            // Sessions handed out by acquireSession(), protected by commandMutex_ (LIVE_SESSION is always taken)
+            std::bitset<MAX_SESSIONS> sessionsInUse_;
 
-            static const std::map<std::string, float> noteFrequencies_;
-            static const unsigned int SAMPLE_RATE = 44100; // Make sample rate a known constant for ADSR calculations
+            // Control-side view of the held notes, indexed by heldNoteIndex(), protected by commandMutex_
+            std::bitset<INSTRUMENT_COUNT * PITCH_COUNT> heldNotes_;
+            std::array<Uint32, INSTRUMENT_COUNT * PITCH_COUNT> heldNoteStartMs_{}; // SDL_GetTicks() at note-on
         };
 
     } // namespace Audio
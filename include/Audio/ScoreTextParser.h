@@ -0,0 +1,103 @@
+#ifndef MUSICAPP_AUDIO_SCORETEXTPARSER_H
+#define MUSICAPP_AUDIO_SCORETEXTPARSER_H
+
+#include "CompiledScore.h" // For ScoreEventRecord
+#include "../utils/file_utils.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+        // Une erreur de partition texte, positionnée dans le fichier (lignes et colonnes comptées à partir de 1)
+        struct ScoreParseError {
+            std::size_t line;
+            std::size_t column;
+            std::string message;
+        };
+
+/**
+ * @brief Analyseur de partitions texte ("C4 0.5" par ligne) travaillant directement sur le tampon du fichier.
+ *
+ * Aucune copie par ligne : les jetons sont lus en place, les durées avec std::from_chars et les
+ * hauteurs converties tout de suite en numéros MIDI. Les événements sortent datés en trames, comme
+ * CompiledScore::fromMusicalEvents. "0" et "Unknown" sont des silences ; les lignes vides et le texte
+ * qui suit la durée sont ignorés.
+ *
+ * L'analyse peut avancer par tranches (parseChunk) : SongPlayer commence à jouer dès la première
+ * tranche et lit la suite pendant la lecture. Les erreurs ne coupent pas l'analyse, elles sont
+ * collectées avec leur position (une note inconnue fait quand même avancer le temps).
+ */
+        class ScoreTextParser {
+        public:
+            static constexpr std::size_t DEFAULT_CHUNK_EVENTS = 4096;
+            static constexpr std::size_t MAX_REPORTED_ERRORS = 100; // Les suivantes ne sont que comptées
+
+            struct Result {
+                std::vector<ScoreEventRecord> events; // Triés par onsetFrame
+                Uint64 lengthFrames = 0;               // Durée totale, silences de fin compris
+                std::size_t lineCount = 0;
+                std::vector<ScoreParseError> errors;   // Au plus MAX_REPORTED_ERRORS
+                std::size_t errorCount = 0;
+                bool opened = false;
+
+                bool ok() const { return opened && errorCount == 0; }
+            };
+
+            ScoreTextParser() = default;
+
+            // Analyse un tampon appartenant à l'appelant, qui doit rester valide pendant l'analyse
+            ScoreTextParser(const char *data, std::size_t size) { reset(data, size); }
+
+            /**
+             * @brief Projette le fichier en mémoire et se place au début.
+             * @return false (avec un message sur std::cerr) si le fichier ne peut pas être ouvert.
+             */
+            bool open(const std::string &filePath);
+
+            void reset(const char *data, std::size_t size);
+
+            /**
+             * @brief Analyse la suite du texte jusqu'à produire maxEvents notes (ou jusqu'à la fin).
+             * @return Le nombre de notes ajoutées à la fin de out.
+             */
+            std::size_t parseChunk(std::vector<ScoreEventRecord> &out, std::size_t maxEvents = DEFAULT_CHUNK_EVENTS);
+
+            bool done() const { return cursor_ == end_; }
+
+            // Durée couverte par les lignes déjà analysées
+            Uint64 lengthFrames() const { return lengthFrames_; }
+
+            std::size_t lineCount() const { return line_; }
+
+            const std::vector<ScoreParseError> &errors() const { return errors_; }
+
+            std::size_t errorCount() const { return errorCount_; }
+
+            static Result parseBuffer(const char *data, std::size_t size);
+
+            static Result parseFile(const std::string &filePath);
+
+            // Affiche les erreurs sur std::cerr au format "source:ligne:colonne: message"
+            static void reportErrors(const std::string &sourceName, const std::vector<ScoreParseError> &errors,
+                                     std::size_t errorCount);
+
+        private:
+            void addError(std::size_t column, std::string message);
+
+            MappedFile file_;
+            const char *cursor_ = nullptr;
+            const char *end_ = nullptr;
+            std::size_t line_ = 0;
+            double elapsedSeconds_ = 0.0; // Cumul en secondes, arrondi à chaque note : pas de dérive
+            Uint64 lengthFrames_ = 0;
+            std::vector<ScoreParseError> errors_;
+            std::size_t errorCount_ = 0;
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_SCORETEXTPARSER_H
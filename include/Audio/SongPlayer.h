@@ -4,10 +4,15 @@
 #include <vector>
 #include <thread>
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
 #include <iostream> // For cerr/cout
-#include "SDL3/SDL_timer.h" // For SDL_Delay
 #include "MusicFileReader.h" // For MusicalEvent
 #include "SDLAudioEngine.h"  // For SDLAudioEngine and Core::Note
+#include "CompiledScore.h"
+#include "ScoreTextParser.h"
+#include "../model/Score.h"
 // Note: Ensure SDLAudioEngine.h includes or forward declares Core::Note correctly if it's in a namespace
 
 namespace MusicApp {
@@ -18,10 +23,22 @@ namespace MusicApp {
             SongPlayer(MusicApp::Audio::SDLAudioEngine* audioEngine);
             ~SongPlayer();
 
-            // Starts playing the given song events with the specified instrument.
+            // Plays a polyphonic, multi-track score; each event sounds with its own instrument.
             // Returns true if playback started, false otherwise (e.g., if already playing).
+            // startEngineFrame (see SDLAudioEngine::getFramePosition()) lines several players up on the same first
+            // frame; 0 starts START_LATENCY_MS from now.
+            bool playSong(std::shared_ptr<const Model::Score> score, Uint64 startEngineFrame = 0);
+
+            // Starts playing the given song events with the specified instrument.
             bool playSong(const std::vector<MusicalEvent>& events, const std::string& instrumentName);
 
+            // Plays the records of a memory-mapped compiled score with the specified instrument.
+            bool playSong(const std::shared_ptr<const CompiledScore>& score, const std::string& instrumentName);
+
+            // Streams a text score: playback starts after the first chunk, the rest is parsed by the playback
+            // thread ahead of the lookahead window. Parse errors are reported once the whole file has been read.
+            bool playScoreFile(const std::string& filePath, const std::string& instrumentName);
+
             // Stops the currently playing song, if any.
             void stopSong();
 
@@ -29,12 +46,111 @@ namespace MusicApp {
             bool isPlaying() const;
             bool isPaused() const;
 
+            static constexpr float MIN_PLAYBACK_RATE = 0.25f;
+            static constexpr float MAX_PLAYBACK_RATE = 4.0f;
+            static constexpr double MIN_LOOP_SECONDS = 0.05;
+
+            // Jumps to a song position (clamped to the song); notes are picked up from the next onset after it.
+            // Wakes the playback thread, so it applies at once; also works while paused.
+            void seek(double seconds);
+
+            // Song position of what is currently heard, in seconds (0 when nothing is playing)
+            double getPositionSeconds() const;
+
+            // Repeats [startSeconds, endSeconds) until cleared; false if the region is shorter than MIN_LOOP_SECONDS.
+            // Notes held across the loop end are released there, so every pass sounds the same.
+            bool setLoopRegion(double startSeconds, double endSeconds);
+            void clearLoopRegion();
+            bool hasLoopRegion() const;
+
+            // Tempo factor in [MIN_PLAYBACK_RATE, MAX_PLAYBACK_RATE]: only onsets and durations are scaled, the
+            // synthesized notes keep their pitch
+            void setPlaybackRate(float rate);
+            float getPlaybackRate() const;
+
+            // Engine session of this player's notes: stopping, seeking or looping never touches other players' notes
+            SessionId getSessionId() const { return sessionId_; }
+
         private:
+            // How far ahead of the audio clock notes are handed to the engine, and the first note's offset
+            static constexpr Uint32 LOOKAHEAD_MS = 150;
+            static constexpr Uint32 START_LATENCY_MS = 50;
+            // The playback thread sleeps until the next note enters the lookahead window, but re-reads the audio
+            // clock at least this often (the device may start late or stall)
+            static constexpr Uint32 MAX_SCHEDULER_SLEEP_MS = 50;
+            // A streamed score is parsed one chunk further as soon as fewer notes than this remain unscheduled
+            static constexpr size_t STREAM_REFILL_EVENTS = ScoreTextParser::DEFAULT_CHUNK_EVENTS / 2;
+
             void playbackLoop(); // The function that will run in the playback thread
 
+            // False (with a message) if a song is playing or there is no engine; joins a finished playback thread
+            bool readyForNewSong();
+
+            // Starts the playback thread on score_ (set by playSong)
+            bool startPlayback(const std::string& description, Uint64 startEngineFrame = 0);
+
+            // Parses the next chunk of a streamed score into streamedScore_ (playback thread only)
+            void streamNextChunk();
+
+            // Maps song frames to engine frames: anchorSongFrame is heard at anchorEngineFrame, then the song
+            // advances rate frames per engine frame
+            struct Timeline {
+                Uint64 anchorEngineFrame;
+                Uint64 anchorSongFrame;
+                double rate;
+
+                Uint64 engineFrameFor(Uint64 songFrame) const;
+                Uint64 songFrameAt(Uint64 engineFrame) const;
+            };
+
+            // Transport requests from the UI thread, applied by the playback thread (guarded by controlMutex_)
+            struct TransportControls {
+                bool seekRequested = false;
+                Uint64 seekFrame = 0;
+                Uint64 loopStartFrame = 0;
+                Uint64 loopEndFrame = 0; // No loop while loopEndFrame <= loopStartFrame
+                double rate = 1.0;
+            };
+
+            // Takes the pending requests and clears controlsChanged_
+            TransportControls readControls();
+
+            // Song position heard at engineFrame: previous until current's anchor (a loop wrap) is reached
+            static Uint64 songPositionAt(const Timeline& current, const Timeline& previous, Uint64 engineFrame);
+
+            // Makes the playback thread's timelines visible to getPositionSeconds()
+            void publishTimeline(const Timeline& current, const Timeline& previous);
+
+            // Cancels pending engine events and releases every song note still sounding at the given song position
+            void silenceSongNotes(Uint64 songPosition, size_t scheduledCount);
+
+            // Cancels pending engine events and re-times the note-offs of the notes still sounding at songPosition;
+            // returns the index of the first note to schedule again
+            size_t rescheduleFrom(const Timeline& timeline, Uint64 songPosition, size_t scheduledCount,
+                                  Uint64 loopEndFrame);
+
             MusicApp::Audio::SDLAudioEngine* audioEngine_; // Non-owning pointer
-            std::vector<MusicalEvent> currentSongEvents_;
-            std::string currentInstrumentName_;
+            SessionId sessionId_;
+            Uint64 startEngineFrame_;
+            std::string currentSongDescription_;
+
+            // The song being played, sorted by onset. While a text score is streamed, streamedScore_ is the same
+            // object, grown chunk by chunk by the playback thread from streamingParser_.
+            std::shared_ptr<const Model::Score> score_;
+            std::shared_ptr<Model::Score> streamedScore_;
+            std::unique_ptr<ScoreTextParser> streamingParser_;
+            std::string streamingPath_;
+            std::vector<ScoreEventRecord> streamChunk_;
+
+            // Guards controls_, the published timelines and the stop/pause flags' transitions; controlChanged_ is
+            // notified on every request so the playback thread never polls
+            mutable std::mutex controlMutex_;
+            std::condition_variable controlChanged_;
+            TransportControls controls_;
+            bool controlsChanged_;
+            // A rate of 0 freezes the position (paused, or before the thread starts)
+            Timeline heardTimeline_;
+            Timeline previousTimeline_;
 
             std::thread playbackThread_;
             std::atomic<bool> stopPlaybackSignal_;
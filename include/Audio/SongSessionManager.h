@@ -0,0 +1,96 @@
+#ifndef MUSICAPP_AUDIO_SONGSESSIONMANAGER_H
+#define MUSICAPP_AUDIO_SONGSESSIONMANAGER_H
+
+#include "SongPlayer.h"
+#include "SDLAudioEngine.h"
+#include "../model/Score.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MusicApp {
+    namespace Audio {
+
+/**
+ * @brief Plusieurs SongPlayer simultanés, mixés dans le même SDLAudioEngine.
+ *
+ * Chaque session a son propre transport (lecture, pause, saut, boucle, tempo) et sa session moteur :
+ * arrêter ou déplacer l'une ne coupe ni les notes des autres ni le jeu en direct (accompagnement au
+ * piano pendant que l'utilisateur joue du xylophone, par exemple). Le gain effectif d'une session
+ * combine son gain, sa sourdine et les solos : dès qu'une session est en solo, seules les sessions
+ * en solo s'entendent. À utiliser depuis le thread de l'interface uniquement.
+ */
+        class SongSessionManager {
+        public:
+            static constexpr float MAX_GAIN = 2.0f;
+            // Délai laissé avant la première note de playTracks(), le temps de lancer tous les threads de lecture
+            static constexpr Uint32 SYNC_START_MS = 100;
+
+            explicit SongSessionManager(SDLAudioEngine *audioEngine);
+
+            ~SongSessionManager();
+
+            SongSessionManager(const SongSessionManager &) = delete;
+
+            SongSessionManager &operator=(const SongSessionManager &) = delete;
+
+            /**
+             * @brief Ouvre une session avec son propre SongPlayer.
+             * @return L'indice de la session, -1 si le moteur n'a plus de session libre.
+             */
+            int createSession(const std::string &name);
+
+            // Arrête la session et libère sa session moteur ; son indice n'est pas réutilisé
+            void removeSession(int session);
+
+            std::size_t sessionCount() const;
+
+            // nullptr si la session n'existe pas (ou plus)
+            SongPlayer *player(int session);
+
+            std::string getName(int session) const;
+
+            // Gain de la session, entre 0 et MAX_GAIN
+            void setGain(int session, float gain);
+            float getGain(int session) const;
+
+            void setMuted(int session, bool muted);
+            bool isMuted(int session) const;
+
+            void setSolo(int session, bool solo);
+            bool isSolo(int session) const;
+
+            /**
+             * @brief Joue chaque piste de la partition dans sa propre session (nommée comme la piste), toutes
+             * calées sur la même première trame.
+             * @return Les sessions ouvertes, dans l'ordre des pistes (les pistes vides sont ignorées).
+             */
+            std::vector<int> playTracks(const std::shared_ptr<const Model::Score> &score);
+
+            void stopAll();
+
+        private:
+            struct Session {
+                std::string name;
+                std::unique_ptr<SongPlayer> player;
+                float gain = 1.0f;
+                bool muted = false;
+                bool solo = false;
+            };
+
+            Session *find(int session);
+
+            const Session *find(int session) const;
+
+            // Recalcule le gain effectif de chaque session (sourdine, solos) et l'envoie au moteur
+            void updateGains();
+
+            SDLAudioEngine *audioEngine_; // Non-owning pointer
+            std::vector<std::unique_ptr<Session>> sessions_; // Indice = identifiant, nullptr une fois fermée
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_SONGSESSIONMANAGER_H
@@ -0,0 +1,64 @@
+#ifndef MUSICAPP_AUDIO_SPSCQUEUE_H
+#define MUSICAPP_AUDIO_SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace MusicApp {
+    namespace Audio {
+
+/**
+ * @brief File circulaire bornée sans verrou, à un seul producteur et un seul consommateur.
+ *
+ * Le consommateur (le callback audio) ne bloque jamais : tryPop() ne fait que des
+ * lectures/écritures atomiques. T doit être copiable sans allocation.
+ */
+        template<typename T, std::size_t Capacity>
+        class SpscQueue {
+            static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+        public:
+            /**
+             * @brief Ajoute un élément (côté producteur).
+             * @return false si la file est pleine.
+             */
+            bool tryPush(const T &item) {
+                const std::size_t head = head_.load(std::memory_order_relaxed);
+                if (head - tail_.load(std::memory_order_acquire) == Capacity) {
+                    return false;
+                }
+                buffer_[head & (Capacity - 1)] = item;
+                head_.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Retire l'élément le plus ancien (côté consommateur).
+             * @return false si la file est vide.
+             */
+            bool tryPop(T &item) {
+                const std::size_t tail = tail_.load(std::memory_order_relaxed);
+                if (tail == head_.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                item = buffer_[tail & (Capacity - 1)];
+                tail_.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool empty() const {
+                return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+            }
+
+        private:
+            // Indices sur des lignes de cache séparées pour éviter le faux partage entre les deux threads
+            alignas(64) std::atomic<std::size_t> head_{0};
+            alignas(64) std::atomic<std::size_t> tail_{0};
+            std::array<T, Capacity> buffer_{};
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_SPSCQUEUE_H
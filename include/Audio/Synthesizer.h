@@ -0,0 +1,124 @@
+#ifndef MUSICAPP_AUDIO_SYNTHESIZER_H
+#define MUSICAPP_AUDIO_SYNTHESIZER_H
+
+#include "VoicePool.h"
+#include "OutputStage.h"
+#include "Wavetable.h"
+#include "MixKernels.h"
+#include "VoiceGenerator.h"
+#include "../Core/PitchTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+        // Event sent from the control threads (UI, SongPlayer) to the audio callback.
+        // Plain data only: it is copied through a lock-free ring buffer and must not allocate.
+        struct AudioCommand {
+            enum class Type : Uint8 {
+                NoteOn,
+                NoteOff,
+                Velocity,
+                ClearScheduled, // Drops every scheduled command of sessionId that has not fired yet
+                SessionGain     // Sets the mix gain of sessionId (carried in velocity)
+            };
+
+            Type type;
+            InstrumentId instrumentId;
+            Uint8 pitchId;           // MIDI note number
+            SessionId sessionId;     // Owner of the voice (LIVE_SESSION for keyboard and mouse playing)
+            float frequency;         // Resolved on the producer side (NoteOn only)
+            float velocity;          // NoteOn, Velocity and SessionGain
+            Uint32 systemStartTimeMs;
+            Uint64 frame;            // Stream frame at which the command fires (0: start of the next block)
+            Uint64 inputTimestampNs; // SDL event timestamp of a live note-on (0: not measured)
+
+            AudioCommand() : type(Type::NoteOn), instrumentId(InstrumentId::Piano), pitchId(0),
+                             sessionId(LIVE_SESSION), frequency(0.0f), velocity(1.0f), systemStartTimeMs(0), frame(0),
+                             inputTimestampNs(0) {}
+        };
+
+/**
+ * @brief Cœur de synthèse indépendant de tout périphérique audio.
+ *
+ * Possède la réserve de voix, les générateurs, les tampons de travail et l'étage de sortie.
+ * SDLAudioEngine l'alimente depuis son callback ; le rendu hors ligne et les bancs d'essai
+ * l'utilisent directement, aussi vite que le processeur le permet.
+ * Toutes les méthodes non statiques sont à appeler depuis un seul thread de rendu.
+ */
+        class Synthesizer {
+        public:
+            static constexpr int DEFAULT_MAX_BLOCK_FRAMES = 4096;
+            static const unsigned int SAMPLE_RATE = 44100; // Make sample rate a known constant for ADSR calculations
+
+            explicit Synthesizer(std::size_t polyphony = VoicePool::DEFAULT_POLYPHONY);
+
+            /**
+             * @brief Redimensionne les tampons de travail (alloue : jamais depuis le callback audio).
+             */
+            void setMaxBlockFrames(int frames);
+
+            int getMaxBlockFrames() const { return maxBlockFrames_; }
+
+            /**
+             * @brief Applique un événement note-on/off/vélocité ou un gain de session, sans regarder sa trame.
+             * (ClearScheduled concerne l'ordonnanceur de l'appelant et est ignoré ici.)
+             */
+            void applyCommand(const AudioCommand &command);
+
+            /**
+             * @brief Mixe toutes les voix actives sur le bus float32, puis applique l'étage de sortie.
+             * @param numStereoSampleFrames Au plus getMaxBlockFrames().
+             * @return Le bus stéréo entrelacé, valide jusqu'au prochain appel.
+             */
+            float *renderBlock(int numStereoSampleFrames);
+
+            OutputStage &getOutputStage() { return outputStage_; }
+
+            std::size_t getActiveVoiceCount() const { return voicePool_.activeCount(); }
+
+            std::size_t getPolyphony() const { return voicePool_.capacity(); }
+
+            /**
+             * @brief Remplace le générateur qui rend les voix d'un instrument (alloue : jamais pendant le rendu).
+             * Le constructeur enregistre déjà le piano, le xylophone, la console 8 bits et la guitare.
+             */
+            void registerGenerator(InstrumentId instrumentId, std::unique_ptr<VoiceGenerator> generator);
+
+            float getSessionGain(SessionId sessionId) const { return sessionGains_[sessionId % MAX_SESSIONS]; }
+
+            // Fréquence d'une note ("C#4", "8bit_3"), 0 si le nom est inconnu. Le chemin temps réel utilise
+            // plutôt Core::PitchTable::frequency(note.midiNumber), sans relire le nom.
+            static float frequencyForNote(const std::string &pitchName);
+
+            // Maps an instrument name to its integer ID (unknown names use the piano voice, as before)
+            static InstrumentId instrumentIdForName(const std::string &instrumentName);
+
+            // Maps "C#4"/"Db4"/"8bit_N" to a MIDI note number, -1 if the name cannot be parsed (Core::Note::parse)
+            static int pitchIdForNote(const std::string &pitchName);
+
+        private:
+            // The instrument's generator; instruments without one fall back to the piano voice
+            VoiceGenerator &generatorFor(InstrumentId instrumentId);
+
+            int maxBlockFrames_;
+            std::vector<float> mixBuffer_;      // Float32 accumulation bus
+            std::vector<float> envelopeBuffer_; // Per-voice envelope of the current block (mono)
+            std::vector<float> voiceBuffer_;    // Per-voice oscillator output of the current block (mono)
+
+            OutputStage outputStage_;           // Single soft-clip + dither stage
+            VoicePool voicePool_;
+            std::array<float, MAX_SESSIONS> sessionGains_; // Applied to every voice of the session as it is mixed
+            std::array<std::unique_ptr<VoiceGenerator>, INSTRUMENT_COUNT> generators_; // Indexed by InstrumentId
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_SYNTHESIZER_H
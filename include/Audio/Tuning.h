@@ -0,0 +1,75 @@
+#ifndef MUSICAPP_AUDIO_TUNING_H
+#define MUSICAPP_AUDIO_TUNING_H
+
+#include "../Core/Note.h"
+#include <array>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace MusicApp {
+    namespace Audio {
+
+        // Fréquence de chaque numéro de note MIDI pour un tempérament et un diapason donnés.
+        // Calculée une seule fois ; une note-on n'y fait qu'un accès par index.
+        struct TuningTable {
+            std::string name;
+            float referenceFrequency = 440.0f; // Fréquence de A4 (MIDI 69)
+            std::array<float, Core::Note::COUNT> frequencies{};
+
+            // 0 (silence) hors de 0..127
+            float frequency(int midiNumber) const {
+                return Core::Note::isInRange(midiNumber) ? frequencies[midiNumber] : 0.0f;
+            }
+        };
+
+/**
+ * @brief Construction des tables d'accord : tempérament égal, intonation juste, pythagoricien, fichiers Scala.
+ *
+ * Toutes les tables placent A4 exactement sur le diapason demandé (440, 442, 415 Hz...). Les
+ * gammes non tempérées sont construites à partir de la tonique (C4 par défaut) et répétées à
+ * chaque période (l'octave, ou le dernier degré d'un fichier .scl).
+ */
+        namespace Tunings {
+
+            constexpr float DEFAULT_REFERENCE_FREQUENCY = 440.0f;
+
+            TuningTable equalTemperament(float referenceFrequency = DEFAULT_REFERENCE_FREQUENCY);
+
+            // Intonation juste à 5 limites (1/1, 16/15, 9/8, 6/5, 5/4, 4/3, 45/32, 3/2, 8/5, 5/3, 9/5, 15/8)
+            TuningTable justIntonation(float referenceFrequency = DEFAULT_REFERENCE_FREQUENCY,
+                                       int tonic = Core::Note::MIDDLE_C);
+
+            // Cycle de quintes justes 3/2 de la tonique, ramené dans l'octave
+            TuningTable pythagorean(float referenceFrequency = DEFAULT_REFERENCE_FREQUENCY,
+                                    int tonic = Core::Note::MIDDLE_C);
+
+            /**
+             * @brief Construit une table à partir des degrés d'une gamme.
+             * @param ratios Rapports des degrés 1..N à la tonique ; le dernier est la période (2/1 pour l'octave).
+             */
+            TuningTable fromRatios(const std::string &name, const std::vector<double> &ratios,
+                                   float referenceFrequency, int tonic = Core::Note::MIDDLE_C);
+
+            /**
+             * @brief Lit une gamme au format Scala (.scl) : description, nombre de degrés, puis un degré par ligne
+             * en cents ("701.955") ou en rapport ("3/2", "2"). Les lignes commençant par '!' sont ignorées.
+             * @return false (avec un message sur std::cerr) si le fichier est illisible ou mal formé.
+             */
+            bool loadScala(const std::string &filePath, float referenceFrequency, TuningTable &table,
+                           int tonic = Core::Note::MIDDLE_C);
+
+            bool parseScala(std::istream &input, const std::string &sourceName, float referenceFrequency,
+                            TuningTable &table, int tonic = Core::Note::MIDDLE_C);
+
+            /**
+             * @brief "equal", "just", "pythagorean" ou le chemin d'un fichier .scl.
+             */
+            bool fromName(const std::string &nameOrPath, float referenceFrequency, TuningTable &table);
+
+        } // namespace Tunings
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_TUNING_H
@@ -0,0 +1,79 @@
+#ifndef MUSICAPP_AUDIO_VOICEGENERATOR_H
+#define MUSICAPP_AUDIO_VOICEGENERATOR_H
+
+#include "VoicePool.h"  // For ActiveNote
+#include "Wavetable.h"  // For EnvelopeCurve
+#include <cmath>
+
+namespace MusicApp {
+    namespace Audio {
+
+        // Tampons de travail mono prêtés par le Synthesizer pour le rendu d'une voix (getMaxBlockFrames() trames)
+        struct VoiceScratch {
+            float *envelope;
+            float *voice;
+        };
+
+/**
+ * @brief Synthèse d'un timbre : une instance par instrument, enregistrée une fois dans le Synthesizer
+ * et retrouvée par InstrumentId.
+ *
+ * L'état de chaque note vit dans son ActiveNote ; un générateur n'en garde aucun, une même
+ * instance rend donc toutes les voix de son timbre. Toutes les méthodes sont appelées depuis le
+ * thread de rendu et ne doivent ni allouer ni bloquer.
+ */
+        class VoiceGenerator {
+        public:
+            virtual ~VoiceGenerator() = default;
+
+            // Note-on : la voix vient d'être réservée, fréquence, vélocité et session sont renseignées
+            virtual void prepare(ActiveNote &voice) { (void) voice; }
+
+            /**
+             * @brief Ajoute frames trames de la voix sur le bus stéréo entrelacé.
+             * @param gain Gain de mixage de la session de la voix, à appliquer avec la vélocité.
+             */
+            virtual void renderBlock(ActiveNote &voice, float *bus, int frames, float gain,
+                                     const VoiceScratch &scratch) = 0;
+
+            // Note-off, une fois la voix passée en relâchement par VoicePool::release()
+            virtual void release(ActiveNote &voice) { (void) voice; }
+
+            // Vrai quand la voix peut être rendue à la réserve (par défaut : relâchement terminé)
+            virtual bool isFinished(const ActiveNote &voice) const { return !voice.isActive(); }
+        };
+
+        // Briques communes aux générateurs : enveloppe ADSR par segments et lissage anti-clics
+        namespace VoiceDsp {
+            // Forme d'enveloppe ADSR d'une voix, durées en échantillons
+            struct EnvelopeShape {
+                float attackSamples;
+                float decaySamples;
+                float sustainLevel;
+                float releaseSamples;
+                const EnvelopeCurve *decayCurve;   // nullptr : décroissance linéaire vers le sustain
+                const EnvelopeCurve *releaseCurve;
+            };
+
+            // Nombre de trames (au plus available) dont l'instant reste avant la borne du segment
+            inline int framesBefore(float timeInSamples, float boundary, int available) {
+                const float remaining = std::ceil(boundary - timeInSamples);
+                if (remaining <= 0.0f) return 0;
+                return remaining < static_cast<float>(available) ? static_cast<int>(remaining) : available;
+            }
+
+            /**
+             * Remplit l'enveloppe du bloc segment par segment (attaque, décroissance, maintien, relâchement),
+             * sans test de phase par échantillon. Retourne le nombre de trames audibles : moins que frames
+             * quand le relâchement se termine dans le bloc, la voix redevient alors libre.
+             */
+            int renderEnvelope(ActiveNote &note, const EnvelopeShape &shape, float *envelope, int frames);
+
+            // Lissage à un pôle (anti-clics) sur la voix mono, avant panoramique
+            void smoothVoice(float *voice, int frames, float crossfade, float &previous);
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_VOICEGENERATOR_H
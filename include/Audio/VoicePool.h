@@ -0,0 +1,131 @@
+#ifndef MUSICAPP_AUDIO_VOICEPOOL_H
+#define MUSICAPP_AUDIO_VOICEPOOL_H
+
+#include <cstddef>
+#include <vector>
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+        // Identifiants entiers des timbres gérés par le moteur (remplacent les comparaisons de chaînes)
+        enum class InstrumentId : Uint8 {
+            Piano = 0,
+            Xylophone,
+            Chiptune8Bit,
+            Guitar,
+            Count
+        };
+
+        static constexpr std::size_t INSTRUMENT_COUNT = static_cast<std::size_t>(InstrumentId::Count);
+        static constexpr std::size_t PITCH_COUNT = 128; // Numéros de note MIDI 0..127
+
+        // Session de lecture propriétaire d'une voix ou d'une commande : LIVE_SESSION pour le jeu au clavier et à la
+        // souris, une session par SongPlayer sinon. Deux sessions jouant la même note du même timbre ne se coupent pas.
+        using SessionId = Uint8;
+        static constexpr SessionId LIVE_SESSION = 0;
+        static constexpr std::size_t MAX_SESSIONS = 16;
+
+        struct ActiveNote {
+            InstrumentId instrumentId;
+            Uint8 pitchId;           // MIDI note number
+            SessionId sessionId;
+            float frequency;
+            bool isPlaying;          // True if note is in Attack, Decay, or Sustain phase
+            Uint32 systemStartTimeMs; // SDL_GetTicks() when playSound was called
+            float velocity;          // Between 0.0 and 1.0, representing the strength of the note
+
+            float currentTimeInSamples; // Current sample position in the note's lifecycle (for ADSR or release phase)
+            bool needsRelease;       // Flag to indicate if release envelope should be played
+            float currentEnvelopeValue; // To allow smooth transition to release from any point
+
+            // Variables pour éviter les bruits parasites
+            Uint32 phase;            // Phase continue de l'oscillateur principal (accumulateur de table d'onde)
+            float prevSample;        // Échantillon précédent (mono, avant panoramique) pour le crossfading
+
+            // Oscillateurs secondaires (résonance, vibrato), remis à zéro au relâchement comme le temps de la note
+            Uint32 resonancePhase;
+            Uint32 modulationPhase;
+            float resonanceLevel;    // Décroissance exponentielle de la résonance, mise à jour par multiplication
+            Uint32 noiseState;       // Générateur de bruit propre à la voix
+
+            // Note-on reçus pour cette voix et pas encore relâchés : deux notes superposées de même hauteur
+            // partagent la voix, qui ne passe en relâchement qu'au note-off de la dernière
+            Uint16 heldNoteCount;
+
+            // Ordre d'allocation et de relâchement, utilisé par la politique de vol de voix
+            Uint64 noteOnOrder;
+            Uint64 releaseOrder;
+
+            // ADSR parameters (durations in samples at a fixed sample rate)
+            // These assume SAMPLE_RATE is 44100. Define them with that assumption.
+            static constexpr float ATTACK_DURATION_SAMPLES = 44100 * 0.01f; // 10ms
+            static constexpr float DECAY_DURATION_SAMPLES = 44100 * 0.1f;   // 100ms
+            static constexpr float SUSTAIN_LEVEL = 0.7f;
+            static constexpr float RELEASE_DURATION_SAMPLES = 44100 * 0.2f; // 200ms
+
+            ActiveNote() : instrumentId(InstrumentId::Piano), pitchId(0), sessionId(LIVE_SESSION), frequency(0.0f),
+                           isPlaying(false),
+                           systemStartTimeMs(0), velocity(1.0f),
+                           currentTimeInSamples(0.0f), needsRelease(false), currentEnvelopeValue(0.0f),
+                           phase(0), prevSample(0.0f),
+                           resonancePhase(0), modulationPhase(0), resonanceLevel(1.0f), noiseState(0x9E3779B9u),
+                           heldNoteCount(0), noteOnOrder(0), releaseOrder(0) {}
+
+            bool isActive() const { return isPlaying || needsRelease; }
+        };
+
+/**
+ * @brief Réserve de voix de taille fixe, allouée une seule fois.
+ *
+ * Toutes les voix sont contiguës en mémoire et le callback audio les parcourt sans
+ * jamais allouer. Quand la réserve est pleine, une voix est volée : d'abord la voix
+ * relâchée la plus ancienne, sinon la voix tenue la plus ancienne.
+ * Utilisée uniquement depuis le thread audio.
+ */
+        class VoicePool {
+        public:
+            static constexpr std::size_t DEFAULT_POLYPHONY = 64;
+
+            explicit VoicePool(std::size_t polyphony = DEFAULT_POLYPHONY);
+
+            /**
+             * @brief Cherche la voix active jouant ce timbre et cette hauteur pour cette session.
+             * @return nullptr si aucune voix ne correspond.
+             */
+            ActiveNote *find(InstrumentId instrumentId, Uint8 pitchId, SessionId sessionId = LIVE_SESSION);
+
+            /**
+             * @brief Réserve une voix pour une nouvelle note (réutilise la voix de la même note de la même session si
+             * elle sonne encore, en comptant un note-on de plus si elle est tenue).
+             */
+            ActiveNote &allocate(InstrumentId instrumentId, Uint8 pitchId, SessionId sessionId = LIVE_SESSION);
+
+            /**
+             * @brief Passe la voix en phase de relâchement.
+             */
+            void release(ActiveNote &voice);
+
+            /**
+             * @brief Note-off d'une voix tenue : relâche la voix seulement si c'était son dernier note-on.
+             * @return true si la voix est passée en relâchement.
+             */
+            bool releaseHeldNote(ActiveNote &voice);
+
+            std::size_t capacity() const { return voices_.size(); }
+
+            std::size_t activeCount() const;
+
+            ActiveNote *begin() { return voices_.data(); }
+
+            ActiveNote *end() { return voices_.data() + voices_.size(); }
+
+        private:
+            std::vector<ActiveNote> voices_;
+            Uint64 eventCounter_;
+        };
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_VOICEPOOL_H
@@ -0,0 +1,145 @@
+#ifndef MUSICAPP_AUDIO_WAVETABLE_H
+#define MUSICAPP_AUDIO_WAVETABLE_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <SDL3/SDL_stdinc.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+        // Harmonique d'une forme d'onde : numéro (1 = fondamentale) et amplitude
+        struct Partial {
+            int harmonic;
+            float amplitude;
+        };
+
+/**
+ * @brief Oscillateur à table d'onde à bande limitée, remplaçant les appels à std::sin par échantillon.
+ *
+ * Une table contient une ou plusieurs couches (chacune une somme de partiels) qui partagent la
+ * même phase ; les couches sont entrelacées pour qu'une seule lecture donne toutes les valeurs.
+ * Chaque table existe en MIP_LEVELS versions, une par octave, dont on retire les harmoniques qui
+ * dépasseraient la fréquence de Nyquist pour la note la plus aiguë de l'octave (pas de repliement).
+ *
+ * La phase est un accumulateur 32 bits : le débordement naturel fait le bouclage sur la période.
+ */
+        class Wavetable {
+        public:
+            static constexpr int TABLE_BITS = 11;
+            static constexpr int TABLE_SIZE = 1 << TABLE_BITS; // 2048 points par période
+            static constexpr int MIP_LEVELS = 11;              // Octaves à partir de LOWEST_MIP_FREQUENCY
+            static constexpr float LOWEST_MIP_FREQUENCY = 20.0f;
+
+            // Découpage de la phase : index dans la table (bits hauts) et fraction d'interpolation (bits bas)
+            static constexpr int FRACTION_BITS = 32 - TABLE_BITS;
+            static constexpr Uint32 FRACTION_MASK = (1u << FRACTION_BITS) - 1;
+            static constexpr float FRACTION_SCALE = 1.0f / static_cast<float>(1u << FRACTION_BITS);
+
+            Wavetable(const std::vector<std::vector<Partial>> &layers, float sampleRate);
+
+            int layerCount() const { return layerCount_; }
+
+            /**
+             * @brief Table (entrelacée) dont le contenu harmonique reste sous Nyquist à cette fréquence.
+             */
+            const float *mipFor(float frequency) const;
+
+            static Uint32 phaseIncrement(float frequency, float sampleRate) {
+                return static_cast<Uint32>(static_cast<double>(frequency) / sampleRate * 4294967296.0);
+            }
+
+            /**
+             * @brief Lit les Layers couches à la phase donnée, avec interpolation linéaire.
+             */
+            template<int Layers>
+            static void read(const float *mip, Uint32 phase, float *out) {
+                const Uint32 index = phase >> FRACTION_BITS;
+                const float fraction = static_cast<float>(phase & FRACTION_MASK) * FRACTION_SCALE;
+                const float *row0 = mip + static_cast<std::size_t>(index) * Layers;
+                const float *row1 = row0 + Layers; // Le point de garde en fin de table évite le modulo
+                for (int layer = 0; layer < Layers; ++layer) {
+                    out[layer] = row0[layer] + (row1[layer] - row0[layer]) * fraction;
+                }
+            }
+
+            static float read(const float *mip, Uint32 phase) {
+                float value;
+                read<1>(mip, phase, &value);
+                return value;
+            }
+
+        private:
+            int layerCount_;
+            std::size_t mipStride_;
+            std::vector<float> data_; // [mip][TABLE_SIZE + 1][layer]
+        };
+
+/**
+ * @brief Courbe d'enveloppe précalculée sur [0, 1] (attaque, relâchement, décroissance).
+ */
+        class EnvelopeCurve {
+        public:
+            static constexpr int CURVE_SIZE = 1024;
+
+            explicit EnvelopeCurve(const std::function<float(float)> &shape);
+
+            float at(float x) const {
+                if (x <= 0.0f) return points_[0];
+                if (x >= 1.0f) return points_[CURVE_SIZE];
+                const float position = x * CURVE_SIZE;
+                const int index = static_cast<int>(position);
+                return points_[index] + (points_[index + 1] - points_[index]) * (position - static_cast<float>(index));
+            }
+
+        private:
+            float points_[CURVE_SIZE + 1];
+        };
+
+        // Bruit blanc bipolaire [-1, 1) par voix (xorshift32), sans l'état global ni le verrou de std::rand
+        inline float bipolarNoise(Uint32 &state) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return static_cast<float>(state) * (2.0f / 4294967296.0f) - 1.0f;
+        }
+
+/**
+ * @brief Tables partagées par les générateurs du moteur, construites une seule fois.
+ */
+        namespace Wavetables {
+            // Construit toutes les tables ; à appeler hors du thread audio (le premier accès alloue)
+            void prepare();
+
+            // Couches : fondamentale, harmoniques 2+3, harmonique 4, harmonique 5
+            const Wavetable &piano();
+
+            // Couches : fondamentale, harmoniques 2+4, harmonique 6
+            const Wavetable &xylophone();
+
+            // Onde carrée à bande limitée (harmoniques impaires)
+            const Wavetable &square();
+
+            const Wavetable &sine();
+
+            // (1 - cos(pi x)) / 2
+            const EnvelopeCurve &attackCurve();
+
+            // (0.5 + 0.5 cos(pi x)) * exp(-3 x)
+            const EnvelopeCurve &releaseCurve();
+
+            // (0.5 + 0.5 cos(pi x)) * exp(-2 x), plus court pour la console 8-bit
+            const EnvelopeCurve &chiptuneReleaseCurve();
+
+            // exp(-2.5 x), décroissance du xylophone
+            const EnvelopeCurve &xylophoneDecayCurve();
+
+            // exp(-4 x) (1 - x), corde pincée : s'éteint complètement en fin de décroissance
+            const EnvelopeCurve &pluckDecayCurve();
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
+
+#endif // MUSICAPP_AUDIO_WAVETABLE_H
@@ -1,7 +1,8 @@
 #ifndef MUSICAPP_CORE_NOTE_H
 #define MUSICAPP_CORE_NOTE_H
 
-#include <string> // For pitch name, or use int for MIDI value
+#include <string> // For pitch name
+#include <string_view>
 
 namespace MusicApp::Core {
 
@@ -9,20 +10,87 @@ namespace MusicApp::Core {
  * @brief Represents a musical note.
  *
  * This could be expanded to include duration, velocity, etc.
- * For now, it's a simple representation of pitch.
+ * For now, it's a simple representation of pitch: the name as written in scores and by the
+ * views ("C4", "G#5", "Db4", "8bit_3") and the MIDI note number parsed once from it, which
+ * is what the audio path indexes its tables with.
  */
 struct Note {
-    // Example: "C4", "G#5", or a MIDI note number
+    static constexpr int INVALID = -1;   // midiNumber of a name that cannot be parsed
+    static constexpr int COUNT = 128;    // MIDI note numbers 0..127
+    static constexpr int MIDDLE_C = 60;  // C4
+
+    // Example: "C4", "G#5", "8bit_3"
     std::string pitchName;
-    // Or use an integer for MIDI note value:
-    // int midiValue;
+    // MIDI note value (C4 = 60), INVALID if pitchName is not a note
+    int midiNumber;
 
     // Optional: duration in milliseconds
     // int durationMs;
 
-    // Constructor
-    explicit Note(std::string pName) : pitchName(std::move(pName)) {}
-    // explicit Note(int mValue) : midiValue(mValue) {}
+    // Constructors
+    explicit Note(std::string pName) : pitchName(std::move(pName)), midiNumber(parse(pitchName)) {}
+
+    explicit Note(int mValue) : pitchName(format(mValue)), midiNumber(isInRange(mValue) ? mValue : INVALID) {}
+
+    bool isValid() const { return midiNumber != INVALID; }
+
+    static constexpr bool isInRange(int mValue) { return mValue >= 0 && mValue < COUNT; }
+
+    /**
+     * @brief Parses "C#4"/"Db4" (octave 0..9, C4 = 60) or an 8-bit console button "8bit_N" (N in 0..23).
+     * Takes a view so that score parsers can decode tokens in place, without building a string.
+     * @return The MIDI note number, INVALID if the name is malformed or out of range. Never throws.
+     */
+    static int parse(std::string_view name) {
+        // Console 8-bit : 0-6 notes blanches de C4, 7-11 notes noires, +12 pour la deuxième octave
+        static constexpr int EIGHT_BIT_SEMITONE_OFFSETS[12] = {0, 2, 4, 5, 7, 9, 11, 1, 3, 6, 8, 10};
+        if (name.compare(0, 5, "8bit_") == 0) {
+            if (name.size() == 5) return INVALID;
+            int buttonIndex = 0;
+            for (size_t i = 5; i < name.size(); ++i) {
+                if (name[i] < '0' || name[i] > '9') return INVALID;
+                buttonIndex = buttonIndex * 10 + (name[i] - '0');
+                if (buttonIndex >= 24) return INVALID;
+            }
+            return MIDDLE_C + EIGHT_BIT_SEMITONE_OFFSETS[buttonIndex % 12] + (buttonIndex / 12) * 12;
+        }
+
+        static constexpr int LETTER_SEMITONES[7] = {9, 11, 0, 2, 4, 5, 7}; // A B C D E F G
+        if (name.size() < 2 || name[0] < 'A' || name[0] > 'G') return INVALID;
+
+        int semitone = LETTER_SEMITONES[name[0] - 'A'];
+        size_t pos = 1;
+        if (name[pos] == '#') {
+            ++semitone;
+            ++pos;
+        } else if (name[pos] == 'b') {
+            --semitone;
+            ++pos;
+        }
+        if (pos >= name.size()) return INVALID;
+
+        int octave = 0;
+        for (; pos < name.size(); ++pos) {
+            if (name[pos] < '0' || name[pos] > '9') return INVALID;
+            octave = octave * 10 + (name[pos] - '0');
+            if (octave > 9) return INVALID;
+        }
+
+        const int mValue = (octave + 1) * 12 + semitone;
+        return isInRange(mValue) ? mValue : INVALID;
+    }
+
+    /**
+     * @brief Formats a MIDI note number as "C#4" (or "Db4" with useFlats), empty if out of range.
+     */
+    static std::string format(int mValue, bool useFlats = false) {
+        static const char *const SHARP_NAMES[12] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
+        static const char *const FLAT_NAMES[12] = {"C", "Db", "D", "Eb", "E", "F", "Gb", "G", "Ab", "A", "Bb", "B"};
+        if (!isInRange(mValue)) return std::string();
+        const int octave = mValue / 12 - 1;
+        if (octave < 0) return std::string(); // Octave -1 (MIDI 0..11) has no name in our notation
+        return std::string(useFlats ? FLAT_NAMES[mValue % 12] : SHARP_NAMES[mValue % 12]) + std::to_string(octave);
+    }
 };
 
 } // namespace MusicApp::Core
@@ -0,0 +1,55 @@
+#ifndef MUSICAPP_CORE_PITCHTABLE_H
+#define MUSICAPP_CORE_PITCHTABLE_H
+
+#include "Note.h"
+#include <array>
+
+namespace MusicApp::Core {
+
+/**
+ * @brief Equal-temperament frequencies (A4 = 440 Hz) for every MIDI note number, built at compile time.
+ *
+ * A note-on looks its frequency up by Note::midiNumber instead of hashing the pitch name.
+ */
+namespace PitchTable {
+
+    constexpr int A4_MIDI_NUMBER = 69;
+    constexpr double A4_FREQUENCY = 440.0;
+
+    namespace detail {
+        constexpr std::array<float, Note::COUNT> buildEqualTemperament() {
+            // Les 12 rapports de l'octave par multiplications successives, puis des puissances de deux exactes :
+            // l'erreur ne s'accumule pas d'une octave à l'autre
+            constexpr double SEMITONE_RATIO = 1.05946309435929526456; // 2^(1/12)
+            double semitoneRatios[12] = {};
+            double ratio = 1.0;
+            for (int i = 0; i < 12; ++i) {
+                semitoneRatios[i] = ratio;
+                ratio *= SEMITONE_RATIO;
+            }
+
+            std::array<float, Note::COUNT> table{};
+            const double C4_FREQUENCY = A4_FREQUENCY / semitoneRatios[A4_MIDI_NUMBER - Note::MIDDLE_C];
+            for (int note = 0; note < Note::COUNT; ++note) {
+                const int octavesFromC4 = (note - note % 12 - Note::MIDDLE_C) / 12;
+                double octaveScale = 1.0;
+                for (int i = 0; i < octavesFromC4; ++i) octaveScale *= 2.0;
+                for (int i = 0; i > octavesFromC4; --i) octaveScale *= 0.5;
+                table[note] = static_cast<float>(C4_FREQUENCY * octaveScale * semitoneRatios[note % 12]);
+            }
+            return table;
+        }
+    }
+
+    inline constexpr std::array<float, Note::COUNT> EQUAL_TEMPERAMENT = detail::buildEqualTemperament();
+
+    // Frequency in Hz of a MIDI note number, 0 (silence) if it is out of range
+    constexpr float frequency(int midiNumber) {
+        return Note::isInRange(midiNumber) ? EQUAL_TEMPERAMENT[midiNumber] : 0.0f;
+    }
+
+} // namespace PitchTable
+
+} // namespace MusicApp::Core
+
+#endif // MUSICAPP_CORE_PITCHTABLE_H
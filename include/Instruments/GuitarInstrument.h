@@ -3,6 +3,7 @@
 
 #include "../Core/Instrument.h"
 #include "../Audio/AudioEngine.h" // For AudioEngine parameter in playNote
+#include "../Audio/VoiceGenerator.h"
 #include <string>
 
 namespace MusicApp {
@@ -12,15 +13,20 @@ namespace Instruments {
  * @brief A Guitar instrument.
  *
  * This instrument tells the AudioEngine to play a note, identifying itself
- * as "Guitar". The actual sound generation is handled by the AudioEngine.
+ * as "Guitar", and renders the engine's plucked-string voices (VoiceGenerator).
  */
-class GuitarInstrument : public Core::Instrument {
+class GuitarInstrument : public Core::Instrument, public Audio::VoiceGenerator {
 public:
     GuitarInstrument();
     ~GuitarInstrument() override = default;
 
 
     void playNote(const Core::Note& note, Audio::AudioEngine& audioEngine) const override;
+
+    void renderBlock(Audio::ActiveNote& voice, float* bus, int frames, float gain,
+                     const Audio::VoiceScratch& scratch) override;
+
+    bool isFinished(const Audio::ActiveNote& voice) const override;
 };
 } // namespace Instruments
 } // namespace MusicApp
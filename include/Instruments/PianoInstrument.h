@@ -3,6 +3,7 @@
 
 #include "../Core/Instrument.h"
 #include "../Audio/AudioEngine.h" // For AudioEngine parameter in playNote
+#include "../Audio/VoiceGenerator.h"
 #include <string>
 
 namespace MusicApp {
@@ -12,15 +13,18 @@ namespace Instruments {
  * @brief A Piano instrument.
  *
  * This instrument tells the AudioEngine to play a note, identifying itself
- * as "Piano". The actual sound generation is handled by the AudioEngine.
+ * as "Piano", and renders the engine's piano voices (VoiceGenerator).
  */
-class PianoInstrument : public Core::Instrument {
+class PianoInstrument : public Core::Instrument, public Audio::VoiceGenerator {
 public:
     PianoInstrument();
     ~PianoInstrument() override = default;
 
     void playNote(const Core::Note& note, Audio::AudioEngine& audioEngine) const override;
 
+    void renderBlock(Audio::ActiveNote& voice, float* bus, int frames, float gain,
+                     const Audio::VoiceScratch& scratch) override;
+
 };
 
 } // namespace Instruments
@@ -3,6 +3,7 @@
 
 #include "../Core/Instrument.h"
 #include "../Audio/AudioEngine.h" // For AudioEngine parameter in playNote
+#include "../Audio/VoiceGenerator.h"
 #include <string>
 
 namespace MusicApp {
@@ -12,15 +13,18 @@ namespace Instruments {
  * @brief A simple synthesizer instrument.
  *
  * This instrument tells the AudioEngine to play a note, identifying itself
- * as a "SimpleSynth". The actual sound generation is handled by the AudioEngine.
+ * as a "SimpleSynth", and renders the engine's 8-bit console voices (VoiceGenerator).
  */
-class SimpleSynthInstrument : public Core::Instrument {
+class SimpleSynthInstrument : public Core::Instrument, public Audio::VoiceGenerator {
 public:
     SimpleSynthInstrument();
     ~SimpleSynthInstrument() override = default;
 
     void playNote(const Core::Note& note, Audio::AudioEngine& audioEngine) const override;
 
+    void renderBlock(Audio::ActiveNote& voice, float* bus, int frames, float gain,
+                     const Audio::VoiceScratch& scratch) override;
+
 };
 
 } // namespace Instruments
@@ -3,6 +3,7 @@
 
 #include "../Core/Instrument.h"
 #include "../Audio/AudioEngine.h" // For AudioEngine parameter in playNote
+#include "../Audio/VoiceGenerator.h"
 #include <string>
 
 namespace MusicApp {
@@ -12,14 +13,17 @@ namespace Instruments {
  * @brief A Xylophone instrument.
  *
  * This instrument tells the AudioEngine to play a note, identifying itself
- * as "Xylophone". The actual sound generation is handled by the AudioEngine.
+ * as "Xylophone", and renders the engine's xylophone voices (VoiceGenerator).
  */
-class XylophoneInstrument : public Core::Instrument {
+class XylophoneInstrument : public Core::Instrument, public Audio::VoiceGenerator {
 public:
     XylophoneInstrument();
     ~XylophoneInstrument() override = default;
 
     void playNote(const Core::Note& note, Audio::AudioEngine& audioEngine) const override;
+
+    void renderBlock(Audio::ActiveNote& voice, float* bus, int frames, float gain,
+                     const Audio::VoiceScratch& scratch) override;
 };
 
 } // namespace Instruments
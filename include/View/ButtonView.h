@@ -6,6 +6,7 @@
 #include <string>
 #include <cmath>
 #include "../../include/Controller/Button.h" 
+#include "../utils/GeometryBatch.h"
 
 class ButtonView {
 public:
@@ -17,22 +18,39 @@ public:
     void renderButtons(SDL_Renderer *renderer, const std::vector<Button> &buttons, bool isSongPlayingActive,
                        bool isSongPaused);
 
-    // Utility functions for drawing, moved from Controller
+    // Utility functions for drawing, moved from Controller (icons are added to the geometry batch)
     void renderTextCentered(SDL_Renderer *renderer, float centerX, float centerY, const std::string &text,
                             SDL_Color color);
 
     void renderSmallText(SDL_Renderer *renderer, float centerX, float centerY, const std::string &text,
                          SDL_Color color);
 
-    void drawFileIcon(SDL_Renderer *renderer, float centerX, float centerY, float size, SDL_Color color);
-    void drawPlayIcon(SDL_Renderer *renderer, float centerX, float centerY, float size, SDL_Color color);
-    void drawUpArrow(SDL_Renderer *renderer, float centerX, float centerY, float size, SDL_Color color);
-    void drawStopIcon(SDL_Renderer *renderer, float centerX, float centerY, float size, SDL_Color color);
+    void drawFileIcon(float centerX, float centerY, float size, SDL_Color color);
+    void drawPlayIcon(float centerX, float centerY, float size, SDL_Color color);
+    void drawUpArrow(float centerX, float centerY, float size, SDL_Color color);
+    void drawStopIcon(float centerX, float centerY, float size, SDL_Color color);
 
-    void drawPauseIcon(SDL_Renderer *renderer, float centerX, float centerY, float size, SDL_Color color);
+    void drawPauseIcon(float centerX, float centerY, float size, SDL_Color color);
 
     // Declaration ensured
 
 private:
+    static constexpr int SMALL_FONT_SIZE = 14;
+
+    // Draws text centered on (centerX, centerY) from the shared TextCache
+    void renderCachedText(SDL_Renderer *renderer, TTF_Font *font, float centerX, float centerY, const std::string &text,
+                          SDL_Color color);
+
+    // Label drawn once the button geometry has been flushed
+    struct Label {
+        float centerX;
+        float centerY;
+        std::string text;
+        bool small;
+    };
+
     TTF_Font *font_;
+    TTF_Font *smallFont_; // Owned by the font registry
+    GeometryBatch geometry;
+    std::vector<Label> labels; // Kept between frames to avoid reallocating
 };
\ No newline at end of file
@@ -7,11 +7,14 @@
 #include <cmath>
 #include <thread>
 #include <atomic>
+#include <memory>
 #include "Button.h"
 #include "../View/View.h"
 #include "../Audio/MusicFileReader.h"
+#include "../model/Score.h"
 
 class ButtonView;
+class NoteInputMap;
 
 // Forward declaration for the callback
 static void FileDialogCallback(void *userdata, const char *const *filePaths, int numFiles);
@@ -19,6 +22,7 @@ static void FileDialogCallback(void *userdata, const char *const *filePaths, int
 namespace MusicApp {
     namespace Audio {
         class AudioEngine;
+        class CompiledScore;
     }
 }
 
@@ -44,7 +48,8 @@ protected:
     // Imported song data
     std::string importedFilePath;
     std::string importedFileName;
-    std::vector<MusicalEvent> currentSongEvents_for_playback;
+    std::shared_ptr<const MusicApp::Audio::CompiledScore> compiledSong_; // Set for .mlsc files, text scores are streamed
+    std::shared_ptr<const Model::Score> midiSong_;                        // Set for .mid files, one track per channel
     bool songLoaded;
 
     // Button View
@@ -54,6 +59,12 @@ protected:
     std::string currentInstrumentName_for_song_;
     bool songPlayRequested_;
 
+    // Instrument used by the pending "Export" save dialog
+    std::string exportInstrumentName_;
+
+    // Set when what the controller shows has changed since the last presented frame
+    bool needsRedraw_;
+
 public:
     Controller();
 
@@ -70,14 +81,41 @@ public:
     virtual void render(SDL_Renderer *renderer, int windowWidth, int windowHeight, bool isSongPlayingActive,
                         bool isSongPaused) = 0;
 
+    // Redraw tracking: input handlers mark the controller dirty when the scene changes,
+    // the application clears the flag once the frame is presented
+    void markDirty() { needsRedraw_ = true; }
+    bool isDirty() const { return needsRedraw_; }
+    void clearDirty() { needsRedraw_ = false; }
+
+    // True while the view animates on its own and must be redrawn every frame
+    virtual bool isAnimating() const { return false; }
+
+    // Selects the instrument and adds the note regions of the model on screen (none by default)
+    virtual void fillNoteInputMap(NoteInputMap &) const {}
+
+    // Changes whenever the regions given by fillNoteInputMap move
+    virtual Uint32 getNoteLayoutVersion() const { return 0; }
+
+    // Render targets were reset: redraw the cached static layer of the view (recreate it if texturesLost)
+    virtual void invalidateStaticLayer(bool) {}
+
     float calculateRelativeWidth(int windowWidth, float percentage);
     float calculateRelativeHeight(int windowHeight, float percentage);
     void updateDimensions(int windowWidth, int windowHeight);
 
     void handleImportSong();
     void handlePlaySongClicked(const std::string &instrumentName);
+    // Asks for a destination file, then bounces the loaded song offline to WAV
+    void handleExportSong(const std::string &instrumentName);
     std::string getCurrentInstrumentForSong() const;
-    const std::vector<MusicalEvent>& getLoadedSongEvents() const;
+    // Path of the loaded text score, streamed by SongPlayer::playScoreFile
+    const std::string& getLoadedScorePath() const;
+
+    // Non-null when the loaded song is a compiled (.mlsc) score
+    std::shared_ptr<const MusicApp::Audio::CompiledScore> getLoadedCompiledScore() const;
+
+    // Non-null when the loaded song is a MIDI file, decoded into a multi-track score at import
+    std::shared_ptr<const Model::Score> getLoadedScore() const;
     bool isSongReadyToPlay() const;
 
     std::string getImportedFileName() const;
@@ -85,4 +123,8 @@ public:
     bool getSongLoaded() const;
 
     void resetPlayRequestStatus();
+
+private:
+    // Callback of the "Export" save dialog; userdata is the controller that opened it
+    static void exportDialogCallback(void *userdata, const char *const *filePaths, int);
 };
\ No newline at end of file
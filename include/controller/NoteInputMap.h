@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <unordered_map>
+#include <vector>
+#include "../Audio/VoicePool.h"
+
+// Note-on resolved straight from an input event: what SDLAudioEngine::noteOn takes
+struct NoteTrigger {
+    MusicApp::Audio::InstrumentId instrumentId;
+    int midiNumber;
+    float velocity;
+};
+
+/**
+ * Hit-test and keymap table of the instrument on screen, built ahead of time so that a mouse press or
+ * a key press becomes a NoteTrigger without going through the menu, the toolbar, the controller casts
+ * or note-name parsing. The controller fills the regions from its model layout (Controller::fillNoteInputMap)
+ * and the application rebuilds them whenever the layout version changes.
+ */
+class NoteInputMap {
+public:
+    // How the position of the click inside a region shapes the velocity
+    enum class VelocityShape : Uint8 {
+        Fixed,    // Full velocity wherever the key is pressed (piano)
+        Vertical, // 0.3 at the top edge up to 1.0 at the bottom (8-bit console buttons)
+        Strike    // Louder near the ends and the top of the bar (xylophone)
+    };
+
+    NoteInputMap();
+
+    void setInstrument(MusicApp::Audio::InstrumentId newInstrumentId) { instrumentId = newInstrumentId; }
+
+    MusicApp::Audio::InstrumentId getInstrument() const { return instrumentId; }
+
+    // Keyboard bindings do not depend on the layout and survive clearRegions()
+    void bindKey(SDL_Keycode key, int midiNumber, float velocity);
+
+    void clearRegions();
+
+    // Regions added last are tested first (piano black keys are added after the white keys they overlap).
+    // Regions with an invalid MIDI note number are ignored.
+    void addRegion(const SDL_FRect &rect, int midiNumber, VelocityShape shape);
+
+    bool triggerForKey(SDL_Keycode key, NoteTrigger &trigger) const;
+
+    bool triggerAt(float x, float y, NoteTrigger &trigger) const;
+
+private:
+    struct Region {
+        SDL_FRect rect;
+        int midiNumber;
+        VelocityShape shape;
+    };
+
+    struct KeyBinding {
+        int midiNumber;
+        float velocity;
+    };
+
+    static float velocityAt(const Region &region, float x, float y);
+
+    MusicApp::Audio::InstrumentId instrumentId;
+    std::vector<Region> regions;
+    std::unordered_map<SDL_Keycode, KeyBinding> keys;
+};
@@ -6,14 +6,21 @@
 #include "../View/PianoView.h"
 #include "../Core/Note.h"
 #include "../Audio/AudioEngine.h"
+#include "../Audio/VoicePool.h" // For InstrumentId
 
+// Keyboard controller; besides the piano it also plays the guitar, which has no view of its own
 class PianoAppController : public Controller {
 private:
     Piano *piano;
     PianoView *pianoView;
 
+    // Instrument played by the keys ("Piano" or "Guitar"), as named for AudioEngine::playSound
+    std::string instrumentName;
+    MusicApp::Audio::InstrumentId instrumentId;
+
 public:
-    PianoAppController(int windowWidth, int windowHeight, MusicApp::Audio::AudioEngine *audioE);
+    PianoAppController(int windowWidth, int windowHeight, MusicApp::Audio::AudioEngine *audioE,
+                       const std::string &instrumentName = "Piano");
 
     ~PianoAppController();
 
@@ -26,5 +33,11 @@ public:
     // Accesseur pour le piano
     Piano *getPiano() const { return piano; }
 
+    void fillNoteInputMap(NoteInputMap &map) const override;
+
+    Uint32 getNoteLayoutVersion() const override { return piano->getLayoutVersion(); }
+
+    void invalidateStaticLayer(bool texturesLost) override { pianoView->invalidateStaticLayer(texturesLost); }
+
     void render(SDL_Renderer *renderer, int windowWidth, int windowHeight, bool isSongPlayingActive, bool isSongPaused) override;
 };
\ No newline at end of file
@@ -9,6 +9,7 @@ class VideoGameAppController : public Controller {
 private:
     VideoGame *videoGame;
     VideoGameView *videoGameView;
+    bool showAudioMetrics; // Surcouche des mesures du callback audio sur l'écran de la console
 
 public:
     VideoGameAppController(int windowWidth, int windowHeight, MusicApp::Audio::AudioEngine *audioE);
@@ -23,5 +24,15 @@ public:
 
     VideoGame *getVideoGame() const { return videoGame; }
 
+    void toggleAudioMetricsOverlay() { showAudioMetrics = !showAudioMetrics; markDirty(); }
+
+    bool isAnimating() const override;
+
+    void fillNoteInputMap(NoteInputMap &map) const override;
+
+    Uint32 getNoteLayoutVersion() const override { return videoGame->getLayoutVersion(); }
+
+    void invalidateStaticLayer(bool texturesLost) override { videoGameView->invalidateStaticLayer(texturesLost); }
+
     void render(SDL_Renderer *renderer, int windowWidth, int windowHeight, bool isSongCurrentlyPlaying, bool isSongPaused) override;
 };
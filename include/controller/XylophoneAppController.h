@@ -26,6 +26,12 @@ public:
     // Accesseur pour le xylophone
     Xylophone *getXylophone() const { return xylophone; }
 
+    void fillNoteInputMap(NoteInputMap &map) const override;
+
+    Uint32 getNoteLayoutVersion() const override { return xylophone->getLayoutVersion(); }
+
+    void invalidateStaticLayer(bool texturesLost) override { xylophoneView->invalidateStaticLayer(texturesLost); }
+
     void render(SDL_Renderer *renderer, int windowWidth, int windowHeight, bool isSongPlayingActive,
                 bool isSongPaused) override;
 };
\ No newline at end of file
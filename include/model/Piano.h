@@ -38,6 +38,7 @@ private:
     int octaves;
     std::vector<PianoKey> pianoKeys; // Stores all keys
     int hoveredKeyIndex;             // Index of the hovered key (-1 if none)
+    Uint32 layoutVersion;            // Incremented each time the keys are laid out again
 
     void calculateKeyLayout(); // Private method to calculate key positions and names
 
@@ -71,6 +72,12 @@ public:
     // Method to clear hover state
     void clearHoveredKey();
 
+    // Index of the hovered key (-1 if none)
+    int getHoveredKeyIndex() const { return hoveredKeyIndex; }
+
     // Getter for the view to access key data for rendering
     const std::vector<PianoKey> &getPianoKeys() const { return pianoKeys; }
+
+    // Changes whenever key positions change (move, resize, octave added or removed), never on hover
+    Uint32 getLayoutVersion() const { return layoutVersion; }
 };
\ No newline at end of file
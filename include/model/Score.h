@@ -5,10 +5,126 @@
 #ifndef MUSIC_TEST_SCORE_H
 #define MUSIC_TEST_SCORE_H
 
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <SDL3/SDL_stdinc.h>
+#include "../Audio/VoicePool.h"     // For InstrumentId
+#include "../Audio/CompiledScore.h" // For ScoreEventRecord
 
-class Score {
+namespace Model {
 
-};
+    // A track (or clip) of a score: a named group of events with a default instrument
+    struct ScoreTrack {
+        std::string name;
+        MusicApp::Audio::InstrumentId instrument;
+    };
 
+    /**
+     * Polyphonic, multi-track score: each event has its own onset, duration, velocity, track and
+     * instrument, and events may overlap. Events are stored as parallel arrays (structure of arrays)
+     * sorted by onset frame (at Synthesizer::SAMPLE_RATE), so playback walks only the columns it
+     * reads and seek() jumps anywhere with binary searches.
+     *
+     * Events appended in onset order keep the score sorted; otherwise call sortByOnset() before
+     * seeking or playing (isSorted() tells).
+     */
+    class Score {
+    public:
+        using InstrumentId = MusicApp::Audio::InstrumentId;
+
+        static constexpr std::size_t MAX_TRACKS = 65536;
+
+        // Result of seek(frame): events before firstActive have all ended by frame, events in
+        // [firstActive, next) started before it (some may still sound), events from next on start at or after it
+        struct SeekPosition {
+            std::size_t firstActive;
+            std::size_t next;
+        };
+
+        // Returns the new track index (tracks are never removed)
+        std::size_t addTrack(const std::string &name, InstrumentId instrument);
+
+        std::size_t trackCount() const { return tracks_.size(); }
+
+        const ScoreTrack &track(std::size_t index) const { return tracks_[index]; }
+
+        // Changes the instrument of a track and of every event on it
+        void setTrackInstrument(std::size_t track, InstrumentId instrument);
+
+        // Plays the whole score with one instrument
+        void setInstrument(InstrumentId instrument);
+
+        // Adds an event played with its track's instrument
+        void addEvent(Uint64 onsetFrame, Uint32 durationFrames, Uint8 midiNumber, Uint8 velocity, std::size_t track);
+
+        void addEvent(Uint64 onsetFrame, Uint32 durationFrames, Uint8 midiNumber, Uint8 velocity, std::size_t track,
+                      InstrumentId instrument);
+
+        // Adds frame-stamped records (text, compiled or MIDI scores) to one track
+        void appendRecords(const MusicApp::Audio::ScoreEventRecord *records, std::size_t count, std::size_t track);
+
+        void reserve(std::size_t eventCount);
+
+        void clear();
+
+        void sortByOnset();
+
+        bool isSorted() const { return sorted_; }
+
+        std::size_t size() const { return onsetFrames_.size(); }
+
+        bool empty() const { return onsetFrames_.empty(); }
+
+        Uint64 onsetFrame(std::size_t index) const { return onsetFrames_[index]; }
+
+        Uint32 durationFrames(std::size_t index) const { return durationFrames_[index]; }
+
+        Uint64 endFrame(std::size_t index) const { return onsetFrames_[index] + durationFrames_[index]; }
+
+        Uint8 midiNumber(std::size_t index) const { return midiNumbers_[index]; }
+
+        Uint8 velocity(std::size_t index) const { return velocities_[index]; }
+
+        InstrumentId instrument(std::size_t index) const { return instruments_[index]; }
+
+        std::size_t trackOf(std::size_t index) const { return trackIndices_[index]; }
+
+        // Total length, trailing silence included; never shorter than the last note
+        Uint64 lengthFrames() const { return lengthFrames_; }
+
+        void setLengthFrames(Uint64 frames);
+
+        // O(log n) position lookup (the score must be sorted)
+        SeekPosition seek(Uint64 frame) const;
+
+        // One score per track, in track order, each holding that track (name, instrument) and its events; the
+        // song length is kept so the parts stay aligned
+        std::vector<Score> splitByTrack() const;
+
+        // One track per channel found in the records, every track played with the given instrument
+        static Score fromRecords(const MusicApp::Audio::ScoreEventRecord *records, std::size_t count,
+                                 Uint64 lengthFrames, InstrumentId instrument);
+
+    private:
+        void push(Uint64 onsetFrame, Uint32 durationFrames, Uint8 midiNumber, Uint8 velocity, Uint16 track,
+                  InstrumentId instrument);
+
+        std::vector<ScoreTrack> tracks_;
+
+        std::vector<Uint64> onsetFrames_;
+        std::vector<Uint32> durationFrames_;
+        std::vector<Uint8> midiNumbers_;
+        std::vector<Uint8> velocities_;
+        std::vector<InstrumentId> instruments_;
+        std::vector<Uint16> trackIndices_;
+        // Running maximum of the end frames, non-decreasing: seek() binary-searches it for notes still sounding
+        std::vector<Uint64> maxEndFrames_;
+
+        Uint64 lengthFrames_ = 0;
+        bool sorted_ = true;
+    };
+
+} // namespace Model
 
 #endif //MUSIC_TEST_SCORE_H
@@ -36,6 +36,7 @@ private:
     std::vector<ConsoleControl> controls; // Contrôles de la console
     int hoveredButtonIndex;           // Index du bouton survolé (-1 si aucun)
     int hoveredControlIndex;          // Index du contrôle survolé (-1 si aucun)
+    Uint32 layoutVersion;             // Incrémenté à chaque nouvelle disposition des boutons ou contrôles
 
     // Calculer la disposition des boutons
     void calculateButtonsLayout();
@@ -79,12 +80,18 @@ public:
 
     void clearHoveredControls();
 
+    // Index du bouton survolé (-1 si aucun)
+    int getHoveredButtonIndex() const { return hoveredButtonIndex; }
+
     // Accéder aux boutons pour le rendu
     const std::vector<GameButton> &getButtons() const { return buttons; }
 
     // Accéder aux contrôles pour le rendu
     const std::vector<ConsoleControl> &getControls() const { return controls; }
 
+    // Change quand la disposition change (déplacement, taille, addKeys/removeKeys), jamais au survol
+    Uint32 getLayoutVersion() const { return layoutVersion; }
+
     void setPosition(float newX, float newY);
 
     void setDimensions(float newWidth, float newHeight);
@@ -15,6 +15,7 @@ private:
     int bars;
     std::vector<XylophoneBar> xylophones;  // Stockage des lames du xylophone
     int hoveredBarIndex;                   // Index de la lame survolée (-1 si aucune)
+    Uint32 layoutVersion;                  // Incrémenté à chaque nouvelle disposition des lames
 
 public:
     Xylophone(float x = 0, float y = 0, float width = 0, float height = 0, int bars = 8);
@@ -42,6 +43,9 @@ public:
 
     void clearHoveredBar();
 
+    // Index de la lame survolée (-1 si aucune)
+    int getHoveredBarIndex() const { return hoveredBarIndex; }
+
     // Obtenir l'index de la lame à une position donnée
     int getBarAt(float mouseX, float mouseY) const;
 
@@ -51,6 +55,9 @@ public:
     // Accéder aux lames pour le rendu
     const std::vector<XylophoneBar> &getXylophoneBars() const { return xylophones; }
 
+    // Change quand la position des lames change (déplacement, taille, ajout ou retrait), jamais au survol
+    Uint32 getLayoutVersion() const { return layoutVersion; }
+
     // Calculer la disposition des lames
     void calculateBarsLayout();
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include "GeometryBatch.h"
 
 class DropdownMenu {
 private:
@@ -20,6 +21,7 @@ private:
     SDL_Color hoverColor;
     SDL_Color darkBlue;
     TTF_Font *font;
+    GeometryBatch geometry; // Formes du menu, un SDL_RenderGeometry par couche
 
 public:
     DropdownMenu(float x, float y, float width, float height, const std::string &headerLabel);
@@ -40,5 +42,6 @@ public:
 
     void closeMenu() { isOpen = false; }
 
-    void updateHoverState(float x, float y);
+    // Retourne true si l'élément survolé a changé (menu à redessiner)
+    bool updateHoverState(float x, float y);
 };
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+/**
+ * Lot de formes colorées (rectangles pleins, contours, traits, triangles) envoyé en un seul SDL_RenderGeometry
+ *
+ * Remplace les suites SDL_SetRenderDrawColor + SDL_RenderFillRect/SDL_RenderRect/SDL_RenderLine : les formes
+ * sont dessinées dans l'ordre d'ajout, avec le mode de mélange du rendu. Les contours et les traits font un
+ * pixel, aux mêmes pixels que SDL_RenderRect et SDL_RenderLine. Un texte ou une texture à dessiner par-dessus
+ * une partie du lot impose un flush() avant lui. Les tampons sont gardés d'une image à l'autre.
+ */
+class GeometryBatch {
+public:
+    GeometryBatch();
+
+    void setColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255);
+
+    void setColor(const SDL_Color &color);
+
+    void fillRect(const SDL_FRect &rect);
+
+    void rect(const SDL_FRect &rect);
+
+    void line(float x1, float y1, float x2, float y2);
+
+    void triangle(const SDL_FPoint &a, const SDL_FPoint &b, const SDL_FPoint &c);
+
+    bool empty() const { return indices.empty(); }
+
+    void clear();
+
+    /**
+     * Dessine tout le lot en un appel puis le vide
+     * @return false si SDL_RenderGeometry a échoué
+     */
+    bool flush(SDL_Renderer *renderer);
+
+private:
+    // Quadrilatère a, b, c, d (dans l'ordre du contour)
+    void quad(const SDL_FPoint &a, const SDL_FPoint &b, const SDL_FPoint &c, const SDL_FPoint &d);
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    SDL_FColor color;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_ttf.h>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace TextHelper {
+    /**
+     * Textures de texte conservées d'une image à l'autre, par (rendu, police, texte, couleur)
+     *
+     * Un libellé n'est rastérisé et envoyé au GPU qu'à sa première apparition ; au-delà de la capacité,
+     * le texte utilisé le moins récemment est détruit. Les polices doivent venir de GetFont() : leur
+     * adresse identifie la fonte et la taille tant que le registre ne les a pas fermées.
+     * À utiliser depuis le thread de rendu uniquement.
+     */
+    class TextCache {
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 256;
+
+        explicit TextCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+        ~TextCache();
+
+        TextCache(const TextCache &) = delete;
+
+        TextCache &operator=(const TextCache &) = delete;
+
+        // Cache partagé par toutes les vues
+        static TextCache &shared();
+
+        /**
+         * Texture du texte, créée au premier appel
+         * @param width, height Taille de la texture (facultatifs)
+         * @return Texture possédée par le cache (ne pas la détruire), valide jusqu'au prochain appel ;
+         * nullptr si le rendu du texte a échoué
+         */
+        SDL_Texture *get(SDL_Renderer *renderer, TTF_Font *font, const std::string &text, SDL_Color color,
+                         float *width = nullptr, float *height = nullptr);
+
+        // Détruit toutes les textures ; à appeler avant SDL_DestroyRenderer()
+        void clear();
+
+        std::size_t size() const { return entries_.size(); }
+
+    private:
+        struct Key {
+            SDL_Renderer *renderer;
+            TTF_Font *font;
+            std::string text;
+            Uint32 color; // RGBA
+
+            bool operator==(const Key &other) const {
+                return renderer == other.renderer && font == other.font && color == other.color &&
+                       text == other.text;
+            }
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const Key &key) const;
+        };
+
+        struct Entry {
+            Key key;
+            SDL_Texture *texture;
+            float width;
+            float height;
+        };
+
+        std::size_t capacity_;
+        std::list<Entry> entries_; // Du plus récemment utilisé au plus ancien
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+    };
+}
@@ -16,6 +16,19 @@ namespace TextHelper {
      */
     TTF_Font *LoadFont(const std::string &fontName, int ptsize);
 
+    /**
+     * Registre des polices : chaque police et taille n'est ouverte qu'une fois par processus
+     * @param fontName Nom du fichier de police
+     * @param ptsize Taille de la police en points
+     * @return Police possédée par le registre (ne pas la fermer) ou nullptr si échec
+     */
+    TTF_Font *GetFont(const std::string &fontName, int ptsize);
+
+    /**
+     * Ferme toutes les polices du registre ; à appeler avant TTF_Quit(), une fois le TextCache vidé
+     */
+    void CloseFonts();
+
     /**
      * Fonction d'aide qui enveloppe TTF_RenderText_Solid pour s'adapter à la SDL3
      * @param font La police à utiliser
@@ -5,4 +5,45 @@
 #ifndef MUSIC_TEST_FILE_UTILS_H
 #define MUSIC_TEST_FILE_UTILS_H
 
+#include <cstddef>
+#include <string>
+
+/**
+ * Fichier projeté en mémoire en lecture seule (mmap sous POSIX, CreateFileMapping sous Windows).
+ * Les pages ne sont lues qu'au premier accès : ouvrir un gros fichier ne coûte presque rien.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * Projette le fichier (chemin UTF-8). Un fichier vide s'ouvre avec size() == 0.
+     * @return false (avec un message sur std::cerr) si le fichier ne peut pas être ouvert ou projeté
+     */
+    bool open(const std::string &filePath);
+
+    void close();
+
+    bool isOpen() const { return isOpen_; }
+
+    const unsigned char *data() const { return data_; }
+
+    std::size_t size() const { return size_; }
+
+private:
+    const unsigned char *data_ = nullptr;
+    std::size_t size_ = 0;
+    bool isOpen_ = false;
+#ifdef _WIN32
+    void *fileHandle_ = nullptr;
+    void *mappingHandle_ = nullptr;
+#endif
+};
+
 #endif //MUSIC_TEST_FILE_UTILS_H
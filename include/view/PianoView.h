@@ -8,6 +8,9 @@ class PianoView : public View {
 private:
     Piano *piano;
 
+    // Keys at rest, redrawn only when the layout changes
+    void renderStaticLayer(SDL_Renderer *renderer) override;
+
 public:
     explicit PianoView(Piano *piano);
 
@@ -3,13 +3,34 @@
 #include "SDL3/SDL.h"
 #include "View.h"
 #include "../Model/VideoGame.h"
+#include "../Audio/AudioMetrics.h"
 
 class VideoGameView : public View {
 private:
     VideoGame *videoGame;
+    bool showAudioMetrics;
+    MusicApp::Audio::AudioMetricsSnapshot audioMetrics;
+
+    // Barres de charge du callback audio (dernier, moyenne, p99, max par rapport au budget), voix et xruns
+    void renderAudioMetrics(const SDL_FRect &screenRect);
+
+    // Boîtier, écran, clavier et contrôles au repos, redessinés seulement quand la disposition change
+    void renderStaticLayer(SDL_Renderer *renderer) override;
+
+    // Écran de la console (zone des mesures audio)
+    SDL_FRect screenArea() const;
+
+    // Touche i du clavier, au repos ou survolée (pulsation, halo)
+    void drawButton(const std::vector<GameButton> &buttons, size_t i, bool hovered);
+
+    // Contrôle (D-pad, A, B, Start, Select), au repos ou survolé
+    void drawControl(const ConsoleControl &control, bool hovered);
 
 public:
     explicit VideoGameView(VideoGame *videoGame);
 
+    // Mesures à afficher par-dessus l'écran de la console ; nullptr masque la surcouche
+    void setAudioMetrics(const MusicApp::Audio::AudioMetricsSnapshot *metrics);
+
     void render(SDL_Renderer *renderer, int windowWidth = 0, int windowHeight = 0) override;
 };
\ No newline at end of file
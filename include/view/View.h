@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SDL3/SDL.h"
+#include "../utils/GeometryBatch.h"
 #include <vector>
 #include <string>
 
@@ -13,11 +14,44 @@ protected:
     // Dimensions communes
     float topBarHeight = 129.0f;
 
+    // Formes de la vue, envoyées en un seul SDL_RenderGeometry par couche (flush() en fin de couche)
+    GeometryBatch geometry;
+
+    /**
+     * Recopie la couche statique de la vue depuis sa texture cible de rendu
+     *
+     * La couche (tout ce qui ne change pas d'une image à l'autre) n'est redessinée par renderStaticLayer()
+     * que si la taille de la sortie, la zone de l'instrument (bounds) ou layoutVersion changent. Sans prise en charge des textures
+     * cibles, elle est dessinée directement à chaque image.
+     */
+    void renderCachedLayer(SDL_Renderer *renderer, const SDL_FRect &bounds, Uint32 layoutVersion);
+
+    // Dessine la couche statique, aux mêmes coordonnées que l'écran
+    virtual void renderStaticLayer(SDL_Renderer *) {}
+
 public:
-    virtual ~View() = default;
+    View() = default;
+
+    View(const View &) = delete;
+
+    View &operator=(const View &) = delete;
+
+    virtual ~View();
 
     // La méthode render doit toujours recevoir les dimensions de la fenêtre pour permettre l'ajustement
     virtual void render(SDL_Renderer *renderer, int windowWidth = 0, int windowHeight = 0) = 0;
 
+    // Force la prochaine image à redessiner la couche statique (textures cibles perdues, changement de thème...) ;
+    // texturesLost : périphérique de rendu réinitialisé, la texture elle-même est recréée
+    void invalidateStaticLayer(bool texturesLost = false);
+
     // Méthode utilitaire pour dessiner les boutons
-};
\ No newline at end of file
+
+private:
+    SDL_Texture *staticLayer = nullptr; // Taille de la sortie du rendu
+    SDL_Renderer *staticLayerRenderer = nullptr;
+    SDL_FRect staticLayerBounds = {0, 0, 0, 0};
+    Uint32 staticLayerVersion = 0;
+    bool staticLayerValid = false;
+    bool renderTargetsUnsupported = false;
+};
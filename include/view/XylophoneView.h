@@ -8,6 +8,12 @@ class XylophoneView : public View {
 private:
     Xylophone *xylophone;
 
+    // Support, lames au repos et maillets, redessinés seulement quand la disposition change
+    void renderStaticLayer(SDL_Renderer *renderer) override;
+
+    // Lame avec sa bordure et ses cordons
+    void drawBar(const SDL_FRect &rect, SDL_Color color);
+
 public:
     explicit XylophoneView(Xylophone *xylophone);
 
@@ -1,6 +1,9 @@
 #include "../include/Application.h"
+#include <algorithm>
 #include <iostream>
 #include <SDL3/SDL_ttf.h>
+#include "../include/utils/TextHelper.h"
+#include "../include/utils/TextCache.h"
 #include <unordered_map>
 
 Application::Application(int width, int height)
@@ -13,11 +16,16 @@ Application::Application(int width, int height)
           initialized(false),
           currentInstrument(InstrumentType::PIANO),
           instrumentMenu(nullptr),
-          currentPlayingNote(""),
+          noteInputMapValid(false),
+          noteInputLayoutVersion(0),
+          mouseNote{MusicApp::Audio::InstrumentId::Piano, MusicApp::Core::Note::INVALID, 0.0f},
 isMouseButtonDown(false),
 sdlAudioEngine(nullptr), // Initialize SDLAudioEngine pointer
+songSessions(nullptr),
 songPlayer(nullptr),
-          lastNotePlayTime(0) {
+loopStartMarkSeconds(-1.0),
+          lastNotePlayTime(0),
+          vsyncEnabled(false) {
     // Initialiser le mapping clavier-notes
     initializeKeyboardMappings();
 }
@@ -50,6 +58,9 @@ void Application::initializeInstrumentMenu() {
         case InstrumentType::VIDEO_GAME:
             headerLabel = "Jeu vidéo";
             break;
+        case InstrumentType::GUITAR:
+            headerLabel = "Guitare";
+            break;
     }
 
     instrumentMenu = new DropdownMenu(mainAreaX, mainAreaY, mainAreaWidth, headerHeight, headerLabel);
@@ -72,6 +83,12 @@ void Application::initializeInstrumentMenu() {
         // Mettre à jour le texte du menu après changement
         initializeInstrumentMenu();
     });
+
+    instrumentMenu->addItem("Guitare", [this]() {
+        setInstrument(InstrumentType::GUITAR);
+        // Mettre à jour le texte du menu après changement
+        initializeInstrumentMenu();
+    });
 }
 
 bool Application::initialize() {
@@ -109,7 +126,10 @@ bool Application::initialize() {
     audioEngine = sdlAudioEngine;
 
     std::cout << "Application::initialize: About to create SongPlayer. Passing sdlAudioEngine address: " << sdlAudioEngine << std::endl;
-    songPlayer = new MusicApp::Audio::SongPlayer(sdlAudioEngine);
+    // Le morceau importé n'est qu'une session parmi d'autres : le jeu en direct et d'éventuels accompagnements
+    // se mixent avec lui sans se couper
+    songSessions = new MusicApp::Audio::SongSessionManager(sdlAudioEngine);
+    songPlayer = songSessions->player(songSessions->createSession("Song"));
     std::cout << "Application::initialize: songPlayer created at address: " << songPlayer << std::endl;
     if (!songPlayer) {
         std::cerr << "Application::initialize FATAL ERROR: new SongPlayer failed (returned nullptr)!" << std::endl;
@@ -138,6 +158,13 @@ bool Application::initialize() {
     }
     std::cout << "Application::initialize: Renderer created." << std::endl; // <-- ADD THIS
 
+    // Les images sont cadencées par la synchronisation verticale ; sans elle, run() limite à ~60 images/s
+    vsyncEnabled = SDL_SetRenderVSync(renderer, 1);
+    if (!vsyncEnabled) {
+        std::cerr << "Application::initialize: VSync unavailable, frames paced by the main loop: " << SDL_GetError()
+                  << std::endl;
+    }
+
     std::cout << "Application::initialize: Initializing instrument menu..." << std::endl; // <-- ADD THIS
     try {
         initializeInstrumentMenu();
@@ -189,9 +216,66 @@ void Application::setInstrument(InstrumentType instrument) {
         case InstrumentType::VIDEO_GAME:
             mainController = new VideoGameAppController(windowWidth, windowHeight, audioEngine);
             break;
+        case InstrumentType::GUITAR:
+            mainController = new PianoAppController(windowWidth, windowHeight, audioEngine, "Guitar");
+            break;
     }
 
     currentInstrument = instrument;
+    noteInputMapValid = false;
+}
+
+void Application::refreshNoteInputMap() {
+    if (!mainController) return;
+    Uint32 layoutVersion = mainController->getNoteLayoutVersion();
+    if (noteInputMapValid && layoutVersion == noteInputLayoutVersion) return;
+
+    mainController->fillNoteInputMap(noteInputMap);
+    noteInputLayoutVersion = layoutVersion;
+    noteInputMapValid = true;
+}
+
+bool Application::pressNoteAt(float x, float y, Uint64 timestampNs) {
+    if (!sdlAudioEngine) return false;
+
+    refreshNoteInputMap();
+    NoteTrigger trigger;
+    if (!noteInputMap.triggerAt(x, y, trigger)) return false;
+
+    sdlAudioEngine->noteOn(trigger.instrumentId, trigger.midiNumber, trigger.velocity, timestampNs);
+    mouseNote = trigger;
+    isMouseButtonDown = true;
+    lastNotePlayTime = SDL_GetTicks();
+    return true;
+}
+
+void Application::releaseMouseNote() {
+    // Relâche la note enfoncée, même si le pointeur a quitté la touche entre-temps
+    if (isMouseButtonDown && sdlAudioEngine) {
+        sdlAudioEngine->noteOff(mouseNote.instrumentId, mouseNote.midiNumber);
+    }
+    mouseNote.midiNumber = MusicApp::Core::Note::INVALID;
+    isMouseButtonDown = false;
+}
+
+void Application::playLoadedSong(const std::string &instrumentName) {
+    if (!songPlayer || !mainController) return;
+    if (auto compiledScore = mainController->getLoadedCompiledScore()) {
+        songPlayer->playSong(compiledScore, instrumentName);
+    } else if (auto score = mainController->getLoadedScore()) {
+        // Every track is played with the instrument currently on screen
+        auto arranged = std::make_shared<Model::Score>(*score);
+        arranged->setInstrument(MusicApp::Audio::Synthesizer::instrumentIdForName(instrumentName));
+        songPlayer->playSong(arranged);
+    } else {
+        songPlayer->playScoreFile(mainController->getLoadedScorePath(), instrumentName);
+    }
+}
+
+void Application::setTuning(const MusicApp::Audio::TuningTable &tuning) {
+    if (sdlAudioEngine) {
+        sdlAudioEngine->setTuning(tuning);
+    }
 }
 
 bool Application::run() {
@@ -209,22 +293,57 @@ bool Application::run() {
     bool quit = false;
     SDL_Event event;
 
-    std::unordered_map<std::string, bool> activeNotes;
-
     Uint32 lastUpdateTime = SDL_GetTicks();
 
+    // Boucle pilotée par les événements : une image n'est dessinée que si la scène a changé
+    const Uint32 HOUSEKEEPING_INTERVAL_MS = 100; // Répétition de la note tenue, nettoyage des notes longues
+    const Uint32 LONG_NOTE_CLEANUP_MS = 1000;
+    const Uint32 FRAME_INTERVAL_MS = 16;         // Cadence sans VSync
+    bool needsRedraw = true;
+    bool renderedPlayingState = false;
+    bool renderedPausedState = false;
+    Uint32 lastInputTime = SDL_GetTicks();
+    Uint32 lastFrameTime = 0;
+
     while (!quit) {
-        while (SDL_PollEvent(&event)) {
+        bool animating = mainController && mainController->isAnimating();
+        bool hasEvent;
+        if (needsRedraw || animating || (mainController && mainController->isDirty())) {
+            hasEvent = SDL_PollEvent(&event);
+        } else {
+            // Au repos : dormir jusqu'au prochain événement. Les tâches périodiques (note tenue à la souris,
+            // chanson en cours, nettoyage des notes juste après une saisie) réveillent la boucle à leur échéance.
+            Sint32 timeout = -1;
+            Uint32 now = SDL_GetTicks();
+            if (isMouseButtonDown || (songPlayer && songPlayer->isPlaying()) ||
+                now - lastInputTime < LONG_NOTE_CLEANUP_MS + HOUSEKEEPING_INTERVAL_MS) {
+                Uint32 elapsed = now - lastUpdateTime;
+                timeout = elapsed >= HOUSEKEEPING_INTERVAL_MS ? 0 : static_cast<Sint32>(HOUSEKEEPING_INTERVAL_MS - elapsed);
+            }
+            hasEvent = SDL_WaitEventTimeout(&event, timeout);
+        }
+
+        for (; hasEvent; hasEvent = SDL_PollEvent(&event)) {
+            // Survol : redessiné seulement si l'élément survolé change ; tout autre événement (clic, touche,
+            // fenêtre exposée ou redimensionnée, fin d'un dialogue de fichier) redessine
+            if (event.type != SDL_EVENT_MOUSE_MOTION) {
+                needsRedraw = true;
+                lastInputTime = SDL_GetTicks();
+            }
+
             if (event.type == SDL_EVENT_QUIT) {
                 quit = true;
             } else if (event.type == SDL_EVENT_KEY_DOWN) {
                 if (event.key.key == SDLK_ESCAPE) {
                     quit = true;
                 } else {
-                    handleKeyPress(event.key.key);
+                    handleKeyPress(event.key.key, event.key.timestamp);
                 }
             } else if (event.type == SDL_EVENT_KEY_UP) {
                 handleKeyRelease(event.key.key);
+            } else if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN && !instrumentMenu->isMenuOpen() &&
+                       pressNoteAt(event.button.x, event.button.y, event.button.timestamp)) {
+                // Note jouée directement depuis la table de l'instrument (sous la barre d'outils et le menu)
             } else if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
                 float mouseX, mouseY;
                 SDL_GetMouseState(&mouseX, &mouseY);
@@ -260,11 +379,12 @@ bool Application::run() {
                                         case InstrumentType::PIANO: instrumentForSong = "Piano"; break;
                                         case InstrumentType::XYLOPHONE: instrumentForSong = "Xylophone"; break;
                                         case InstrumentType::VIDEO_GAME: instrumentForSong = "8BitConsole"; break;
+                                        case InstrumentType::GUITAR: instrumentForSong = "Guitar"; break;
                                     }
                                      // Storing it in controller as if "play" was just clicked for the first time for this song
                                     mainController->handlePlaySongClicked(instrumentForSong);
                                 }
-                                songPlayer->playSong(mainController->getLoadedSongEvents(), instrumentForSong);
+                                playLoadedSong(instrumentForSong);
                                 //mainController->resetPlayRequestStatus();
                                 // Optionally: mainController->resetPlayRequestStatus();
                             } else if (mainController && mainController->getSongLoaded()) {
@@ -275,108 +395,40 @@ bool Application::run() {
                                     case InstrumentType::PIANO: instrumentForSong = "Piano"; break;
                                     case InstrumentType::XYLOPHONE: instrumentForSong = "Xylophone"; break;
                                     case InstrumentType::VIDEO_GAME: instrumentForSong = "8BitConsole"; break;
+                                    case InstrumentType::GUITAR: instrumentForSong = "Guitar"; break;
                                 }
                                 mainController->handlePlaySongClicked(instrumentForSong);
-                                songPlayer->playSong(mainController->getLoadedSongEvents(), instrumentForSong);
+                                playLoadedSong(instrumentForSong);
                             } else {
                                 std::cout << "Application: Play button clicked, but no song loaded or ready." << std::endl;
                             }
                         }
-                    } else if (PianoAppController *pianoController = dynamic_cast<PianoAppController *>(
-                        mainController)) {
-                        if (buttonClicked != -1) {
-                            pianoController->processButtonAction(buttonClicked);
-                        } else {
-                            std::string pitchName = pianoController->getPiano()->getPitchAt(mouseX, mouseY);
-                            if (!pitchName.empty()) {
-                                MusicApp::Core::Note note(pitchName);
-                                audioEngine->playSound("Piano", note);
-                                activeNotes[pitchName] = true;
-                                currentPlayingNote = pitchName;
-                                isMouseButtonDown = true;
-                                lastNotePlayTime = SDL_GetTicks();
-                            }
+                    } else if (buttonClicked == 6) { // "Export" button
+                        std::string instrumentForSong;
+                        switch (currentInstrument) {
+                            case InstrumentType::PIANO: instrumentForSong = "Piano"; break;
+                            case InstrumentType::XYLOPHONE: instrumentForSong = "Xylophone"; break;
+                            case InstrumentType::VIDEO_GAME: instrumentForSong = "8BitConsole"; break;
+                            case InstrumentType::GUITAR: instrumentForSong = "Guitar"; break;
                         }
-                    } else if (XylophoneAppController *xylophoneController = dynamic_cast<XylophoneAppController *>(
-                        mainController)) {
-                        if (buttonClicked != -1) {
+                        mainController->handleExportSong(instrumentForSong);
+                    } else if (buttonClicked != -1) {
+                        // Les clics sur les notes sont déjà traités par pressNoteAt : il ne reste que les boutons
+                        if (PianoAppController *pianoController = dynamic_cast<PianoAppController *>(mainController)) {
+                            pianoController->processButtonAction(buttonClicked);
+                        } else if (XylophoneAppController *xylophoneController = dynamic_cast<XylophoneAppController *>(mainController)) {
                             xylophoneController->processButtonAction(buttonClicked);
-                        } else {
-                            int barIndex = xylophoneController->getXylophone()->getBarAt(mouseX, mouseY);
-                            if (barIndex != -1) {
-                                // Convertir l'index en note
-                                std::string noteName;
-                                switch (barIndex) {
-                                    case 0:
-                                        noteName = "C4";
-                                        break;
-                                    case 1:
-                                        noteName = "D4";
-                                        break;
-                                    case 2:
-                                        noteName = "E4";
-                                        break;
-                                    case 3:
-                                        noteName = "F4";
-                                        break;
-                                    case 4:
-                                        noteName = "G4";
-                                        break;
-                                    case 5:
-                                        noteName = "A4";
-                                        break;
-                                    case 6:
-                                        noteName = "B4";
-                                        break;
-                                    case 7:
-                                        noteName = "C5";
-                                        break;
-                                    case 8:
-                                        noteName = "D5";
-                                        break;
-                                    case 9:
-                                        noteName = "E5";
-                                        break;
-                                    case 10:
-                                        noteName = "F5";
-                                        break;
-                                    case 11:
-                                        noteName = "G5";
-                                        break;
-                                    default:
-                                        noteName = "C4";
-                                        break;
-                                }
-
-                                // Stocker les informations de la note jouée
-                                currentPlayingNote = noteName;
-                                isMouseButtonDown = true;
-                                lastNotePlayTime = SDL_GetTicks();
-                            }
-
-                            // Appeler la méthode de gestion du clic
-                            xylophoneController->handleXylophoneKeyClick(mouseX, mouseY);
-                        }
-                    } else if (VideoGameAppController *videoGameController = dynamic_cast<VideoGameAppController *>(mainController)) {
-                        if (buttonClicked != -1) {
+                        } else if (VideoGameAppController *videoGameController = dynamic_cast<VideoGameAppController *>(mainController)) {
                             videoGameController->processButtonAction(buttonClicked);
-                        } else {
-                            videoGameController->handleVideoGameKeyClick(mouseX, mouseY);
-
-                            // Stocker l'information de la note actuellement jouée
-                            std::string noteName = videoGameController->getVideoGame()->getNoteAt(mouseX, mouseY);
-                            if (!noteName.empty()) {
-                                currentPlayingNote = noteName;
-                                isMouseButtonDown = true;
-                                lastNotePlayTime = SDL_GetTicks();
-                            }
                         }
                     }
                 }
             } else if (event.type == SDL_EVENT_MOUSE_MOTION) {
                 float mouseX, mouseY;
                 SDL_GetMouseState(&mouseX, &mouseY);
-                instrumentMenu->updateHoverState(mouseX, mouseY);
+                if (instrumentMenu->updateHoverState(mouseX, mouseY)) {
+                    needsRedraw = true;
+                }
 
                 if (!instrumentMenu->isMenuOpen()) {
                     if (PianoAppController *pianoController = dynamic_cast<PianoAppController *>(mainController)) {
@@ -388,86 +440,18 @@ bool Application::run() {
                     }
                 }
             } else if (event.type == SDL_EVENT_MOUSE_BUTTON_UP) {
-                float mouseX, mouseY;
-                SDL_GetMouseState(&mouseX, &mouseY);
-
-                if (PianoAppController *pianoController = dynamic_cast<PianoAppController *>(mainController)) {
-                    std::string pitchName = pianoController->getPiano()->getPitchAt(mouseX, mouseY);
-                    if (!pitchName.empty()) {
-                        MusicApp::Core::Note note(pitchName);
-                        MusicApp::Audio::SDLAudioEngine *engine = dynamic_cast<MusicApp::Audio::SDLAudioEngine *>(audioEngine);
-                        if (engine) {
-                            engine->stopSound("Piano", note);
-                            currentPlayingNote = "";
-                            isMouseButtonDown = false;
-                        }
-                    }
-                } else if (XylophoneAppController *xylophoneController = dynamic_cast<XylophoneAppController *>(mainController)) {
-                    int barIndex = xylophoneController->getXylophone()->getBarAt(mouseX, mouseY);
-                    if (barIndex != -1) {
-                        std::string noteName;
-                        switch (barIndex) {
-                            case 0:
-                                noteName = "C4";
-                                break;
-                            case 1:
-                                noteName = "D4";
-                                break;
-                            case 2:
-                                noteName = "E4";
-                                break;
-                            case 3:
-                                noteName = "F4";
-                                break;
-                            case 4:
-                                noteName = "G4";
-                                break;
-                            case 5:
-                                noteName = "A4";
-                                break;
-                            case 6:
-                                noteName = "B4";
-                                break;
-                            case 7:
-                                noteName = "C5";
-                                break;
-                            case 8:
-                                noteName = "D5";
-                                break;
-                            case 9:
-                                noteName = "E5";
-                                break;
-                            case 10:
-                                noteName = "F5";
-                                break;
-                            case 11:
-                                noteName = "G5";
-                                break;
-                            default:
-                                noteName = "C4";
-                                break;
-                        }
-
-                        MusicApp::Core::Note note(noteName);
-                        MusicApp::Audio::SDLAudioEngine *engine = dynamic_cast<MusicApp::Audio::SDLAudioEngine *>(audioEngine);
-                        if (engine) {
-                            engine->stopSound("Xylophone", note);
-                            currentPlayingNote = "";
-                            isMouseButtonDown = false;
-                        }
-                    }
-                } else if (VideoGameAppController *videoGameController = dynamic_cast<VideoGameAppController *>(mainController)) {
-                    std::string noteName = videoGameController->getVideoGame()->getNoteAt(mouseX, mouseY);
-                    if (!noteName.empty()) {
-                        MusicApp::Core::Note note(noteName);
-                        MusicApp::Audio::SDLAudioEngine *engine = dynamic_cast<MusicApp::Audio::SDLAudioEngine *>(audioEngine);
-                        if (engine) {
-                            engine->stopSound("8BitConsole", note);
-                            currentPlayingNote = "";
-                            isMouseButtonDown = false;
-                        }
-                    }
+                releaseMouseNote();
+            } else if (event.type == SDL_EVENT_RENDER_TARGETS_RESET || event.type == SDL_EVENT_RENDER_DEVICE_RESET) {
+                // Renderers Direct3D : le contenu des textures cibles (couche statique des vues) est perdu ;
+                // après une réinitialisation du périphérique, toutes les textures le sont, textes en cache compris
+                const bool texturesLost = event.type == SDL_EVENT_RENDER_DEVICE_RESET;
+                if (texturesLost) {
+                    TextHelper::TextCache::shared().clear();
+                }
+                if (mainController) {
+                    mainController->invalidateStaticLayer(texturesLost);
                 }
+                needsRedraw = true;
             } else if (event.type == SDL_EVENT_WINDOW_RESIZED) {
                 SDL_GetWindowSizeInPixels(window, &windowWidth, &windowHeight);
 
@@ -483,41 +467,45 @@ bool Application::run() {
         }
 
         Uint32 currentTime = SDL_GetTicks();
-        if (currentTime - lastUpdateTime > 100) {
+        if (currentTime - lastUpdateTime >= HOUSEKEEPING_INTERVAL_MS) {
             lastUpdateTime = currentTime;
 
-            if (isMouseButtonDown && !currentPlayingNote.empty() && (currentTime - lastNotePlayTime >= 450)) {
-                if (PianoAppController *pianoController = dynamic_cast<PianoAppController *>(mainController)) {
-                    MusicApp::Core::Note note(currentPlayingNote);
-                    audioEngine->playSound("Piano", note);
-                    lastNotePlayTime = currentTime;
-                } else if (XylophoneAppController *xylophoneController = dynamic_cast<XylophoneAppController *>(mainController)) {
-                    MusicApp::Core::Note note(currentPlayingNote);
-                    audioEngine->playSound("Xylophone", note);
-                    lastNotePlayTime = currentTime;
-                } else if (VideoGameAppController *videoGameController = dynamic_cast<VideoGameAppController *>(mainController)) {
-                    MusicApp::Core::Note note(currentPlayingNote);
-                    audioEngine->playSound("8BitConsole", note);
-                    lastNotePlayTime = currentTime;
-                }
+            if (isMouseButtonDown && sdlAudioEngine && (currentTime - lastNotePlayTime >= 450)) {
+                sdlAudioEngine->noteOn(mouseNote.instrumentId, mouseNote.midiNumber, mouseNote.velocity);
+                lastNotePlayTime = currentTime;
             }
 
             MusicApp::Audio::SDLAudioEngine *engine = dynamic_cast<MusicApp::Audio::SDLAudioEngine *>(audioEngine);
             if (engine) {
-                engine->cleanupLongPlayingNotes(1000);
+                engine->cleanupLongPlayingNotes(LONG_NOTE_CLEANUP_MS);
             }
         }
 
-
-        SDL_SetRenderDrawColor(renderer, 32, 32, 32, 255);
-        SDL_RenderClear(renderer);
-
         bool isPlayingActiveState = false;
         bool isPausedState = false;
         if (songPlayer) {
             isPlayingActiveState = songPlayer->isPlaying();
             isPausedState = songPlayer->isPaused();
         }
+        // Le bouton Play/Pause suit l'état de lecture, qui change aussi quand la chanson se termine
+        if (isPlayingActiveState != renderedPlayingState || isPausedState != renderedPausedState) {
+            needsRedraw = true;
+        }
+
+        animating = mainController && mainController->isAnimating();
+        if (!needsRedraw && !animating && !(mainController && mainController->isDirty())) {
+            continue;
+        }
+
+        if (!vsyncEnabled) {
+            Uint32 sinceLastFrame = SDL_GetTicks() - lastFrameTime;
+            if (sinceLastFrame < FRAME_INTERVAL_MS) {
+                SDL_Delay(FRAME_INTERVAL_MS - sinceLastFrame);
+            }
+        }
+
+        SDL_SetRenderDrawColor(renderer, 32, 32, 32, 255);
+        SDL_RenderClear(renderer);
 
         if (mainController) { // <-- ADD THIS NULL CHECK
             mainController->render(renderer, windowWidth, windowHeight, isPlayingActiveState, isPausedState);
@@ -531,9 +519,15 @@ bool Application::run() {
             std::cerr << "Application::run WARNING: instrumentMenu is NULL in render loop!" << std::endl; // <-- Log if null
         }
 
-        std::cout << "Application::run: Presenting renderer." << std::endl; // <-- ADD THIS (can be noisy, remove after debug)
         SDL_RenderPresent(renderer);
-        SDL_Delay(16);
+        lastFrameTime = SDL_GetTicks();
+
+        needsRedraw = false;
+        renderedPlayingState = isPlayingActiveState;
+        renderedPausedState = isPausedState;
+        if (mainController) {
+            mainController->clearDirty();
+        }
     }
     std::cout << "Application::run: Exited main loop." << std::endl; // <-- ADD THIS
     return true;
@@ -546,9 +540,10 @@ void Application::cleanup() {
     delete instrumentMenu;
     instrumentMenu = nullptr;
 
-    if (songPlayer) {
-        songPlayer->stopSong();
-        delete songPlayer;
+    if (songSessions) {
+        songSessions->stopAll();
+        delete songSessions;
+        songSessions = nullptr;
         songPlayer = nullptr;
     }
 
@@ -560,6 +555,10 @@ void Application::cleanup() {
         sdlAudioEngine = nullptr;
     }
 
+    // Cached text textures belong to the renderer, the fonts to SDL_ttf
+    TextHelper::TextCache::shared().clear();
+    TextHelper::CloseFonts();
+
     if (renderer) {
         SDL_DestroyRenderer(renderer);
         renderer = nullptr;
@@ -596,82 +595,89 @@ void Application::initializeKeyboardMappings() {
     keyboardMappings.push_back({SDLK_K, "C", 5});   // K -> Do (octave supérieure)
     keyboardMappings.push_back({SDLK_L, "D", 5});   // L -> Ré (octave supérieure)
     keyboardMappings.push_back({SDLK_M, "E", 5}); // M -> Mi (octave supérieure)
-}
 
-void Application::handleKeyPress(SDL_Keycode key) {
-    std::string note = getNoteForKey(key);
-    if (!note.empty()) {
-        if (!keyboardNotesState[key]) {
-            keyboardNotesState[key] = true;
-
-            MusicApp::Core::Note musicNote(note);
-            float velocity = getVelocityForKey();
-
-            auto sdlAudioEngine = dynamic_cast<MusicApp::Audio::SDLAudioEngine *>(audioEngine);
+    // Numéros MIDI résolus une fois ici : une touche enfoncée n'analyse plus de nom de note
+    for (const KeyboardMapping &mapping: keyboardMappings) {
+        noteInputMap.bindKey(mapping.key, MusicApp::Core::Note::parse(mapping.note + std::to_string(mapping.octave)),
+                             getVelocityForKey());
+    }
+}
 
-            switch (currentInstrument) {
-                case InstrumentType::PIANO:
-                    if (sdlAudioEngine) {
-                        sdlAudioEngine->playSound("Piano", musicNote, velocity);
-                    } else if (audioEngine) {
-                        audioEngine->playSound("Piano", musicNote);
-                    }
-                    break;
+void Application::handleKeyPress(SDL_Keycode key, Uint64 timestampNs) {
+    // F3 : mesures du thread audio sur l'écran de la console 8-bit
+    if (key == SDLK_F3) {
+        if (VideoGameAppController *videoGameController = dynamic_cast<VideoGameAppController *>(mainController)) {
+            videoGameController->toggleAudioMetricsOverlay();
+        }
+        return;
+    }
 
-                case InstrumentType::XYLOPHONE:
-                    if (sdlAudioEngine) {
-                        sdlAudioEngine->playSound("Xylophone", musicNote, velocity);
-                    } else if (audioEngine) {
-                        audioEngine->playSound("Xylophone", musicNote);
-                    }
-                    break;
+    if (handleTransportKey(key)) {
+        return;
+    }
 
-                case InstrumentType::VIDEO_GAME:
-                    if (sdlAudioEngine) {
-                        sdlAudioEngine->playSound("8BitConsole", musicNote, velocity);
-                    } else if (audioEngine) {
-                        audioEngine->playSound("8BitConsole", musicNote);
-                    }
-                    break;
-            }
+    refreshNoteInputMap();
+    NoteTrigger trigger;
+    if (heldKeyNotes.count(key) == 0 && noteInputMap.triggerForKey(key, trigger)) {
+        heldKeyNotes[key] = trigger;
 
-            SDL_Log("Note played via keyboard: %s, Instrument: %d", note.c_str(), static_cast<int>(currentInstrument));
+        if (sdlAudioEngine) {
+            sdlAudioEngine->noteOn(trigger.instrumentId, trigger.midiNumber, trigger.velocity, timestampNs);
         }
     }
 }
 
-void Application::handleKeyRelease(SDL_Keycode key) {
-    std::string note = getNoteForKey(key);
-    if (!note.empty()) {
-        keyboardNotesState[key] = false;
-
-        MusicApp::Core::Note musicNote(note);
-        auto sdlAudioEngine = dynamic_cast<MusicApp::Audio::SDLAudioEngine *>(audioEngine);
-        if (sdlAudioEngine) {
-            switch (currentInstrument) {
-                case InstrumentType::PIANO:
-                    sdlAudioEngine->stopSound("Piano", musicNote);
-                    break;
-                case InstrumentType::XYLOPHONE:
-                    sdlAudioEngine->stopSound("Xylophone", musicNote);
-                    break;
-                case InstrumentType::VIDEO_GAME:
-                    sdlAudioEngine->stopSound("8BitConsole", musicNote);
-                    break;
+bool Application::handleTransportKey(SDL_Keycode key) {
+    if (!songPlayer || !songPlayer->isPlaying()) return false;
+
+    const double SEEK_STEP_SECONDS = 5.0;
+    const float RATE_STEP = 0.25f;
+    switch (key) {
+        case SDLK_LEFT:
+            songPlayer->seek(std::max(0.0, songPlayer->getPositionSeconds() - SEEK_STEP_SECONDS));
+            return true;
+        case SDLK_RIGHT:
+            songPlayer->seek(songPlayer->getPositionSeconds() + SEEK_STEP_SECONDS);
+            return true;
+        case SDLK_HOME:
+            songPlayer->seek(0.0);
+            return true;
+        case SDLK_UP:
+            songPlayer->setPlaybackRate(songPlayer->getPlaybackRate() + RATE_STEP);
+            std::cout << "Application: Playback rate x" << songPlayer->getPlaybackRate() << std::endl;
+            return true;
+        case SDLK_DOWN:
+            songPlayer->setPlaybackRate(songPlayer->getPlaybackRate() - RATE_STEP);
+            std::cout << "Application: Playback rate x" << songPlayer->getPlaybackRate() << std::endl;
+            return true;
+        case SDLK_F5: // Point A
+            loopStartMarkSeconds = songPlayer->getPositionSeconds();
+            std::cout << "Application: Loop start set at " << loopStartMarkSeconds << " s." << std::endl;
+            return true;
+        case SDLK_F6: // Point B : la boucle A-B démarre
+            if (loopStartMarkSeconds >= 0.0 &&
+                songPlayer->setLoopRegion(loopStartMarkSeconds, songPlayer->getPositionSeconds())) {
+                std::cout << "Application: Looping from " << loopStartMarkSeconds << " s." << std::endl;
             }
-
-            SDL_Log("Note stopped via keyboard: %s, Instrument: %d", note.c_str(), static_cast<int>(currentInstrument));
-        }
+            return true;
+        case SDLK_F7:
+            songPlayer->clearLoopRegion();
+            loopStartMarkSeconds = -1.0;
+            return true;
+        default:
+            return false;
     }
 }
 
-std::string Application::getNoteForKey(SDL_Keycode key) {
-    for (const auto &mapping: keyboardMappings) {
-        if (mapping.key == key) {
-            return mapping.note + std::to_string(mapping.octave);
-        }
+void Application::handleKeyRelease(SDL_Keycode key) {
+    auto held = heldKeyNotes.find(key);
+    if (held == heldKeyNotes.end()) return;
+
+    const NoteTrigger trigger = held->second;
+    heldKeyNotes.erase(held);
+    if (sdlAudioEngine) {
+        sdlAudioEngine->noteOff(trigger.instrumentId, trigger.midiNumber);
     }
-    return "";
 }
 
 float Application::getVelocityForKey() {
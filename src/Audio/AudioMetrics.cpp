@@ -0,0 +1,118 @@
+#include "../../include/Audio/AudioMetrics.h"
+#include <algorithm>
+
+namespace MusicApp {
+    namespace Audio {
+
+        constexpr std::size_t AudioMetrics::HISTOGRAM_BUCKETS;
+        constexpr Uint32 AudioMetrics::HISTOGRAM_BUCKET_US;
+
+        AudioMetrics::AudioMetrics() : outputBufferNs_(0) {
+            reset();
+        }
+
+        void AudioMetrics::recordCallback(Uint64 renderNs, Uint64 budgetNs, Uint32 activeVoices) {
+            // Un seul écrivain (le thread audio) : charger puis stocker suffit, sans compare-exchange
+            callbackCount_.store(callbackCount_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            totalRenderNs_.store(totalRenderNs_.load(std::memory_order_relaxed) + renderNs, std::memory_order_relaxed);
+            totalBudgetNs_.store(totalBudgetNs_.load(std::memory_order_relaxed) + budgetNs, std::memory_order_relaxed);
+            lastRenderNs_.store(renderNs, std::memory_order_relaxed);
+            lastBudgetNs_.store(budgetNs, std::memory_order_relaxed);
+            if (renderNs > maxRenderNs_.load(std::memory_order_relaxed)) {
+                maxRenderNs_.store(renderNs, std::memory_order_relaxed);
+            }
+            if (renderNs > budgetNs) {
+                xrunCount_.store(xrunCount_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            activeVoices_.store(activeVoices, std::memory_order_relaxed);
+            if (activeVoices > peakVoices_.load(std::memory_order_relaxed)) {
+                peakVoices_.store(activeVoices, std::memory_order_relaxed);
+            }
+
+            const std::size_t bucket = std::min<std::size_t>(
+                    static_cast<std::size_t>(renderNs / (HISTOGRAM_BUCKET_US * 1000ull)), HISTOGRAM_BUCKETS - 1);
+            histogram_[bucket].store(histogram_[bucket].load(std::memory_order_relaxed) + 1,
+                                     std::memory_order_relaxed);
+        }
+
+        void AudioMetrics::recordInputLatency(Uint64 latencyNs) {
+            inputNoteCount_.store(inputNoteCount_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            totalInputLatencyNs_.store(totalInputLatencyNs_.load(std::memory_order_relaxed) + latencyNs,
+                                       std::memory_order_relaxed);
+            lastInputLatencyNs_.store(latencyNs, std::memory_order_relaxed);
+            if (latencyNs > maxInputLatencyNs_.load(std::memory_order_relaxed)) {
+                maxInputLatencyNs_.store(latencyNs, std::memory_order_relaxed);
+            }
+        }
+
+        AudioMetricsSnapshot AudioMetrics::snapshot() const {
+            AudioMetricsSnapshot result;
+            result.callbackCount = callbackCount_.load(std::memory_order_relaxed);
+            result.xrunCount = xrunCount_.load(std::memory_order_relaxed);
+            result.lastRenderUs = lastRenderNs_.load(std::memory_order_relaxed) / 1000.0;
+            result.lastBudgetUs = lastBudgetNs_.load(std::memory_order_relaxed) / 1000.0;
+            result.maxRenderUs = maxRenderNs_.load(std::memory_order_relaxed) / 1000.0;
+            result.activeVoices = activeVoices_.load(std::memory_order_relaxed);
+            result.peakVoices = peakVoices_.load(std::memory_order_relaxed);
+            result.inputNoteCount = inputNoteCount_.load(std::memory_order_relaxed);
+            result.lastInputLatencyUs = lastInputLatencyNs_.load(std::memory_order_relaxed) / 1000.0;
+            result.maxInputLatencyUs = maxInputLatencyNs_.load(std::memory_order_relaxed) / 1000.0;
+            result.outputBufferUs = outputBufferNs_.load(std::memory_order_relaxed) / 1000.0;
+            if (result.inputNoteCount > 0) {
+                result.averageInputLatencyUs = totalInputLatencyNs_.load(std::memory_order_relaxed) / 1000.0 /
+                                               static_cast<double>(result.inputNoteCount);
+            }
+
+            const Uint64 totalRenderNs = totalRenderNs_.load(std::memory_order_relaxed);
+            const Uint64 totalBudgetNs = totalBudgetNs_.load(std::memory_order_relaxed);
+            if (result.callbackCount > 0) {
+                result.averageRenderUs = totalRenderNs / 1000.0 / static_cast<double>(result.callbackCount);
+            }
+            if (totalBudgetNs > 0) {
+                result.averageLoad = static_cast<double>(totalRenderNs) / static_cast<double>(totalBudgetNs);
+            }
+
+            // Le 99e centile est lu dans l'histogramme : borne haute de la case qui atteint 99 % des callbacks
+            std::array<Uint32, HISTOGRAM_BUCKETS> counts{};
+            Uint64 histogramTotal = 0;
+            for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+                counts[i] = histogram_[i].load(std::memory_order_relaxed);
+                histogramTotal += counts[i];
+            }
+            if (histogramTotal > 0) {
+                const Uint64 target = (histogramTotal * 99 + 99) / 100;
+                Uint64 cumulated = 0;
+                for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+                    cumulated += counts[i];
+                    if (cumulated >= target) {
+                        result.p99RenderUs = static_cast<double>((i + 1) * HISTOGRAM_BUCKET_US);
+                        break;
+                    }
+                }
+                result.p99RenderUs = std::min(result.p99RenderUs, result.maxRenderUs);
+            }
+            return result;
+        }
+
+        void AudioMetrics::reset() {
+            callbackCount_.store(0, std::memory_order_relaxed);
+            xrunCount_.store(0, std::memory_order_relaxed);
+            totalRenderNs_.store(0, std::memory_order_relaxed);
+            totalBudgetNs_.store(0, std::memory_order_relaxed);
+            lastRenderNs_.store(0, std::memory_order_relaxed);
+            lastBudgetNs_.store(0, std::memory_order_relaxed);
+            maxRenderNs_.store(0, std::memory_order_relaxed);
+            activeVoices_.store(0, std::memory_order_relaxed);
+            peakVoices_.store(0, std::memory_order_relaxed);
+            inputNoteCount_.store(0, std::memory_order_relaxed);
+            totalInputLatencyNs_.store(0, std::memory_order_relaxed);
+            lastInputLatencyNs_.store(0, std::memory_order_relaxed);
+            maxInputLatencyNs_.store(0, std::memory_order_relaxed);
+            for (std::atomic<Uint32> &bucket: histogram_) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
@@ -0,0 +1,154 @@
+#include "../../include/Audio/CompiledScore.h"
+#include "../../include/Audio/ScoreTextParser.h"
+#include "../../include/Audio/Synthesizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <SDL3/SDL_endian.h>
+
+namespace MusicApp {
+    namespace Audio {
+
+        namespace {
+            const char MAGIC[4] = {'M', 'L', 'S', 'C'};
+        }
+
+        constexpr Uint16 CompiledScore::VERSION;
+
+        bool CompiledScore::open(const std::string &filePath) {
+            close();
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            std::cerr << "CompiledScore: Compiled scores are little-endian and cannot be mapped on this platform."
+                      << std::endl;
+            return false;
+#else
+            if (!file_.open(filePath)) {
+                return false;
+            }
+
+            if (file_.size() < sizeof(Header)) {
+                std::cerr << "CompiledScore: " << filePath << " is too small to be a compiled score." << std::endl;
+                close();
+                return false;
+            }
+
+            const Header *header = reinterpret_cast<const Header *>(file_.data());
+            if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+                header->recordSize != sizeof(ScoreEventRecord)) {
+                std::cerr << "CompiledScore: " << filePath << " is not a version " << VERSION << " compiled score."
+                          << std::endl;
+                close();
+                return false;
+            }
+            if (header->sampleRate != Synthesizer::SAMPLE_RATE) {
+                std::cerr << "CompiledScore: " << filePath << " was compiled at " << header->sampleRate
+                          << " Hz, expected " << Synthesizer::SAMPLE_RATE << " Hz." << std::endl;
+                close();
+                return false;
+            }
+            if ((file_.size() - sizeof(Header)) / sizeof(ScoreEventRecord) < header->eventCount) {
+                std::cerr << "CompiledScore: " << filePath << " is truncated (" << header->eventCount
+                          << " events declared)." << std::endl;
+                close();
+                return false;
+            }
+
+            header_ = header;
+            events_ = reinterpret_cast<const ScoreEventRecord *>(file_.data() + sizeof(Header));
+            return true;
+#endif
+        }
+
+        void CompiledScore::close() {
+            header_ = nullptr;
+            events_ = nullptr;
+            file_.close();
+        }
+
+        std::vector<ScoreEventRecord> CompiledScore::fromMusicalEvents(const std::vector<MusicalEvent> &events,
+                                                                       Uint64 &lengthFrames) {
+            std::vector<ScoreEventRecord> records;
+            records.reserve(events.size());
+
+            // Les positions sont cumulées en secondes puis arrondies : pas d'erreur d'arrondi accumulée
+            const double sampleRate = Synthesizer::SAMPLE_RATE;
+            double elapsedSeconds = 0.0;
+            for (const MusicalEvent &event: events) {
+                const Uint64 startFrame = static_cast<Uint64>(std::llround(elapsedSeconds * sampleRate));
+                elapsedSeconds += std::max(0.0f, event.durationSeconds);
+                const Uint64 endFrame = static_cast<Uint64>(std::llround(elapsedSeconds * sampleRate));
+
+                if (event.pitchName == "0" || event.pitchName.empty()) {
+                    continue; // Silence
+                }
+                const int midiNumber = Core::Note::parse(event.pitchName);
+                if (midiNumber == Core::Note::INVALID) {
+                    std::cerr << "CompiledScore: Skipping unknown note '" << event.pitchName << "'." << std::endl;
+                    continue;
+                }
+
+                ScoreEventRecord record;
+                record.onsetFrame = static_cast<Uint32>(startFrame);
+                record.durationFrames = static_cast<Uint32>(endFrame - startFrame);
+                record.midiNumber = static_cast<Uint8>(midiNumber);
+                record.velocity = 127; // Default velocity, as SongPlayer
+                record.channel = 0;
+                record.reserved = 0;
+                records.push_back(record);
+            }
+            lengthFrames = static_cast<Uint64>(std::llround(elapsedSeconds * sampleRate));
+            return records;
+        }
+
+        bool CompiledScore::write(const std::string &filePath, std::vector<ScoreEventRecord> events,
+                                  Uint64 lengthFrames) {
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            std::cerr << "CompiledScore: Compiled scores can only be written on little-endian platforms." << std::endl;
+            return false;
+#else
+            std::stable_sort(events.begin(), events.end(), [](const ScoreEventRecord &a, const ScoreEventRecord &b) {
+                return a.onsetFrame < b.onsetFrame;
+            });
+
+            Header header;
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.recordSize = sizeof(ScoreEventRecord);
+            header.sampleRate = Synthesizer::SAMPLE_RATE;
+            header.eventCount = static_cast<Uint32>(events.size());
+            header.lengthFrames = lengthFrames;
+
+            std::ofstream file(filePath, std::ios::binary);
+            if (!file.is_open()) {
+                std::cerr << "CompiledScore: Could not open '" << filePath << "' for writing." << std::endl;
+                return false;
+            }
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char *>(events.data()),
+                       static_cast<std::streamsize>(events.size() * sizeof(ScoreEventRecord)));
+            if (!file) {
+                std::cerr << "CompiledScore: Failed while writing '" << filePath << "'." << std::endl;
+                return false;
+            }
+            return true;
+#endif
+        }
+
+        bool CompiledScore::convertTextScore(const std::string &textPath, const std::string &binaryPath) {
+            ScoreTextParser::Result parsed = ScoreTextParser::parseFile(textPath);
+            if (!parsed.opened) {
+                return false;
+            }
+            ScoreTextParser::reportErrors(textPath, parsed.errors, parsed.errorCount);
+            if (parsed.events.empty()) {
+                std::cerr << "CompiledScore: No events read from " << textPath << std::endl;
+                return false;
+            }
+            return write(binaryPath, std::move(parsed.events), parsed.lengthFrames);
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
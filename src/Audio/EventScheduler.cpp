@@ -0,0 +1,43 @@
+#include "../../include/Audio/EventScheduler.h"
+#include <algorithm>
+
+namespace MusicApp {
+    namespace Audio {
+
+        constexpr std::size_t EventScheduler::DEFAULT_CAPACITY;
+        constexpr Uint64 EventScheduler::NO_EVENT;
+
+        EventScheduler::EventScheduler(std::size_t capacity)
+                : capacity_(std::max<std::size_t>(1, capacity)), sequence_(0) {
+            heap_.reserve(capacity_);
+        }
+
+        bool EventScheduler::push(const AudioCommand &command) {
+            if (heap_.size() >= capacity_) {
+                return false;
+            }
+            heap_.push_back({command, sequence_++});
+            std::push_heap(heap_.begin(), heap_.end(), later);
+            return true;
+        }
+
+        void EventScheduler::clearSession(SessionId sessionId) {
+            heap_.erase(std::remove_if(heap_.begin(), heap_.end(),
+                                       [sessionId](const Entry &entry) { return entry.command.sessionId == sessionId; }),
+                        heap_.end());
+            // Les numéros de séquence sont conservés : même ordre de sortie qu'avant pour les commandes restantes
+            std::make_heap(heap_.begin(), heap_.end(), later);
+        }
+
+        bool EventScheduler::popDue(Uint64 position, AudioCommand &command) {
+            if (heap_.empty() || heap_.front().command.frame > position) {
+                return false;
+            }
+            std::pop_heap(heap_.begin(), heap_.end(), later);
+            command = heap_.back().command;
+            heap_.pop_back();
+            return true;
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
@@ -0,0 +1,319 @@
+#include "../../include/Audio/MidiFileReader.h"
+#include "../../include/Audio/Synthesizer.h"
+#include "../../include/utils/file_utils.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace MusicApp {
+    namespace Audio {
+
+        namespace {
+            const Uint32 DEFAULT_MICROSECONDS_PER_QUARTER = 500000; // 120 BPM tant qu'aucun tempo n'est donné
+
+            // Lecture gros-boutiste bornée : toute lecture hors du tampon positionne failed
+            struct ByteReader {
+                const unsigned char *pos;
+                const unsigned char *end;
+                bool failed;
+
+                ByteReader(const unsigned char *begin, const unsigned char *finish)
+                        : pos(begin), end(finish), failed(false) {
+                }
+
+                bool atEnd() const { return pos >= end; }
+
+                Uint8 u8() {
+                    if (pos >= end) {
+                        failed = true;
+                        return 0;
+                    }
+                    return *pos++;
+                }
+
+                Uint32 bigEndian(int bytes) {
+                    Uint32 value = 0;
+                    for (int i = 0; i < bytes; ++i) value = (value << 8) | u8();
+                    return value;
+                }
+
+                // Quantité de longueur variable : 7 bits par octet, 4 octets au plus
+                Uint32 variableLength() {
+                    Uint32 value = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        const Uint8 byte = u8();
+                        value = (value << 7) | (byte & 0x7F);
+                        if (!(byte & 0x80)) return value;
+                    }
+                    failed = true;
+                    return value;
+                }
+
+                void skip(Uint32 count) {
+                    if (count > static_cast<std::size_t>(end - pos)) {
+                        failed = true;
+                        pos = end;
+                    } else {
+                        pos += count;
+                    }
+                }
+            };
+
+            struct TempoChange {
+                Uint64 tick;
+                Uint32 microsecondsPerQuarter;
+            };
+
+            struct RawNote {
+                Uint64 onTick;
+                Uint64 offTick;
+                Uint8 midiNumber;
+                Uint8 velocity;
+                Uint8 channel;
+            };
+
+            // Décode une piste ; les notes ouvertes à la fin de la piste s'arrêtent à son dernier tick
+            bool parseTrack(ByteReader track, std::vector<RawNote> &notes, std::vector<TempoChange> &tempos,
+                            Uint64 &endTick, std::size_t &skippedPercussionNotes) {
+                std::vector<std::vector<std::size_t>> pending(16 * 128); // Notes ouvertes par (canal, touche)
+                Uint64 tick = 0;
+                Uint8 runningStatus = 0;
+
+                while (!track.atEnd()) {
+                    tick += track.variableLength();
+                    Uint8 status = track.u8();
+                    if (track.failed) return false;
+
+                    if (status == 0xFF) { // Méta-événement
+                        runningStatus = 0;
+                        const Uint8 type = track.u8();
+                        const Uint32 length = track.variableLength();
+                        if (type == 0x51 && length == 3) {
+                            tempos.push_back({tick, track.bigEndian(3)});
+                        } else {
+                            track.skip(length);
+                        }
+                        if (type == 0x2F) break; // Fin de piste
+                        continue;
+                    }
+                    if (status == 0xF0 || status == 0xF7) { // SysEx : ignoré
+                        runningStatus = 0;
+                        track.skip(track.variableLength());
+                        continue;
+                    }
+
+                    Uint8 data1;
+                    if (status < 0x80) { // Statut courant : l'octet lu est déjà la première donnée
+                        if (runningStatus == 0) return false;
+                        data1 = status;
+                        status = runningStatus;
+                    } else if (status < 0xF0) {
+                        runningStatus = status;
+                        data1 = track.u8();
+                    } else {
+                        return false; // Messages temps réel/système : n'existent pas dans un fichier
+                    }
+
+                    const Uint8 kind = status & 0xF0;
+                    const Uint8 channel = status & 0x0F;
+                    if (kind == 0xC0 || kind == 0xD0) {
+                        continue; // Un seul octet de données
+                    }
+                    const Uint8 data2 = track.u8();
+                    if (track.failed) return false;
+
+                    const bool noteOn = kind == 0x90 && data2 > 0;
+                    const bool noteOff = kind == 0x80 || (kind == 0x90 && data2 == 0);
+                    if (!noteOn && !noteOff) continue;
+                    if (channel == MidiFileReader::PERCUSSION_CHANNEL) {
+                        if (noteOn) ++skippedPercussionNotes;
+                        continue;
+                    }
+
+                    std::vector<std::size_t> &open = pending[channel * 128 + (data1 & 0x7F)];
+                    if (noteOn) {
+                        open.push_back(notes.size());
+                        notes.push_back({tick, tick, static_cast<Uint8>(data1 & 0x7F), data2, channel});
+                    } else if (!open.empty()) {
+                        notes[open.front()].offTick = tick;
+                        open.erase(open.begin());
+                    }
+                }
+                if (track.failed) return false;
+
+                for (const std::vector<std::size_t> &open: pending) {
+                    for (std::size_t index: open) notes[index].offTick = tick;
+                }
+                endTick = std::max(endTick, tick);
+                return true;
+            }
+
+            // Conversion ticks -> trames, par segments de tempo constant
+            class TickClock {
+            public:
+                TickClock(Uint16 division, std::vector<TempoChange> tempos) : division_(division) {
+                    if (division & 0x8000) {
+                        // SMPTE : -images par seconde dans l'octet haut (29 = 29,97), ticks par image dans l'octet bas
+                        const int framesPerSecond = -static_cast<Sint8>(division >> 8);
+                        const double rate = framesPerSecond == 29 ? 30000.0 / 1001.0 : framesPerSecond;
+                        ticksPerSecond_ = rate * (division & 0xFF);
+                        return;
+                    }
+
+                    std::stable_sort(tempos.begin(), tempos.end(), [](const TempoChange &a, const TempoChange &b) {
+                        return a.tick < b.tick;
+                    });
+                    segments_.push_back({0, 0.0, DEFAULT_MICROSECONDS_PER_QUARTER});
+                    for (const TempoChange &change: tempos) {
+                        const Segment &last = segments_.back();
+                        const double start = microsecondsAt(last, change.tick);
+                        if (change.tick == last.tick) {
+                            segments_.back().microsecondsPerQuarter = change.microsecondsPerQuarter;
+                        } else {
+                            segments_.push_back({change.tick, start, change.microsecondsPerQuarter});
+                        }
+                    }
+                }
+
+                bool isValid() const { return (division_ & 0x8000) ? ticksPerSecond_ > 0.0 : division_ > 0; }
+
+                Uint64 frameAt(Uint64 tick) const {
+                    double seconds;
+                    if (division_ & 0x8000) {
+                        seconds = static_cast<double>(tick) / ticksPerSecond_;
+                    } else {
+                        auto next = std::upper_bound(segments_.begin(), segments_.end(), tick,
+                                                     [](Uint64 value, const Segment &s) { return value < s.tick; });
+                        seconds = microsecondsAt(*(next - 1), tick) * 1e-6;
+                    }
+                    return static_cast<Uint64>(std::llround(seconds * Synthesizer::SAMPLE_RATE));
+                }
+
+            private:
+                struct Segment {
+                    Uint64 tick;
+                    double startMicroseconds;
+                    Uint32 microsecondsPerQuarter;
+                };
+
+                double microsecondsAt(const Segment &segment, Uint64 tick) const {
+                    return segment.startMicroseconds + static_cast<double>(tick - segment.tick) *
+                                                       segment.microsecondsPerQuarter / division_;
+                }
+
+                Uint16 division_;
+                double ticksPerSecond_ = 0.0;
+                std::vector<Segment> segments_;
+            };
+        }
+
+        constexpr int MidiFileReader::PERCUSSION_CHANNEL;
+
+        bool MidiFileReader::isMidiPath(const std::string &filePath) {
+            const std::size_t dot = filePath.find_last_of('.');
+            if (dot == std::string::npos) return false;
+            std::string extension = filePath.substr(dot);
+            std::transform(extension.begin(), extension.end(), extension.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return extension == ".mid" || extension == ".midi";
+        }
+
+        bool MidiFileReader::read(const std::string &filePath, Result &result) {
+            MappedFile file;
+            if (!file.open(filePath)) {
+                return false;
+            }
+            return parse(file.data(), file.size(), filePath, result);
+        }
+
+        bool MidiFileReader::parse(const unsigned char *data, std::size_t size, const std::string &sourceName,
+                                   Result &result) {
+            result = Result();
+            ByteReader reader(data, data + size);
+
+            if (size < 14 || std::memcmp(data, "MThd", 4) != 0) {
+                std::cerr << "MidiFileReader: " << sourceName << " is not a Standard MIDI File." << std::endl;
+                return false;
+            }
+            reader.skip(4);
+            const Uint32 headerLength = reader.bigEndian(4);
+            result.format = static_cast<Uint16>(reader.bigEndian(2));
+            const Uint16 declaredTracks = static_cast<Uint16>(reader.bigEndian(2));
+            const Uint16 division = static_cast<Uint16>(reader.bigEndian(2));
+            if (headerLength < 6) {
+                std::cerr << "MidiFileReader: " << sourceName << " has a malformed header." << std::endl;
+                return false;
+            }
+            reader.skip(headerLength - 6);
+            if (result.format > 1) {
+                std::cerr << "MidiFileReader: " << sourceName << " is a format " << result.format
+                          << " file; only formats 0 and 1 are supported." << std::endl;
+                return false;
+            }
+
+            std::vector<RawNote> notes;
+            std::vector<TempoChange> tempos;
+            Uint64 endTick = 0;
+            while (result.trackCount < declaredTracks && !reader.atEnd()) {
+                const bool isTrack = reader.end - reader.pos >= 4 && std::memcmp(reader.pos, "MTrk", 4) == 0;
+                reader.skip(4);
+                const Uint32 chunkLength = reader.bigEndian(4);
+                if (reader.failed || chunkLength > static_cast<std::size_t>(reader.end - reader.pos)) {
+                    std::cerr << "MidiFileReader: " << sourceName << " is truncated." << std::endl;
+                    return false;
+                }
+                if (!isTrack) {
+                    reader.skip(chunkLength); // Morceaux inconnus : à ignorer selon la norme
+                    continue;
+                }
+                if (!parseTrack(ByteReader(reader.pos, reader.pos + chunkLength), notes, tempos, endTick,
+                                result.skippedPercussionNotes)) {
+                    std::cerr << "MidiFileReader: Track " << result.trackCount << " of " << sourceName
+                              << " is malformed." << std::endl;
+                    return false;
+                }
+                reader.skip(chunkLength);
+                ++result.trackCount;
+            }
+
+            const TickClock clock(division, tempos);
+            if (!clock.isValid()) {
+                std::cerr << "MidiFileReader: " << sourceName << " has an invalid time division." << std::endl;
+                return false;
+            }
+            result.tempoChangeCount = tempos.size();
+
+            result.events.reserve(notes.size());
+            for (const RawNote &note: notes) {
+                const Uint64 onsetFrame = clock.frameAt(note.onTick);
+                ScoreEventRecord record;
+                record.onsetFrame = static_cast<Uint32>(onsetFrame);
+                record.durationFrames = static_cast<Uint32>(clock.frameAt(note.offTick) - onsetFrame);
+                record.midiNumber = note.midiNumber;
+                record.velocity = note.velocity;
+                record.channel = note.channel;
+                record.reserved = 0;
+                result.events.push_back(record);
+            }
+            // Les pistes sont fusionnées ici ; à onset égal, l'ordre du fichier est conservé
+            std::stable_sort(result.events.begin(), result.events.end(),
+                             [](const ScoreEventRecord &a, const ScoreEventRecord &b) {
+                                 return a.onsetFrame < b.onsetFrame;
+                             });
+            result.lengthFrames = clock.frameAt(endTick);
+
+            if (result.skippedPercussionNotes > 0) {
+                std::cout << "MidiFileReader: Skipped " << result.skippedPercussionNotes
+                          << " percussion notes (channel 10) in " << sourceName << "." << std::endl;
+            }
+            if (result.events.empty()) {
+                std::cerr << "MidiFileReader: " << sourceName << " contains no playable notes." << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
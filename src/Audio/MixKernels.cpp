@@ -0,0 +1,336 @@
+#include "../../include/Audio/MixKernels.h"
+#include "../../include/Audio/Wavetable.h"
+#include <SDL3/SDL_cpuinfo.h>
+#include <SDL3/SDL_intrin.h>
+
+namespace MusicApp {
+    namespace Audio {
+        namespace MixKernels {
+
+            namespace {
+                using ApplyEnvelopeFn = void (*)(float *, const float *, float, int);
+                using RenderWavetableFn = void (*)(WavetableBlock &, float *, int, bool);
+                using AccumulateStereoFn = void (*)(float *, const float *, float, float, int);
+
+                // Queues de bloc (et processeurs sans SIMD)
+                void applyEnvelopeScalar(float *voice, const float *envelope, float gain, int frames) {
+                    for (int i = 0; i < frames; ++i) {
+                        voice[i] = envelope[i] > ENVELOPE_GATE ? voice[i] * envelope[i] * gain : 0.0f;
+                    }
+                }
+
+                void accumulateStereoScalar(float *bus, const float *mono, float leftGain, float rightGain,
+                                            int frames) {
+                    for (int i = 0; i < frames; ++i) {
+                        bus[2 * i] += mono[i] * leftGain;
+                        bus[2 * i + 1] += mono[i] * rightGain;
+                    }
+                }
+
+                template<int Layers, bool Accumulate>
+                void renderWavetableLayers(WavetableBlock &block, float *out, int frames) {
+                    float weights[Layers];
+                    for (int layer = 0; layer < Layers; ++layer) weights[layer] = block.weights[layer];
+                    Uint32 phase = block.phase;
+                    float level = block.level;
+                    for (int i = 0; i < frames; ++i) {
+                        float layers[Layers];
+                        Wavetable::read<Layers>(block.mip, phase, layers);
+                        float value = 0.0f;
+                        for (int layer = 0; layer < Layers; ++layer) value += layers[layer] * weights[layer];
+                        value *= level;
+                        out[i] = Accumulate ? out[i] + value : value;
+                        phase += block.increment;
+                        level *= block.levelDecay;
+                    }
+                    block.phase = phase;
+                    block.level = level;
+                }
+
+                template<bool Accumulate>
+                void renderWavetableScalar(WavetableBlock &block, float *out, int frames) {
+                    switch (block.layers) {
+                        case 1:
+                            renderWavetableLayers<1, Accumulate>(block, out, frames);
+                            break;
+                        case 2:
+                            renderWavetableLayers<2, Accumulate>(block, out, frames);
+                            break;
+                        case 3:
+                            renderWavetableLayers<3, Accumulate>(block, out, frames);
+                            break;
+                        case 4:
+                            renderWavetableLayers<4, Accumulate>(block, out, frames);
+                            break;
+                        default:
+                            break;
+                    }
+                }
+
+                void renderWavetableScalar(WavetableBlock &block, float *out, int frames, bool accumulate) {
+                    if (accumulate) {
+                        renderWavetableScalar<true>(block, out, frames);
+                    } else {
+                        renderWavetableScalar<false>(block, out, frames);
+                    }
+                }
+
+                // Gains des lanes d'un vecteur (level, level * decay, ...) ; renvoie le pas d'un vecteur au suivant
+                float laneLevels(const WavetableBlock &block, float *levels, int lanes) {
+                    float level = block.level;
+                    float step = 1.0f;
+                    for (int lane = 0; lane < lanes; ++lane) {
+                        levels[lane] = level;
+                        level *= block.levelDecay;
+                        step *= block.levelDecay;
+                    }
+                    return step;
+                }
+
+#ifdef SDL_SSE2_INTRINSICS
+                void SDL_TARGETING("sse2") applyEnvelopeSSE2(float *voice, const float *envelope, float gain,
+                                                              int frames) {
+                    const __m128 gainVector = _mm_set1_ps(gain);
+                    const __m128 gate = _mm_set1_ps(ENVELOPE_GATE);
+                    int i = 0;
+                    for (; i + 4 <= frames; i += 4) {
+                        const __m128 level = _mm_loadu_ps(envelope + i);
+                        __m128 value = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(voice + i), level), gainVector);
+                        value = _mm_and_ps(value, _mm_cmpgt_ps(level, gate));
+                        _mm_storeu_ps(voice + i, value);
+                    }
+                    applyEnvelopeScalar(voice + i, envelope + i, gain, frames - i);
+                }
+
+                void SDL_TARGETING("sse2") accumulateStereoSSE2(float *bus, const float *mono, float leftGain,
+                                                                 float rightGain, int frames) {
+                    const __m128 gains = _mm_setr_ps(leftGain, rightGain, leftGain, rightGain);
+                    int i = 0;
+                    for (; i + 4 <= frames; i += 4) {
+                        const __m128 samples = _mm_loadu_ps(mono + i);
+                        // m0 m0 m1 m1 et m2 m2 m3 m3 : une trame stéréo par paire
+                        const __m128 low = _mm_unpacklo_ps(samples, samples);
+                        const __m128 high = _mm_unpackhi_ps(samples, samples);
+                        float *out = bus + 2 * i;
+                        _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(low, gains)));
+                        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(high, gains)));
+                    }
+                    accumulateStereoScalar(bus + 2 * i, mono + i, leftGain, rightGain, frames - i);
+                }
+
+                // Phases, fractions, interpolation et pondération sur 4 échantillons ; sans gather en SSE2,
+                // les points de la table sont chargés un par un
+                void SDL_TARGETING("sse2") renderWavetableSSE2(WavetableBlock &block, float *out, int frames,
+                                                                bool accumulate) {
+                    const int layers = block.layers;
+                    if (layers < 1 || layers > 4) return;
+                    __m128 weights[4];
+                    for (int layer = 0; layer < layers; ++layer) weights[layer] = _mm_set1_ps(block.weights[layer]);
+
+                    const Uint32 increment = block.increment;
+                    __m128i phases = _mm_setr_epi32(static_cast<int>(block.phase),
+                                                    static_cast<int>(block.phase + increment),
+                                                    static_cast<int>(block.phase + increment * 2),
+                                                    static_cast<int>(block.phase + increment * 3));
+                    const __m128i phaseStep = _mm_set1_epi32(static_cast<int>(increment * 4));
+                    const __m128i fractionMask = _mm_set1_epi32(static_cast<int>(Wavetable::FRACTION_MASK));
+                    const __m128 fractionScale = _mm_set1_ps(Wavetable::FRACTION_SCALE);
+                    float levels[4];
+                    const __m128 levelStep = _mm_set1_ps(laneLevels(block, levels, 4));
+                    __m128 levelVector = _mm_loadu_ps(levels);
+
+                    int i = 0;
+                    for (; i + 4 <= frames; i += 4) {
+                        int indices[4];
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(indices),
+                                         _mm_srli_epi32(phases, Wavetable::FRACTION_BITS));
+                        const __m128 fraction = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(phases, fractionMask)),
+                                                           fractionScale);
+                        const float *row0 = block.mip + indices[0] * layers;
+                        const float *row1 = block.mip + indices[1] * layers;
+                        const float *row2 = block.mip + indices[2] * layers;
+                        const float *row3 = block.mip + indices[3] * layers;
+
+                        __m128 value = _mm_setzero_ps();
+                        for (int layer = 0; layer < layers; ++layer) {
+                            const __m128 start = _mm_setr_ps(row0[layer], row1[layer], row2[layer], row3[layer]);
+                            const __m128 end = _mm_setr_ps(row0[layers + layer], row1[layers + layer],
+                                                           row2[layers + layer], row3[layers + layer]);
+                            const __m128 sample = _mm_add_ps(start, _mm_mul_ps(_mm_sub_ps(end, start), fraction));
+                            value = _mm_add_ps(value, _mm_mul_ps(sample, weights[layer]));
+                        }
+                        value = _mm_mul_ps(value, levelVector);
+                        if (accumulate) value = _mm_add_ps(value, _mm_loadu_ps(out + i));
+                        _mm_storeu_ps(out + i, value);
+
+                        phases = _mm_add_epi32(phases, phaseStep);
+                        levelVector = _mm_mul_ps(levelVector, levelStep);
+                    }
+                    block.phase += increment * static_cast<Uint32>(i);
+                    block.level = _mm_cvtss_f32(levelVector);
+                    renderWavetableScalar(block, out + i, frames - i, accumulate);
+                }
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+                void SDL_TARGETING("avx2") applyEnvelopeAVX2(float *voice, const float *envelope, float gain,
+                                                              int frames) {
+                    const __m256 gainVector = _mm256_set1_ps(gain);
+                    const __m256 gate = _mm256_set1_ps(ENVELOPE_GATE);
+                    int i = 0;
+                    for (; i + 8 <= frames; i += 8) {
+                        const __m256 level = _mm256_loadu_ps(envelope + i);
+                        __m256 value = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(voice + i), level), gainVector);
+                        value = _mm256_and_ps(value, _mm256_cmp_ps(level, gate, _CMP_GT_OQ));
+                        _mm256_storeu_ps(voice + i, value);
+                    }
+                    applyEnvelopeScalar(voice + i, envelope + i, gain, frames - i);
+                }
+
+                void SDL_TARGETING("avx2") accumulateStereoAVX2(float *bus, const float *mono, float leftGain,
+                                                                 float rightGain, int frames) {
+                    const __m256 gains = _mm256_setr_ps(leftGain, rightGain, leftGain, rightGain,
+                                                        leftGain, rightGain, leftGain, rightGain);
+                    // Duplication de chaque échantillon à travers les deux moitiés du registre
+                    const __m256i lowIndices = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+                    const __m256i highIndices = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+                    int i = 0;
+                    for (; i + 8 <= frames; i += 8) {
+                        const __m256 samples = _mm256_loadu_ps(mono + i);
+                        const __m256 low = _mm256_permutevar8x32_ps(samples, lowIndices);
+                        const __m256 high = _mm256_permutevar8x32_ps(samples, highIndices);
+                        float *out = bus + 2 * i;
+                        _mm256_storeu_ps(out, _mm256_add_ps(_mm256_loadu_ps(out), _mm256_mul_ps(low, gains)));
+                        _mm256_storeu_ps(out + 8,
+                                         _mm256_add_ps(_mm256_loadu_ps(out + 8), _mm256_mul_ps(high, gains)));
+                    }
+                    accumulateStereoScalar(bus + 2 * i, mono + i, leftGain, rightGain, frames - i);
+                }
+
+                // 8 échantillons par itération, points de la table lus avec _mm256_i32gather_ps
+                void SDL_TARGETING("avx2") renderWavetableAVX2(WavetableBlock &block, float *out, int frames,
+                                                                bool accumulate) {
+                    const int layers = block.layers;
+                    if (layers < 1 || layers > 4) return;
+                    __m256 weights[4];
+                    for (int layer = 0; layer < layers; ++layer) weights[layer] = _mm256_set1_ps(block.weights[layer]);
+
+                    const Uint32 increment = block.increment;
+                    __m256i phases = _mm256_add_epi32(
+                            _mm256_set1_epi32(static_cast<int>(block.phase)),
+                            _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                               _mm256_set1_epi32(static_cast<int>(increment))));
+                    const __m256i phaseStep = _mm256_set1_epi32(static_cast<int>(increment * 8));
+                    const __m256i fractionMask = _mm256_set1_epi32(static_cast<int>(Wavetable::FRACTION_MASK));
+                    const __m256 fractionScale = _mm256_set1_ps(Wavetable::FRACTION_SCALE);
+                    const __m256i rowStride = _mm256_set1_epi32(layers);
+                    float levels[8];
+                    const __m256 levelStep = _mm256_set1_ps(laneLevels(block, levels, 8));
+                    __m256 levelVector = _mm256_loadu_ps(levels);
+
+                    int i = 0;
+                    for (; i + 8 <= frames; i += 8) {
+                        const __m256i rows = _mm256_mullo_epi32(_mm256_srli_epi32(phases, Wavetable::FRACTION_BITS),
+                                                                rowStride);
+                        const __m256 fraction = _mm256_mul_ps(
+                                _mm256_cvtepi32_ps(_mm256_and_si256(phases, fractionMask)), fractionScale);
+
+                        __m256 value = _mm256_setzero_ps();
+                        for (int layer = 0; layer < layers; ++layer) {
+                            const __m256 start = _mm256_i32gather_ps(block.mip + layer, rows, 4);
+                            const __m256 end = _mm256_i32gather_ps(block.mip + layers + layer, rows, 4);
+                            const __m256 sample = _mm256_add_ps(start, _mm256_mul_ps(_mm256_sub_ps(end, start),
+                                                                                     fraction));
+                            value = _mm256_add_ps(value, _mm256_mul_ps(sample, weights[layer]));
+                        }
+                        value = _mm256_mul_ps(value, levelVector);
+                        if (accumulate) value = _mm256_add_ps(value, _mm256_loadu_ps(out + i));
+                        _mm256_storeu_ps(out + i, value);
+
+                        phases = _mm256_add_epi32(phases, phaseStep);
+                        levelVector = _mm256_mul_ps(levelVector, levelStep);
+                    }
+                    block.phase += increment * static_cast<Uint32>(i);
+                    block.level = _mm256_cvtss_f32(levelVector);
+                    renderWavetableScalar(block, out + i, frames - i, accumulate);
+                }
+#endif
+
+                struct KernelTable {
+                    InstructionSet instructionSet;
+                    ApplyEnvelopeFn applyEnvelope;
+                    RenderWavetableFn renderWavetable;
+                    AccumulateStereoFn accumulateStereo;
+                };
+
+                KernelTable kernelsFor(InstructionSet instructionSet) {
+                    switch (instructionSet) {
+#ifdef SDL_AVX2_INTRINSICS
+                        case InstructionSet::AVX2:
+                            if (SDL_HasAVX2()) {
+                                return {InstructionSet::AVX2, applyEnvelopeAVX2, renderWavetableAVX2, accumulateStereoAVX2};
+                            }
+                            break;
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+                        case InstructionSet::SSE2:
+                            if (SDL_HasSSE2()) {
+                                return {InstructionSet::SSE2, applyEnvelopeSSE2, renderWavetableSSE2, accumulateStereoSSE2};
+                            }
+                            break;
+#endif
+                        default:
+                            break;
+                    }
+                    return {InstructionSet::Scalar, applyEnvelopeScalar, renderWavetableScalar, accumulateStereoScalar};
+                }
+
+                KernelTable kernels = {InstructionSet::Scalar, applyEnvelopeScalar, renderWavetableScalar, accumulateStereoScalar};
+                bool prepared = false;
+            }
+
+            void prepare() {
+                if (prepared) return;
+                prepared = true;
+
+                kernels = kernelsFor(InstructionSet::AVX2);
+                if (kernels.instructionSet == InstructionSet::Scalar) {
+                    kernels = kernelsFor(InstructionSet::SSE2);
+                }
+            }
+
+            InstructionSet activeInstructionSet() {
+                return kernels.instructionSet;
+            }
+
+            const char *instructionSetName(InstructionSet instructionSet) {
+                switch (instructionSet) {
+                    case InstructionSet::AVX2:
+                        return "AVX2";
+                    case InstructionSet::SSE2:
+                        return "SSE2";
+                    default:
+                        return "scalar";
+                }
+            }
+
+            void forceInstructionSet(InstructionSet instructionSet) {
+                prepared = true;
+                kernels = kernelsFor(instructionSet);
+            }
+
+            void applyEnvelope(float *voice, const float *envelope, float gain, int frames) {
+                kernels.applyEnvelope(voice, envelope, gain, frames);
+            }
+
+            void renderWavetable(WavetableBlock &block, float *out, int frames, bool accumulate) {
+                kernels.renderWavetable(block, out, frames, accumulate);
+            }
+
+            void accumulateStereo(float *bus, const float *mono, float leftGain, float rightGain, int frames) {
+                kernels.accumulateStereo(bus, mono, leftGain, rightGain, frames);
+            }
+
+        } // namespace MixKernels
+    } // namespace Audio
+} // namespace MusicApp
@@ -0,0 +1,208 @@
+#include "../../include/Audio/OfflineRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace MusicApp {
+    namespace Audio {
+
+        namespace {
+            void writeLittleEndian(std::ofstream &file, Uint32 value, int bytes) {
+                for (int i = 0; i < bytes; ++i) {
+                    file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+                }
+            }
+
+            void writeSamples(std::ofstream &file, const std::vector<int16_t> &samples) {
+                for (int16_t sample: samples) {
+                    writeLittleEndian(file, static_cast<Uint16>(sample), 2);
+                }
+            }
+        }
+
+        constexpr int OfflineRenderer::CHANNELS;
+
+        OfflineRenderer::OfflineRenderer(std::size_t polyphony)
+                : polyphony_(polyphony), tailSeconds_(1.0f), blockFrames_(512), ditherEnabled_(true),
+                  tuning_(Tunings::equalTemperament()) {
+        }
+
+        std::vector<int16_t> OfflineRenderer::render(const std::vector<MusicalEvent> &events,
+                                                     const std::string &instrumentName) {
+            Uint64 lengthFrames = 0;
+            const std::vector<ScoreEventRecord> records = CompiledScore::fromMusicalEvents(events, lengthFrames);
+            return render(records.data(), records.size(), lengthFrames, instrumentName);
+        }
+
+        std::vector<int16_t> OfflineRenderer::render(const ScoreEventRecord *events, std::size_t eventCount,
+                                                     Uint64 lengthFrames, const std::string &instrumentName) {
+            return render(Model::Score::fromRecords(events, eventCount, lengthFrames,
+                                                    Synthesizer::instrumentIdForName(instrumentName)));
+        }
+
+        std::vector<int16_t> OfflineRenderer::render(const Model::Score &score) {
+            std::vector<int16_t> output;
+
+            // Chaque note donne un note-on et un note-off à la trame près : même placement que SongPlayer
+            std::vector<ScheduledCommand> schedule;
+            schedule.reserve(score.size() * 2);
+            for (std::size_t i = 0; i < score.size(); ++i) {
+                const float frequency = tuning_.frequency(score.midiNumber(i));
+                if (frequency <= 0.0f) {
+                    continue;
+                }
+
+                ScheduledCommand noteOn;
+                noteOn.frame = score.onsetFrame(i);
+                noteOn.command.type = AudioCommand::Type::NoteOn;
+                noteOn.command.instrumentId = score.instrument(i);
+                noteOn.command.pitchId = score.midiNumber(i);
+                noteOn.command.frequency = frequency;
+                noteOn.command.velocity = std::max(0.1f, score.velocity(i) / 127.0f);
+                schedule.push_back(noteOn);
+
+                ScheduledCommand noteOff = noteOn;
+                noteOff.frame = score.endFrame(i);
+                noteOff.command.type = AudioCommand::Type::NoteOff;
+                schedule.push_back(noteOff);
+            }
+
+            if (schedule.empty()) {
+                std::cerr << "OfflineRenderer: No playable events to render." << std::endl;
+                return output;
+            }
+
+            // Un note-off tombe sur la même trame que la note suivante : il doit passer avant elle
+            std::stable_sort(schedule.begin(), schedule.end(),
+                             [](const ScheduledCommand &a, const ScheduledCommand &b) { return a.frame < b.frame; });
+
+            const Uint64 songEndFrame = score.lengthFrames();
+            const Uint64 tailEndFrame = songEndFrame + static_cast<Uint64>(tailSeconds_ * Synthesizer::SAMPLE_RATE);
+            output.reserve(static_cast<std::size_t>(tailEndFrame) * CHANNELS);
+
+            Synthesizer synthesizer(polyphony_);
+            synthesizer.setMaxBlockFrames(blockFrames_);
+            synthesizer.getOutputStage().setDitherEnabled(ditherEnabled_);
+            std::vector<int16_t> block(static_cast<std::size_t>(blockFrames_) * CHANNELS);
+
+            Uint64 frame = 0;
+            std::size_t nextCommand = 0;
+            while (true) {
+                while (nextCommand < schedule.size() && schedule[nextCommand].frame <= frame) {
+                    synthesizer.applyCommand(schedule[nextCommand].command);
+                    ++nextCommand;
+                }
+
+                if (nextCommand == schedule.size() && frame >= songEndFrame &&
+                    (synthesizer.getActiveVoiceCount() == 0 || frame >= tailEndFrame)) {
+                    break;
+                }
+
+                // Le bloc s'arrête au prochain événement pour que celui-ci tombe exactement sur sa trame
+                const Uint64 boundary = nextCommand < schedule.size() ? schedule[nextCommand].frame : tailEndFrame;
+                const int blockFrames = static_cast<int>(std::min<Uint64>(blockFrames_, boundary - frame));
+
+                const float *bus = synthesizer.renderBlock(blockFrames);
+                const std::size_t blockSamples = static_cast<std::size_t>(blockFrames) * CHANNELS;
+                synthesizer.getOutputStage().convertToS16(bus, block.data(), blockSamples);
+                output.insert(output.end(), block.begin(), block.begin() + blockSamples);
+                frame += static_cast<Uint64>(blockFrames);
+            }
+
+            return output;
+        }
+
+        bool OfflineRenderer::renderToFile(const std::vector<MusicalEvent> &events, const std::string &instrumentName,
+                                           const std::string &filePath, FileFormat format) {
+            const Uint64 startTicks = SDL_GetTicks();
+            return writeRendered(render(events, instrumentName), filePath, format, startTicks);
+        }
+
+        bool OfflineRenderer::renderToFile(const CompiledScore &score, const std::string &instrumentName,
+                                           const std::string &filePath, FileFormat format) {
+            return renderToFile(score.events(), score.eventCount(), score.lengthFrames(), instrumentName, filePath,
+                                format);
+        }
+
+        bool OfflineRenderer::renderToFile(const ScoreEventRecord *events, std::size_t eventCount, Uint64 lengthFrames,
+                                           const std::string &instrumentName, const std::string &filePath,
+                                           FileFormat format) {
+            const Uint64 startTicks = SDL_GetTicks();
+            return writeRendered(render(events, eventCount, lengthFrames, instrumentName), filePath, format,
+                                 startTicks);
+        }
+
+        bool OfflineRenderer::renderToFile(const Model::Score &score, const std::string &filePath, FileFormat format) {
+            const Uint64 startTicks = SDL_GetTicks();
+            return writeRendered(render(score), filePath, format, startTicks);
+        }
+
+        bool OfflineRenderer::writeRendered(const std::vector<int16_t> &samples, const std::string &filePath,
+                                            FileFormat format, Uint64 startTicks) {
+            if (samples.empty()) {
+                return false;
+            }
+
+            const bool written = format == FileFormat::Wav ? writeWavFile(filePath, samples)
+                                                           : writeRawPcmFile(filePath, samples);
+            if (written) {
+                const double audioSeconds = static_cast<double>(samples.size() / CHANNELS) / Synthesizer::SAMPLE_RATE;
+                std::cout << "OfflineRenderer: Rendered " << audioSeconds << " s of audio to '" << filePath << "' in "
+                          << (SDL_GetTicks() - startTicks) << " ms." << std::endl;
+            }
+            return written;
+        }
+
+        bool OfflineRenderer::writeWavFile(const std::string &filePath, const std::vector<int16_t> &samples) {
+            std::ofstream file(filePath, std::ios::binary);
+            if (!file.is_open()) {
+                std::cerr << "OfflineRenderer: Could not open '" << filePath << "' for writing." << std::endl;
+                return false;
+            }
+
+            const Uint32 bytesPerSample = sizeof(int16_t);
+            const Uint32 dataBytes = static_cast<Uint32>(samples.size() * bytesPerSample);
+
+            file.write("RIFF", 4);
+            writeLittleEndian(file, 36 + dataBytes, 4);
+            file.write("WAVE", 4);
+
+            file.write("fmt ", 4);
+            writeLittleEndian(file, 16, 4);                                  // Taille du bloc fmt
+            writeLittleEndian(file, 1, 2);                                   // PCM
+            writeLittleEndian(file, CHANNELS, 2);
+            writeLittleEndian(file, Synthesizer::SAMPLE_RATE, 4);
+            writeLittleEndian(file, Synthesizer::SAMPLE_RATE * CHANNELS * bytesPerSample, 4); // Octets par seconde
+            writeLittleEndian(file, CHANNELS * bytesPerSample, 2);          // Octets par trame
+            writeLittleEndian(file, 8 * bytesPerSample, 2);                 // Bits par échantillon
+
+            file.write("data", 4);
+            writeLittleEndian(file, dataBytes, 4);
+            writeSamples(file, samples);
+
+            if (!file) {
+                std::cerr << "OfflineRenderer: Failed while writing '" << filePath << "'." << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        bool OfflineRenderer::writeRawPcmFile(const std::string &filePath, const std::vector<int16_t> &samples) {
+            std::ofstream file(filePath, std::ios::binary);
+            if (!file.is_open()) {
+                std::cerr << "OfflineRenderer: Could not open '" << filePath << "' for writing." << std::endl;
+                return false;
+            }
+
+            writeSamples(file, samples);
+
+            if (!file) {
+                std::cerr << "OfflineRenderer: Failed while writing '" << filePath << "'." << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
@@ -0,0 +1,44 @@
+#include "../../include/Audio/OutputStage.h"
+#include <cmath>
+
+namespace MusicApp {
+    namespace Audio {
+
+        OutputStage::OutputStage() : ditherEnabled_(true), rngState_(0x9E3779B9u) {
+        }
+
+        void OutputStage::softClip(float *samples, std::size_t numSamples) const {
+            const float headroom = 1.0f - SOFT_CLIP_KNEE;
+            for (std::size_t i = 0; i < numSamples; ++i) {
+                float magnitude = std::fabs(samples[i]);
+                if (magnitude > SOFT_CLIP_KNEE) {
+                    // Au-dessus du genou, tanh rapproche le signal de ±1 sans jamais le dépasser
+                    float clipped = SOFT_CLIP_KNEE + headroom * std::tanh((magnitude - SOFT_CLIP_KNEE) / headroom);
+                    samples[i] = samples[i] < 0.0f ? -clipped : clipped;
+                }
+            }
+        }
+
+        float OutputStage::nextUniform() {
+            rngState_ ^= rngState_ << 13;
+            rngState_ ^= rngState_ >> 17;
+            rngState_ ^= rngState_ << 5;
+            return static_cast<float>(rngState_) * (1.0f / 4294967296.0f);
+        }
+
+        void OutputStage::convertToS16(const float *samples, int16_t *output, std::size_t numSamples) {
+            for (std::size_t i = 0; i < numSamples; ++i) {
+                float value = samples[i] * 32767.0f;
+                if (ditherEnabled_) {
+                    // TPDF : différence de deux variables uniformes, amplitude ±1 LSB
+                    value += nextUniform() - nextUniform();
+                }
+                value = std::floor(value + 0.5f);
+                if (value > 32767.0f) value = 32767.0f;
+                if (value < -32768.0f) value = -32768.0f;
+                output[i] = static_cast<int16_t>(value);
+            }
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
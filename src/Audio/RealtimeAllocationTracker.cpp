@@ -0,0 +1,85 @@
+#include "../../include/Audio/RealtimeAllocationTracker.h"
+#include <SDL3/SDL_assert.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local bool inRealtimeScope = false;
+    std::atomic<Uint64> realtimeAllocations{0};
+
+#ifdef MUSICALAU_AUDIO_ALLOC_CHECK
+    void *trackedAllocate(std::size_t size) noexcept {
+        if (inRealtimeScope) {
+            realtimeAllocations.fetch_add(1, std::memory_order_relaxed);
+            // Éviter de recompter les allocations éventuelles du gestionnaire d'assertion
+            inRealtimeScope = false;
+            SDL_assert(!"Heap allocation on the audio thread");
+            inRealtimeScope = true;
+        }
+        return std::malloc(size == 0 ? 1 : size);
+    }
+#endif
+}
+
+namespace MusicApp {
+    namespace Audio {
+        namespace RealtimeAllocationTracker {
+
+            Scope::Scope() : previous_(inRealtimeScope) {
+                inRealtimeScope = true;
+            }
+
+            Scope::~Scope() {
+                inRealtimeScope = previous_;
+            }
+
+            bool isEnabled() {
+#ifdef MUSICALAU_AUDIO_ALLOC_CHECK
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            Uint64 allocationCount() {
+                return realtimeAllocations.load(std::memory_order_relaxed);
+            }
+
+        } // namespace RealtimeAllocationTracker
+    } // namespace Audio
+} // namespace MusicApp
+
+#ifdef MUSICALAU_AUDIO_ALLOC_CHECK
+void *operator new(std::size_t size) {
+    void *ptr = trackedAllocate(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](std::size_t size) {
+    void *ptr = trackedAllocate(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return trackedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return trackedAllocate(size);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+#endif
@@ -1,137 +1,22 @@
 #include "../../include/Audio/SDLAudioEngine.h"
 #include <iostream>
 #include <vector>
-#include <cmath>
 #include <cstdint>
-#include <numeric>
 #include <algorithm>
-#include <cstdlib>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
 
 namespace MusicApp {
     namespace Audio {
 
-        // noteFrequencies_ is defined here as it was before.
-        const std::map<std::string, float> SDLAudioEngine::noteFrequencies_ = {
-                // Octave 0
-                {"C0",  16.35f},
-                {"C#0", 17.32f},
-                {"Db0", 17.32f},
-                {"D0",  18.35f},
-                {"D#0", 19.45f},
-                {"Eb0", 19.45f},
-                {"E0",  20.60f},
-                {"F0",  21.83f},
-                {"F#0", 23.12f},
-                {"Gb0", 23.12f},
-                {"G0",  24.50f},
-                {"G#0", 25.96f},
-                {"Ab0", 25.96f},
-                {"A0",  27.50f},
-                {"A#0", 29.14f},
-                {"Bb0", 29.14f},
-                {"B0",  30.87f},
-                // Octave 1
-                {"C1",  32.70f},
-                {"C#1", 34.65f},
-                {"Db1", 34.65f},
-                {"D1",  36.71f},
-                {"D#1", 38.89f},
-                {"Eb1", 38.89f},
-                {"E1",  41.20f},
-                {"F1",  43.65f},
-                {"F#1", 46.25f},
-                {"Gb1", 46.25f},
-                {"G1",  49.00f},
-                {"G#1", 51.91f},
-                {"Ab1", 51.91f},
-                {"A1",  55.00f},
-                {"A#1", 58.27f},
-                {"Bb1", 58.27f},
-                {"B1",  61.74f},
-                // Octave 2
-                {"C2",  65.41f},
-                {"C#2", 69.30f},
-                {"Db2", 69.30f},
-                {"D2",  73.42f},
-                {"D#2", 77.78f},
-                {"Eb2", 77.78f},
-                {"E2",  82.41f},
-                {"F2",  87.31f},
-                {"F#2", 92.50f},
-                {"Gb2", 92.50f},
-                {"G2",  98.00f},
-                {"G#2", 103.83f},
-                {"Ab2", 103.83f},
-                {"A2",  110.00f},
-                {"A#2", 116.54f},
-                {"Bb2", 116.54f},
-                {"B2",  123.47f},
-                // Octave 3
-                {"C3",  130.81f},
-                {"C#3", 138.59f},
-                {"Db3", 138.59f},
-                {"D3",  146.83f},
-                {"D#3", 155.56f},
-                {"Eb3", 155.56f},
-                {"E3",  164.81f},
-                {"F3",  174.61f},
-                {"F#3", 185.00f},
-                {"Gb3", 185.00f},
-                {"G3",  196.00f},
-                {"G#3", 207.65f},
-                {"Ab3", 207.65f},
-                {"A3",  220.00f},
-                {"A#3", 233.08f},
-                {"Bb3", 233.08f},
-                {"B3",  246.94f},
-                // Octave 4 (Middle C = C4)
-                {"C4",  261.63f},
-                {"C#4", 277.18f},
-                {"Db4", 277.18f},
-                {"D4",  293.66f},
-                {"D#4", 311.13f},
-                {"Eb4", 311.13f},
-                {"E4",  329.63f},
-                {"F4",  349.23f},
-                {"F#4", 369.99f},
-                {"Gb4", 369.99f},
-                {"G4",  392.00f},
-                {"G#4", 415.30f},
-                {"Ab4", 415.30f},
-                {"A4",  440.00f},
-                {"A#4", 466.16f},
-                {"Bb4", 466.16f},
-                {"B4",  493.88f},
-                // Octave 5
-                {"C5",  523.25f},
-                {"C#5", 554.37f},
-                {"Db5", 554.37f},
-                {"D5",  587.33f},
-                {"D#5", 622.25f},
-                {"Eb5", 622.25f},
-                {"E5",  659.25f},
-                {"F5",  698.46f},
-                {"F#5", 739.99f},
-                {"Gb5", 739.99f},
-                {"G5",  783.99f},
-                {"G#5", 830.61f},
-                {"Ab5", 830.61f},
-                {"A5",  880.00f},
-                {"A#5", 932.33f},
-                {"Bb5", 932.33f},
-                {"B5",  987.77f},
-        };
-
-
-        SDLAudioEngine::SDLAudioEngine()
-                : isInitialized_(false), audioStream_(nullptr), audioDevice_(0), activeNotesMutex_(nullptr) {
+        SDLAudioEngine::SDLAudioEngine(std::size_t polyphony)
+                : isInitialized_(false), audioStream_(nullptr), audioDevice_(0),
+                  synthesizer_(polyphony), outputFormat_(SDL_AUDIO_F32), commandMutex_(nullptr),
+                  scheduledCommands_(SCHEDULER_CAPACITY), framePosition_(0),
+                  tuning_(std::make_shared<const TuningTable>(Tunings::equalTemperament())),
+                  performanceFrequency_(SDL_GetPerformanceFrequency()) {
             std::cout << "SDLAudioEngine: Constructor called." << std::endl;
-            activeNotesMutex_ = SDL_CreateMutex();
-            if (!activeNotesMutex_) {
+            sessionsInUse_.set(LIVE_SESSION);
+            commandMutex_ = SDL_CreateMutex();
+            if (!commandMutex_) {
                 std::cerr << "SDLAudioEngine: Failed to create mutex: " << SDL_GetError() << std::endl;
             }
         }
@@ -141,128 +26,10 @@ namespace MusicApp {
             if (isInitialized_) {
                 shutdown();
             }
-            if (activeNotesMutex_) {
-                SDL_DestroyMutex(activeNotesMutex_);
-                activeNotesMutex_ = nullptr;
-            }
-        }
-
-        float SDLAudioEngine::getFrequencyForNote(const std::string &pitchName) const {
-            auto it = noteFrequencies_.find(pitchName);
-            if (it != noteFrequencies_.end()) {
-                return it->second;
-            }
-
-            // Support pour les notes spéciales de la console 8-bit (format 8bit_X)
-            if (pitchName.substr(0, 5) == "8bit_") {
-                // Extraire l'index du bouton à partir du nom de la note
-                try {
-                    int buttonIndex = std::stoi(pitchName.substr(5));
-
-                    // Calcul de la fréquence pour une gamme chromatique complète 
-                    // à partir de C4 (Do4) pour deux octaves
-                    const float C4_FREQUENCY = 261.63f;  // Fréquence de base pour C4 (Do4)
-
-                    // Association des boutons aux demi-tons
-                    int semitoneOffset = 0;
-
-                    // Les indices pairs représentent les notes blanches (Do, Ré, Mi, etc.)
-                    // Les indices impairs représentent les notes noires (Do#, Ré#, etc.)
-                    if (buttonIndex < 12) {
-                        // Première octave - notes naturelles et dièses/bémols
-                        switch (buttonIndex) {
-                            case 0:
-                                semitoneOffset = 0;
-                                break; // C4 (Do4)
-                            case 1:
-                                semitoneOffset = 2;
-                                break; // D4 (Ré4)
-                            case 2:
-                                semitoneOffset = 4;
-                                break; // E4 (Mi4)
-                            case 3:
-                                semitoneOffset = 5;
-                                break; // F4 (Fa4)
-                            case 4:
-                                semitoneOffset = 7;
-                                break; // G4 (Sol4)
-                            case 5:
-                                semitoneOffset = 9;
-                                break; // A4 (La4)
-                            case 6:
-                                semitoneOffset = 11;
-                                break; // B4 (Si4)
-                            case 7:
-                                semitoneOffset = 1;
-                                break; // C#4/Db4
-                            case 8:
-                                semitoneOffset = 3;
-                                break; // D#4/Eb4
-                            case 9:
-                                semitoneOffset = 6;
-                                break; // F#4/Gb4
-                            case 10:
-                                semitoneOffset = 8;
-                                break; // G#4/Ab4
-                            case 11:
-                                semitoneOffset = 10;
-                                break; // A#4/Bb4
-                        }
-                    } else {
-                        // Deuxième octave (ajouter 12 demi-tons)
-                        int idx = buttonIndex - 12;
-                        switch (idx) {
-                            case 0:
-                                semitoneOffset = 12;
-                                break; // C5 (Do5)
-                            case 1:
-                                semitoneOffset = 14;
-                                break; // D5 (Ré5)
-                            case 2:
-                                semitoneOffset = 16;
-                                break; // E5 (Mi5)
-                            case 3:
-                                semitoneOffset = 17;
-                                break; // F5 (Fa5)
-                            case 4:
-                                semitoneOffset = 19;
-                                break; // G5 (Sol5)
-                            case 5:
-                                semitoneOffset = 21;
-                                break; // A5 (La5)
-                            case 6:
-                                semitoneOffset = 23;
-                                break; // B5 (Si5)
-                            case 7:
-                                semitoneOffset = 13;
-                                break; // C#5/Db5
-                            case 8:
-                                semitoneOffset = 15;
-                                break; // D#5/Eb5
-                            case 9:
-                                semitoneOffset = 18;
-                                break; // F#5/Gb5
-                            case 10:
-                                semitoneOffset = 20;
-                                break; // G#5/Ab5
-                            case 11:
-                                semitoneOffset = 22;
-                                break; // A#5/Bb5
-                        }
-                    }
-
-                    // Calcul de la fréquence avec l'échelle tempérée
-                    return C4_FREQUENCY * std::pow(2.0f, semitoneOffset / 12.0f);
-                }
-                catch (const std::exception &e) {
-                    std::cerr << "SDLAudioEngine: Error parsing 8-bit note: " << pitchName << ", error: " << e.what()
-                              << std::endl;
-                }
+            if (commandMutex_) {
+                SDL_DestroyMutex(commandMutex_);
+                commandMutex_ = nullptr;
             }
-
-            std::cerr << "SDLAudioEngine: Frequency for note \'" << pitchName
-                      << "\' not found. Defaulting to 0 Hz (silence)." << std::endl;
-            return 0.0f;
         }
 
         bool SDLAudioEngine::init() {
@@ -275,7 +42,7 @@ namespace MusicApp {
             SDL_AudioSpec deviceSpecWant;
             SDL_zero(deviceSpecWant);
             deviceSpecWant.freq = 44100;
-            deviceSpecWant.format = SDL_AUDIO_S16LE;
+            deviceSpecWant.format = SDL_AUDIO_F32; // Bus de mixage natif ; SDL peut imposer un autre format
             deviceSpecWant.channels = 2;
 
             audioDevice_ = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &deviceSpecWant);
@@ -285,7 +52,28 @@ namespace MusicApp {
                 return false;
             }
 
-            audioStream_ = SDL_CreateAudioStream(&deviceSpecWant, &deviceSpecWant);
+            int deviceSampleFrames = 0;
+            SDL_AudioSpec deviceSpecHave;
+            outputFormat_ = SDL_AUDIO_F32;
+            if (SDL_GetAudioDeviceFormat(audioDevice_, &deviceSpecHave, &deviceSampleFrames)) {
+                metrics_.setOutputBufferNs(static_cast<Uint64>(deviceSampleFrames) * SDL_NS_PER_SECOND /
+                                           static_cast<Uint64>(deviceSpecHave.freq > 0 ? deviceSpecHave.freq
+                                                                                        : getSampleRate()));
+                if (deviceSampleFrames > synthesizer_.getMaxBlockFrames()) {
+                    synthesizer_.setMaxBlockFrames(deviceSampleFrames);
+                }
+                // Périphérique entier : on quantifie nous-mêmes en 16 bits (avec dither) plutôt que de laisser
+                // SDL tronquer le flottant
+                if (!SDL_AUDIO_ISFLOAT(deviceSpecHave.format)) {
+                    outputFormat_ = SDL_AUDIO_S16;
+                }
+            }
+            outputBuffer_.assign(
+                    outputFormat_ == SDL_AUDIO_S16 ? static_cast<size_t>(synthesizer_.getMaxBlockFrames()) * 2 : 0, 0);
+
+            SDL_AudioSpec streamSpec = deviceSpecWant;
+            streamSpec.format = outputFormat_;
+            audioStream_ = SDL_CreateAudioStream(&streamSpec, &streamSpec);
             if (!SDL_ResumeAudioDevice(audioDevice_)) {
                 std::cerr << "SDLAudioEngine: Failed to create audio stream: " << SDL_GetError() << std::endl;
                 SDL_CloseAudioDevice(audioDevice_);
@@ -329,7 +117,10 @@ namespace MusicApp {
 
             isInitialized_ = true;
             std::cout << "SDLAudioEngine: Successfully initialized with callback. Sample Rate: " << deviceSpecWant.freq
-                      << " Channels: " << (int) deviceSpecWant.channels << std::endl;
+                      << " Channels: " << (int) deviceSpecWant.channels
+                      << " Format: " << (outputFormat_ == SDL_AUDIO_F32 ? "F32" : "S16")
+                      << " Kernels: " << MixKernels::instructionSetName(MixKernels::activeInstructionSet())
+                      << std::endl;
             return true;
         }
 
@@ -352,6 +143,20 @@ namespace MusicApp {
                 }
                 SDL_QuitSubSystem(SDL_INIT_AUDIO);
                 isInitialized_ = false;
+                if (RealtimeAllocationTracker::isEnabled()) {
+                    std::cout << "SDLAudioEngine: Heap allocations on the audio thread: "
+                              << getRealtimeAllocationCount() << std::endl;
+                }
+                const AudioMetricsSnapshot metrics = metrics_.snapshot();
+                std::cout << "SDLAudioEngine: " << metrics.callbackCount << " callbacks, render avg "
+                          << metrics.averageRenderUs << " us / p99 " << metrics.p99RenderUs << " us / max "
+                          << metrics.maxRenderUs << " us, load " << metrics.averageLoad * 100.0 << " %, "
+                          << metrics.xrunCount << " xruns, peak " << metrics.peakVoices << " voices." << std::endl;
+                if (metrics.inputNoteCount > 0) {
+                    std::cout << "SDLAudioEngine: " << metrics.inputNoteCount << " live notes, input to first sample avg "
+                              << metrics.averageInputLatencyUs << " us / max " << metrics.maxInputLatencyUs
+                              << " us, plus " << metrics.outputBufferUs << " us of device buffer." << std::endl;
+                }
                 std::cout << "SDLAudioEngine: Shutdown complete." << std::endl;
             }
         }
@@ -360,596 +165,350 @@ namespace MusicApp {
             playSound(instrumentName, note, 1.0f);
         }
 
+        bool SDLAudioEngine::enqueueCommand(const AudioCommand &command) {
+            if (!commandQueue_.tryPush(command)) {
+                std::cerr << "SDLAudioEngine: Command queue full, dropping event for note "
+                          << static_cast<int>(command.pitchId) << "." << std::endl;
+                return false;
+            }
+            return true;
+        }
+
         void SDLAudioEngine::playSound(const std::string &instrumentName, const Core::Note &note, float velocity) {
-            if (!isInitialized_ || !activeNotesMutex_) {
+            if (!isInitialized_ || !commandMutex_) {
                 std::cerr << "SDLAudioEngine: Cannot play sound, not initialized or mutex missing." << std::endl;
                 return;
             }
 
-            velocity = std::max(0.1f, std::min(velocity, 1.0f));
-
-            float frequency = getFrequencyForNote(note.pitchName);
-            if (frequency <= 0.0f) {
+            // Le numéro MIDI est lu une fois à la construction de la note : ici, un simple accès au tableau
+            if (getTuning()->frequency(note.midiNumber) <= 0.0f) {
                 std::cerr << "SDLAudioEngine: Invalid frequency for note \'" << note.pitchName << "\'." << std::endl;
                 return;
             }
 
-            std::string noteId = instrumentName + "_" + note.pitchName;
-
-            SDL_LockMutex(activeNotesMutex_);
-            auto it = activeNotes_.find(noteId);
-            if (it != activeNotes_.end() && it->second.isPlaying && !it->second.needsRelease) {
-                SDL_UnlockMutex(activeNotesMutex_);
-                return;
+            if (noteOn(Synthesizer::instrumentIdForName(instrumentName), note.midiNumber, velocity)) {
+                std::cout << "SDLAudioEngine: Queued note \'" << note.pitchName << "\' (Vel: "
+                          << std::max(0.1f, std::min(velocity, 1.0f)) << ") for callback." << std::endl;
             }
-
-            ActiveNote newActiveNote;
-            newActiveNote.instrumentName = instrumentName;
-            newActiveNote.pitchName = note.pitchName;
-            newActiveNote.frequency = frequency;
-            newActiveNote.isPlaying = true;
-            newActiveNote.needsRelease = false;
-            newActiveNote.systemStartTimeMs = SDL_GetTicks();
-            newActiveNote.currentTimeInSamples = 0;
-            newActiveNote.currentEnvelopeValue = 0.0f;
-            newActiveNote.velocity = velocity;
-            newActiveNote.prevSampleLeft = 0.0f;
-            newActiveNote.prevSampleRight = 0.0f;
-            newActiveNote.phase = 0.0f;
-
-            activeNotes_[noteId] = newActiveNote;
-
-            std::cout << "SDLAudioEngine: Queued note \'" << note.pitchName << "\' (Freq: " << frequency <<
-                      " Hz, Vel: "
-                      << velocity
-                      << ") for callback."
-                      << std::endl;
-            SDL_UnlockMutex(activeNotesMutex_);
         }
 
-        void SDLAudioEngine::stopSound(const std::string &instrumentName, const Core::Note &note) {
-            if (!isInitialized_ || !activeNotesMutex_) return;
-
-            std::string noteId = instrumentName + "_" + note.pitchName;
-            SDL_LockMutex(activeNotesMutex_);
-            auto it = activeNotes_.find(noteId);
-            if (it != activeNotes_.end() && it->second.isPlaying) {
-                it->second.isPlaying = false;
-                it->second.needsRelease = true;
-                it->second.currentTimeInSamples = 0;
-
-                if (it->second.currentEnvelopeValue < 0.05f) {
-                    it->second.currentEnvelopeValue = 0.05f;
-                }
-
-                std::cout << "SDLAudioEngine: Marked note \'" << it->second.pitchName
-                          << "\' for release with envelope value: "
-                          << it->second.currentEnvelopeValue << std::endl;
+        bool SDLAudioEngine::noteOn(InstrumentId instrumentId, int midiNumber, float velocity,
+                                    Uint64 inputTimestampNs) {
+            if (!isInitialized_ || !commandMutex_) return false;
+
+            const float frequency = getTuning()->frequency(midiNumber);
+            if (frequency <= 0.0f) return false;
+
+            AudioCommand command;
+            command.type = AudioCommand::Type::NoteOn;
+            command.instrumentId = instrumentId;
+            command.pitchId = static_cast<Uint8>(midiNumber);
+            command.frequency = frequency;
+            command.velocity = std::max(0.1f, std::min(velocity, 1.0f));
+            command.systemStartTimeMs = SDL_GetTicks();
+            command.inputTimestampNs = inputTimestampNs;
+
+            const std::size_t heldIndex = heldNoteIndex(command.instrumentId, command.pitchId);
+
+            SDL_LockMutex(commandMutex_);
+            bool queued = !heldNotes_.test(heldIndex) && enqueueCommand(command);
+            if (queued) {
+                heldNotes_.set(heldIndex);
+                heldNoteStartMs_[heldIndex] = command.systemStartTimeMs;
             }
-            SDL_UnlockMutex(activeNotesMutex_);
+            SDL_UnlockMutex(commandMutex_);
+            return queued;
         }
 
-        void
-        SDLAudioEngine::generateAudioChunk(ActiveNote &note, std::vector<int16_t> &buffer, int numStereoSampleFrames) {
-            const float twoPi = 2.0f * static_cast<float>(M_PI);
-            const int totalMonoSamplesNeeded = numStereoSampleFrames * 2;
-
-            // Ajuster les paramètres ADSR en fonction de la vélocité
-            // Attaque plus courte pour les notes fortes, plus longue pour les notes douces
-            float attackDuration =
-                    ActiveNote::ATTACK_DURATION_SAMPLES * (1.2f - note.velocity * 0.6f); // 6ms à 14ms selon la vélocité
-            float decayDuration = ActiveNote::DECAY_DURATION_SAMPLES *
-                                  (0.8f + note.velocity * 0.4f);   // 80ms à 120ms selon la vélocité
-            float sustainLevel = ActiveNote::SUSTAIN_LEVEL *
-                                 (0.6f + note.velocity * 0.4f);             // 42% à 70% selon la vélocité
-
-            // Calculer les paramètres de filtre basés sur la vélocité pour les harmoniques
-            // Une vélocité plus élevée donne des harmoniques plus brillantes
-            float harmonic_factor = note.velocity * 1.3f; // Plus de brillance pour les notes fortes
-
-            for (int i = 0; i < totalMonoSamplesNeeded; i += 2) {
-                float sampleValue = 0.0f;
-                float envelope = 0.0f;
-
-                // Calculer l'enveloppe ADSR
-                if (note.isPlaying && !note.needsRelease) {
-                    if (note.currentTimeInSamples < attackDuration) {
-                        // Courbe d'attaque plus douce pour éviter les clics
-                        // Utiliser une fonction sinusoïdale pour l'attaque (commence doucement, s'accélère puis ralentit)
-                        float normalizedTime = static_cast<float>(note.currentTimeInSamples) / attackDuration;
-                        note.currentEnvelopeValue = (1.0f - std::cos(normalizedTime * M_PI)) * 0.5f;
-                        envelope = note.currentEnvelopeValue;
-                    } else if (note.currentTimeInSamples < (attackDuration + decayDuration)) {
-                        float decayProgress = (note.currentTimeInSamples - attackDuration) / decayDuration;
-                        note.currentEnvelopeValue = 1.0f - (1.0f - sustainLevel) * decayProgress;
-                        envelope = note.currentEnvelopeValue;
-                    } else {
-                        note.currentEnvelopeValue = sustainLevel;
-                        envelope = note.currentEnvelopeValue;
-                    }
-                    note.currentTimeInSamples++;
-                } else if (note.needsRelease) {
-                    // Release plus long pour les notes fortes et avec une courbe plus douce
-                    float releaseDuration = ActiveNote::RELEASE_DURATION_SAMPLES * (1.0f + note.velocity * 0.5f);
-                    if (note.currentTimeInSamples < releaseDuration) {
-                        // Courbe de relâchement douce pour éviter les clics
-                        float releaseProgress = static_cast<float>(note.currentTimeInSamples) / releaseDuration;
-                        // Combinaison de courbe exponentielle et sinusoïdale pour une atténuation naturelle
-                        envelope = note.currentEnvelopeValue * (0.5f + 0.5f * std::cos(releaseProgress * M_PI)) *
-                                   std::exp(-3.0f * releaseProgress);
-                    } else {
-                        envelope = 0.0f;
-                        note.needsRelease = false;
-                    }
-                    note.currentTimeInSamples++;
-                }
-
-                if (envelope > 0.0001f) {
-                    float time_in_seconds = static_cast<float>(note.currentTimeInSamples) / 44100.0f;
-
-                    // Utiliser une approche basée sur la phase plutôt que le temps pour éviter les discontinuités
-                    // Calculer l'incrément de phase en fonction de la fréquence
-                    float phase_increment = twoPi * note.frequency / 44100.0f;
-
-                    // Modèle de synthèse de piano amélioré avec plus d'harmoniques
-                    // Forme d'onde fondamentale avec phase continue
-                    float fundamental = std::sin(note.phase);
-
-                    // Harmoniques avec intensités variables selon la vélocité
-                    // Plus la vélocité est forte, plus les harmoniques supérieures sont présentes
-                    float harmonic1 = 0.5f * std::sin(note.phase * 2.0f) * harmonic_factor;
-                    float harmonic2 = 0.3f * std::sin(note.phase * 3.0f) * harmonic_factor;
-                    float harmonic3 = 0.2f * std::sin(note.phase * 4.0f) * harmonic_factor * note.velocity;
-                    float harmonic4 =
-                            0.1f * std::sin(note.phase * 5.0f) * harmonic_factor * note.velocity * note.velocity;
-
-                    // Effet d'attaque subtil (bruit de marteau) au début de la note
-                    // Réduit pour minimiser les bruits parasites
-                    float hammerNoise = 0.0f;
-                    if (note.currentTimeInSamples < attackDuration * 2) {
-                        // Atténuer le bruit et l'envelopper plus doucement
-                        float noiseEnvelope =
-                                (1.0f - std::cos(note.currentTimeInSamples / (attackDuration * 2) * M_PI)) * 0.5f;
-                        hammerNoise = ((std::rand() / static_cast<float>(RAND_MAX)) * 2.0f - 1.0f) *
-                                      0.03f * note.velocity * noiseEnvelope;
-                    }
+        void SDLAudioEngine::noteOff(InstrumentId instrumentId, int midiNumber) {
+            if (!isInitialized_ || !commandMutex_ || !Core::Note::isInRange(midiNumber)) return;
 
-                    // Effet de résonance des cordes - plus prononcé pour les notes fortes
-                    // Simuler les vibrations sympathiques des cordes
-                    float resonance = 0.02f * note.velocity *
-                                      std::sin(twoPi * note.frequency * 1.01f * time_in_seconds) *
-                                      std::exp(-0.5f * time_in_seconds);
-
-                    // Combiner tous les éléments du son
-                    float oscillatorValue = fundamental + harmonic1 + harmonic2 + harmonic3 + harmonic4 +
-                                            hammerNoise + resonance;
+            SDL_LockMutex(commandMutex_);
+            releaseHeldNote(instrumentId, static_cast<Uint8>(midiNumber));
+            SDL_UnlockMutex(commandMutex_);
+        }
 
-                    // Normaliser le volume
-                    oscillatorValue = oscillatorValue / (1.0f + harmonic_factor * 0.5f);
+        void SDLAudioEngine::releaseHeldNote(InstrumentId instrumentId, Uint8 pitchId) {
+            const std::size_t heldIndex = heldNoteIndex(instrumentId, pitchId);
+            if (!heldNotes_.test(heldIndex)) return;
 
-                    // Appliquer l'enveloppe et la vélocité
-                    sampleValue = oscillatorValue * envelope * note.velocity;
+            AudioCommand command;
+            command.type = AudioCommand::Type::NoteOff;
+            command.instrumentId = instrumentId;
+            command.pitchId = pitchId;
 
-                    // Mettre à jour la phase pour le prochain échantillon
-                    note.phase += phase_increment;
-                    // Gardez la phase dans la plage [0, 2π] pour éviter les problèmes de précision
-                    while (note.phase >= twoPi) {
-                        note.phase -= twoPi;
-                    }
-                } else {
-                    // Faire un fondu vers zéro pour les échantillons très faibles
-                    // afin d'éviter les discontinuités
-                    sampleValue = 0.0f;
-                    // Ne pas réinitialiser la phase à 0 pour éviter les discontinuités si la note reprend
-                }
+            // Si la file est pleine, la note reste "tenue" et cleanupLongPlayingNotes retentera plus tard
+            if (enqueueCommand(command)) {
+                heldNotes_.reset(heldIndex);
+            }
+        }
 
-                // Ajouter un léger effet de stéréo en fonction de la fréquence (graves à gauche, aigus à droite)
-                float stereoPan = 0.5f + (note.frequency - 440.0f) / 2000.0f; // Centrée autour de La4 (440Hz)
-                stereoPan = SDL_clamp(stereoPan, 0.2f, 0.8f); // Limiter le panning pour éviter les extrêmes
+        void SDLAudioEngine::stopSound(const std::string &instrumentName, const Core::Note &note) {
+            if (!note.isValid()) return;
+            noteOff(Synthesizer::instrumentIdForName(instrumentName), note.midiNumber);
+        }
 
-                float leftPan = 1.0f - stereoPan * 0.5f;  // 0.6 à 0.9
-                float rightPan = 0.5f + stereoPan * 0.5f; // 0.6 à 0.9
+        void SDLAudioEngine::setNoteVelocity(const std::string &instrumentName, const Core::Note &note,
+                                             float velocity) {
+            if (!isInitialized_ || !commandMutex_) return;
 
-                // Appliquer un fondu pour éviter les discontinuités
-                // Transition douce entre échantillons précédents et actuels
-                float left_sample = sampleValue * leftPan;
-                float right_sample = sampleValue * rightPan;
+            const int pitchId = note.midiNumber;
+            if (!note.isValid()) return;
 
-                // Crossfade pour minimiser les clics/pops
-                const float crossfade_factor = 0.1f; // Facteur de fondu entre échantillons
-                left_sample = left_sample * (1.0f - crossfade_factor) + note.prevSampleLeft * crossfade_factor;
-                right_sample = right_sample * (1.0f - crossfade_factor) + note.prevSampleRight * crossfade_factor;
+            AudioCommand command;
+            command.type = AudioCommand::Type::Velocity;
+            command.instrumentId = Synthesizer::instrumentIdForName(instrumentName);
+            command.pitchId = static_cast<Uint8>(pitchId);
+            command.velocity = std::max(0.1f, std::min(velocity, 1.0f));
 
-                // Sauvegarder pour le prochain cycle
-                note.prevSampleLeft = left_sample;
-                note.prevSampleRight = right_sample;
+            SDL_LockMutex(commandMutex_);
+            if (heldNotes_.test(heldNoteIndex(command.instrumentId, command.pitchId))) {
+                enqueueCommand(command);
+            }
+            SDL_UnlockMutex(commandMutex_);
+        }
 
-                // Convertir en échantillon 16 bits avec un gain adapté à la vélocité
-                // Utilisation de SDL_clamp pour éviter les saturations brutes qui créent des clics
-                int16_t left_int_sample = static_cast<int16_t>(SDL_clamp(left_sample * 32767.0f * 0.8f, -32767.0f,
-                                                                         32767.0f));
-                int16_t right_int_sample = static_cast<int16_t>(SDL_clamp(right_sample * 32767.0f * 0.8f, -32767.0f,
-                                                                          32767.0f));
 
-                buffer[i] = left_int_sample;
-                buffer[i + 1] = right_int_sample;
+        bool SDLAudioEngine::scheduleNoteOn(const std::string &instrumentName, const Core::Note &note, float velocity,
+                                            Uint64 frame) {
+            if (!note.isValid()) {
+                std::cerr << "SDLAudioEngine: Invalid frequency for note \'" << note.pitchName << "\'." << std::endl;
+                return false;
             }
+            return scheduleNoteOn(Synthesizer::instrumentIdForName(instrumentName), note.midiNumber, velocity, frame);
         }
 
-        void SDLAudioEngine::generateXylophoneAudioChunk(ActiveNote &note, std::vector<int16_t> &buffer,
-                                                         int numStereoSampleFrames) {
-            const float twoPi = 2.0f * static_cast<float>(M_PI);
-            const int totalMonoSamplesNeeded = numStereoSampleFrames * 2;
-
-            // Paramètres spécifiques au xylophone, ajustés selon la vélocité
-            const float base_attack_duration = 0.005f; // 5ms (très court pour le xylophone)
-            const float base_decay_duration = 0.5f;    // 500ms (plus court que le piano)
-            const float base_release_duration = 0.1f;  // 100ms release
-
-            // Ajuster les paramètres en fonction de la vélocité
-            const float XYLOPHONE_ATTACK_DURATION =
-                    base_attack_duration * (1.2f - note.velocity * 0.4f); // Plus court pour les notes fortes
-            const float XYLOPHONE_DECAY_DURATION =
-                    base_decay_duration * (0.7f + note.velocity * 0.6f);   // Plus long pour les notes fortes
-            const float XYLOPHONE_RELEASE_DURATION = base_release_duration * (0.8f + note.velocity * 0.4f);
-            const float XYLOPHONE_SUSTAIN_LEVEL = 0.0f;    // Pas de sustain pour le xylophone
-
-            // Convertir en échantillons
-            const float XYLOPHONE_ATTACK_SAMPLES = 44100 * XYLOPHONE_ATTACK_DURATION;
-            const float XYLOPHONE_DECAY_SAMPLES = 44100 * XYLOPHONE_DECAY_DURATION;
-            const float XYLOPHONE_RELEASE_SAMPLES = 44100 * XYLOPHONE_RELEASE_DURATION;
-
-            // Facteur de brillance des harmoniques basé sur la vélocité
-            const float brightness_factor = 0.8f + note.velocity * 0.4f;
-
-            for (int i = 0; i < totalMonoSamplesNeeded; i += 2) {
-                float sampleValue = 0.0f;
-                float envelope = 0.0f;
-
-                if (note.isPlaying && !note.needsRelease) {
-                    if (note.currentTimeInSamples < XYLOPHONE_ATTACK_SAMPLES) {
-                        // Attaque très rapide pour le xylophone, mais avec une courbe plus douce
-                        float normalizedTime = static_cast<float>(note.currentTimeInSamples) / XYLOPHONE_ATTACK_SAMPLES;
-                        note.currentEnvelopeValue = (1.0f - std::cos(normalizedTime * M_PI)) * 0.5f;
-                        envelope = note.currentEnvelopeValue;
-                    } else if (note.currentTimeInSamples < (XYLOPHONE_ATTACK_SAMPLES + XYLOPHONE_DECAY_SAMPLES)) {
-                        // Décroissance plus rapide pour le xylophone
-                        float decayProgress =
-                                (note.currentTimeInSamples - XYLOPHONE_ATTACK_SAMPLES) / XYLOPHONE_DECAY_SAMPLES;
-                        // Utiliser une courbe exponentielle pour une décroissance plus naturelle
-                        note.currentEnvelopeValue = std::exp(-decayProgress * 2.5f);
-                        envelope = note.currentEnvelopeValue;
-                    } else {
-                        // Pas de sustain pour le xylophone
-                        note.currentEnvelopeValue = XYLOPHONE_SUSTAIN_LEVEL;
-                        envelope = note.currentEnvelopeValue;
-                    }
-                    note.currentTimeInSamples++;
-                } else if (note.needsRelease) {
-                    // Relâchement rapide mais progressif
-                    if (note.currentTimeInSamples < XYLOPHONE_RELEASE_SAMPLES) {
-                        float releaseProgress =
-                                static_cast<float>(note.currentTimeInSamples) / XYLOPHONE_RELEASE_SAMPLES;
-                        // Courbe de relâchement douce pour éviter les clics
-                        envelope = note.currentEnvelopeValue * (0.5f + 0.5f * std::cos(releaseProgress * M_PI)) *
-                                   std::exp(-3.0f * releaseProgress);
-                    } else {
-                        envelope = 0.0f;
-                        note.needsRelease = false;
-                    }
-                    note.currentTimeInSamples++;
-                }
-
-                if (envelope > 0.0001f) {
-                    // Utiliser la phase continue pour éviter les discontinuités
-                    float phase_increment = twoPi * note.frequency / 44100.0f;
-
-                    // Mélange des harmoniques pour obtenir un son plus brillant de xylophone
-                    float fundamental = std::sin(note.phase);
-                    float harmonic1 = 0.5f * std::sin(note.phase * 2.0f) * brightness_factor;
-                    float harmonic2 = 0.33f * std::sin(note.phase * 4.0f) * brightness_factor;
-                    float harmonic3 = 0.25f * std::sin(note.phase * 6.0f) * brightness_factor * note.velocity;
-
-                    // Effet de résonance métallique caractéristique du xylophone
-                    float time_in_seconds = static_cast<float>(note.currentTimeInSamples) / 44100.0f;
-                    float resonance = 0.1f * std::sin(twoPi * note.frequency * 12.0f * time_in_seconds) *
-                                      std::exp(-time_in_seconds * 8.0f) * note.velocity; // Décroît rapidement
-
-                    // Léger bruit d'impact au début (mallet hit), modulé par la vélocité
-                    float impactNoise = 0.0f;
-                    if (note.currentTimeInSamples < XYLOPHONE_ATTACK_SAMPLES * 2) {
-                        // Atténuer le bruit et l'envelopper plus doucement
-                        float noiseEnvelope =
-                                (1.0f - std::cos(note.currentTimeInSamples / (XYLOPHONE_ATTACK_SAMPLES * 2) * M_PI)) *
-                                0.5f;
-                        impactNoise = ((std::rand() / static_cast<float>(RAND_MAX)) * 2.0f - 1.0f) *
-                                      0.1f * note.velocity * noiseEnvelope;
-                    }
+        bool SDLAudioEngine::scheduleNoteOff(const std::string &instrumentName, const Core::Note &note, Uint64 frame) {
+            if (!note.isValid()) return false;
+            return scheduleNoteOff(Synthesizer::instrumentIdForName(instrumentName), note.midiNumber, frame);
+        }
 
-                    // Mélange avec plus d'harmoniques hautes pour le son brillant du xylophone
-                    float oscillatorValue = fundamental + harmonic1 + harmonic2 + harmonic3 + resonance + impactNoise;
-                    oscillatorValue = oscillatorValue / (1.5f + brightness_factor * 0.5f); // Normaliser le volume
+        bool SDLAudioEngine::scheduleNoteOn(InstrumentId instrumentId, int midiNumber, float velocity, Uint64 frame,
+                                            SessionId sessionId) {
+            if (!isInitialized_ || !commandMutex_) return false;
 
-                    // Appliquer l'enveloppe et la vélocité
-                    sampleValue = oscillatorValue * envelope * note.velocity;
+            const float frequency = getTuning()->frequency(midiNumber);
+            if (frequency <= 0.0f) {
+                std::cerr << "SDLAudioEngine: Invalid frequency for MIDI note " << midiNumber << "." << std::endl;
+                return false;
+            }
 
-                    // Mettre à jour la phase pour le prochain échantillon
-                    note.phase += phase_increment;
-                    // Gardez la phase dans la plage [0, 2π] pour éviter les problèmes de précision
-                    while (note.phase >= twoPi) {
-                        note.phase -= twoPi;
-                    }
-                } else {
-                    sampleValue = 0.0f;
-                    // Ne pas réinitialiser la phase à 0 pour éviter les discontinuités si la note reprend
-                }
+            AudioCommand command;
+            command.type = AudioCommand::Type::NoteOn;
+            command.instrumentId = instrumentId;
+            command.pitchId = static_cast<Uint8>(midiNumber);
+            command.sessionId = sessionId;
+            command.frequency = frequency;
+            command.velocity = std::max(0.1f, std::min(velocity, 1.0f));
+            command.systemStartTimeMs = SDL_GetTicks();
+            command.frame = frame;
+
+            SDL_LockMutex(commandMutex_);
+            bool queued = enqueueCommand(command);
+            SDL_UnlockMutex(commandMutex_);
+            return queued;
+        }
 
-                // Ajouter un léger effet stéréo (panning) basé sur la fréquence
-                // Les notes basses plus à gauche, les notes hautes plus à droite
-                float normalizedFreq = (note.frequency - 200.0f) / 800.0f;  // Normaliser entre 0-1
-                normalizedFreq = SDL_clamp(normalizedFreq, 0.0f, 1.0f);
+        bool SDLAudioEngine::scheduleNoteOff(InstrumentId instrumentId, int midiNumber, Uint64 frame,
+                                             SessionId sessionId) {
+            if (!isInitialized_ || !commandMutex_ || !Core::Note::isInRange(midiNumber)) return false;
+
+            AudioCommand command;
+            command.type = AudioCommand::Type::NoteOff;
+            command.instrumentId = instrumentId;
+            command.pitchId = static_cast<Uint8>(midiNumber);
+            command.sessionId = sessionId;
+            command.frame = frame;
+
+            SDL_LockMutex(commandMutex_);
+            bool queued = enqueueCommand(command);
+            SDL_UnlockMutex(commandMutex_);
+            return queued;
+        }
 
-                // Calculer les volumes des canaux gauche et droit
-                float leftVolume = 1.0f - (normalizedFreq * 0.5f);   // 1.0 à 0.5
-                float rightVolume = 0.5f + (normalizedFreq * 0.5f);  // 0.5 à 1.0
+        void SDLAudioEngine::cancelScheduledEvents(SessionId sessionId) {
+            if (!isInitialized_ || !commandMutex_) return;
 
-                // Appliquer un fondu pour éviter les discontinuités
-                float left_sample = sampleValue * leftVolume;
-                float right_sample = sampleValue * rightVolume;
+            AudioCommand command;
+            command.type = AudioCommand::Type::ClearScheduled;
+            command.sessionId = sessionId;
 
-                // Crossfade pour minimiser les clics/pops
-                const float crossfade_factor = 0.08f; // Légèrement moins de crossfade que le piano (son plus percussif)
-                left_sample = left_sample * (1.0f - crossfade_factor) + note.prevSampleLeft * crossfade_factor;
-                right_sample = right_sample * (1.0f - crossfade_factor) + note.prevSampleRight * crossfade_factor;
+            SDL_LockMutex(commandMutex_);
+            enqueueCommand(command);
+            SDL_UnlockMutex(commandMutex_);
+        }
 
-                // Sauvegarder pour le prochain cycle
-                note.prevSampleLeft = left_sample;
-                note.prevSampleRight = right_sample;
+        SessionId SDLAudioEngine::acquireSession() {
+            if (!commandMutex_) return LIVE_SESSION;
 
-                // Convertir en échantillon 16 bits avec un gain adapté à la vélocité
-                int16_t left_int_sample = static_cast<int16_t>(SDL_clamp(left_sample * 32767.0f * 0.85f, -32767.0f,
-                                                                         32767.0f));
-                int16_t right_int_sample = static_cast<int16_t>(SDL_clamp(right_sample * 32767.0f * 0.85f, -32767.0f,
-                                                                          32767.0f));
+            SDL_LockMutex(commandMutex_);
+            SessionId sessionId = LIVE_SESSION;
+            for (std::size_t i = 0; i < MAX_SESSIONS; ++i) {
+                if (!sessionsInUse_.test(i)) {
+                    sessionsInUse_.set(i);
+                    sessionId = static_cast<SessionId>(i);
+                    break;
+                }
+            }
+            SDL_UnlockMutex(commandMutex_);
 
-                buffer[i] = left_int_sample;
-                buffer[i + 1] = right_int_sample;
+            if (sessionId == LIVE_SESSION) {
+                std::cerr << "SDLAudioEngine: No playback session left (" << MAX_SESSIONS - 1
+                          << " at most); sharing the live session." << std::endl;
             }
+            return sessionId;
         }
 
-        void SDLAudioEngine::generate8BitAudioChunk(ActiveNote &note, std::vector<int16_t> &buffer,
-                                                    int numStereoSampleFrames) {
-            const float twoPi = 2.0f * static_cast<float>(M_PI);
-            const int totalMonoSamplesNeeded = numStereoSampleFrames * 2;
-
-            // Paramètres spécifiques au son 8-bit, ajustés selon la vélocité
-            const float base_attack = 0.01f;   // 10ms
-            const float base_decay = 0.05f;    // 50ms
-            const float base_release = 0.05f;  // 50ms
-
-            // Ajuster les paramètres en fonction de la vélocité
-            const float CHIPTUNE_ATTACK_DURATION =
-                    base_attack * (1.1f - note.velocity * 0.5f); // Plus court pour les notes fortes
-            const float CHIPTUNE_DECAY_DURATION = base_decay * (0.9f + note.velocity * 0.2f);
-            const float CHIPTUNE_RELEASE_DURATION = base_release * (0.8f + note.velocity * 0.4f);
-            const float CHIPTUNE_SUSTAIN_LEVEL = 0.6f + (note.velocity * 0.2f);     // 60-80% de volume selon vélocité
-
-            // Convertir en échantillons
-            const float CHIPTUNE_ATTACK_SAMPLES = 44100 * CHIPTUNE_ATTACK_DURATION;
-            const float CHIPTUNE_DECAY_SAMPLES = 44100 * CHIPTUNE_DECAY_DURATION;
-            const float CHIPTUNE_RELEASE_SAMPLES = 44100 * CHIPTUNE_RELEASE_DURATION;
-
-            // Facteur de quantification pour le son 8-bit, peut varier avec la vélocité
-            // Pour les notes fortes, moins de bits = son plus saturé et agressif
-            const int BIT_DEPTH = std::max(3, static_cast<int>(6 - note.velocity *
-                                                                   2));  // Entre 3 et 6 bits selon la vélocité
-            const float QUANTIZE_LEVELS = (1 << BIT_DEPTH) - 1;  // Niveaux de quantification
-
-            for (int i = 0; i < totalMonoSamplesNeeded; i += 2) {
-                float sampleValue = 0.0f;
-                float envelope = 0.0f;
-
-                // Calcul de l'enveloppe ADSR avec courbes douces
-                if (note.isPlaying && !note.needsRelease) {
-                    if (note.currentTimeInSamples < CHIPTUNE_ATTACK_SAMPLES) {
-                        // Attaque douce pour éviter les clics
-                        float normalizedTime = static_cast<float>(note.currentTimeInSamples) / CHIPTUNE_ATTACK_SAMPLES;
-                        note.currentEnvelopeValue = (1.0f - std::cos(normalizedTime * M_PI)) * 0.5f;
-                        envelope = note.currentEnvelopeValue;
-                    } else if (note.currentTimeInSamples < (CHIPTUNE_ATTACK_SAMPLES + CHIPTUNE_DECAY_SAMPLES)) {
-                        float decayProgress =
-                                (note.currentTimeInSamples - CHIPTUNE_ATTACK_SAMPLES) / CHIPTUNE_DECAY_SAMPLES;
-                        note.currentEnvelopeValue = 1.0f - (1.0f - CHIPTUNE_SUSTAIN_LEVEL) * decayProgress;
-                        envelope = note.currentEnvelopeValue;
-                    } else {
-                        note.currentEnvelopeValue = CHIPTUNE_SUSTAIN_LEVEL;
-                        envelope = note.currentEnvelopeValue;
-                    }
-                    note.currentTimeInSamples++;
-                } else if (note.needsRelease) {
-                    if (note.currentTimeInSamples < CHIPTUNE_RELEASE_SAMPLES) {
-                        float releaseProgress =
-                                static_cast<float>(note.currentTimeInSamples) / CHIPTUNE_RELEASE_SAMPLES;
-                        // Transition douce vers le silence pour éviter les pops
-                        envelope = note.currentEnvelopeValue * (0.5f + 0.5f * std::cos(releaseProgress * M_PI)) *
-                                   std::exp(-2.0f * releaseProgress);
-                    } else {
-                        envelope = 0.0f;
-                        note.needsRelease = false;
-                    }
-                    note.currentTimeInSamples++;
-                }
-
-                if (envelope > 0.0001f) {
-                    float time_in_seconds = static_cast<float>(note.currentTimeInSamples) / 44100.0f;
-
-                    // Utiliser la phase pour formes d'ondes continues
-                    float phase_increment = twoPi * note.frequency / 44100.0f;
-
-                    // Générer une forme d'onde carrée (caractéristique du son 8-bit)
-                    // En utilisant la phase pour continuité
-                    float squareWave = std::sin(note.phase) > 0.0f ? 1.0f : -1.0f;
+        void SDLAudioEngine::releaseSession(SessionId sessionId) {
+            if (sessionId == LIVE_SESSION || sessionId >= MAX_SESSIONS || !commandMutex_) return;
 
-                    // Ajouter une légère modulation (vibrato) pour les effets spéciaux
-                    // L'intensité du vibrato dépend de la vélocité
-                    float vibrato = std::sin(twoPi * 7.0f * time_in_seconds) * 0.05f * note.velocity;
-
-                    // Ajouter de la distorsion qui varie avec la vélocité
-                    float distortion = std::sin(twoPi * note.frequency * 2.0f * time_in_seconds) *
-                                       (0.1f + note.velocity * 0.2f);
-
-                    // Ajouter du "bitcrush noise" - caractéristique des consoles rétro
-                    float noise = 0.0f;
-                    if (note.velocity > 0.7f) { // Uniquement pour les vélocités fortes
-                        noise = (std::rand() / static_cast<float>(RAND_MAX) * 2.0f - 1.0f) *
-                                0.05f * (note.velocity - 0.7f) / 0.3f;
-                    }
+            cancelScheduledEvents(sessionId);
+            setSessionGain(sessionId, 1.0f); // La prochaine session qui reprend cet identifiant part d'un gain neutre
+            SDL_LockMutex(commandMutex_);
+            sessionsInUse_.reset(sessionId);
+            SDL_UnlockMutex(commandMutex_);
+        }
 
-                    // Mélanger les effets avec des poids qui varient selon la vélocité
-                    float oscillatorValue = squareWave + vibrato + distortion + noise;
+        void SDLAudioEngine::setSessionGain(SessionId sessionId, float gain) {
+            if (!isInitialized_ || !commandMutex_ || sessionId >= MAX_SESSIONS) return;
 
-                    // Appliquer la quantification (effet de réduction de bit)
-                    // Plus la vélocité est forte, plus la quantification est prononcée
-                    oscillatorValue = std::floor(oscillatorValue * QUANTIZE_LEVELS + 0.5f) / QUANTIZE_LEVELS;
+            AudioCommand command;
+            command.type = AudioCommand::Type::SessionGain;
+            command.sessionId = sessionId;
+            command.velocity = std::max(0.0f, gain);
 
-                    // Appliquer l'enveloppe et la vélocité
-                    sampleValue = oscillatorValue * envelope * (0.7f + note.velocity * 0.3f);
+            SDL_LockMutex(commandMutex_);
+            enqueueCommand(command);
+            SDL_UnlockMutex(commandMutex_);
+        }
 
-                    // Mettre à jour la phase pour le prochain échantillon
-                    note.phase += phase_increment;
-                    // Maintenir la phase dans la plage [0, 2π]
-                    while (note.phase >= twoPi) {
-                        note.phase -= twoPi;
+        void SDLAudioEngine::drainCommands(Uint64 callbackStartNs) {
+            const Uint64 position = framePosition_.load(std::memory_order_relaxed);
+            AudioCommand command;
+            while (commandQueue_.tryPop(command)) {
+                if (command.type == AudioCommand::Type::ClearScheduled) {
+                    scheduledCommands_.clearSession(command.sessionId);
+                } else if (command.type == AudioCommand::Type::SessionGain) {
+                    synthesizer_.applyCommand(command);
+                } else if (command.frame <= position || !scheduledCommands_.push(command)) {
+                    // Déjà dû (ou ordonnanceur plein) : mieux vaut jouer l'événement en avance que le perdre
+                    synthesizer_.applyCommand(command);
+                    // Note jouée en direct : son premier échantillon est rendu par ce callback
+                    if (command.inputTimestampNs != 0 && callbackStartNs > command.inputTimestampNs) {
+                        metrics_.recordInputLatency(callbackStartNs - command.inputTimestampNs);
                     }
-                } else {
-                    sampleValue = 0.0f;
-                    // Ne pas réinitialiser la phase pour éviter les discontinuités
                 }
+            }
+        }
 
-                // Appliquer un effet stéréo léger pour les sons 8-bit
-                // Moduler le panoramique en fonction de la note et de la vélocité
-                float stereoPan = 0.5f + ((note.frequency - 440.0f) / 1500.0f) * note.velocity * 0.5f;
-                stereoPan = SDL_clamp(stereoPan, 0.3f, 0.7f); // Limiter l'effet stéréo
-
-                float leftVolume = 1.0f - (stereoPan * 0.3f);  // 0.79 à 0.91
-                float rightVolume = 0.7f + (stereoPan * 0.3f); // 0.79 à 0.91
-
-                // Appliquer un fondu pour éviter les discontinuités
-                float left_sample = sampleValue * leftVolume;
-                float right_sample = sampleValue * rightVolume;
-
-                // Crossfade très léger pour les sons 8-bit (pour préserver la netteté)
-                const float crossfade_factor = 0.05f;
-                left_sample = left_sample * (1.0f - crossfade_factor) + note.prevSampleLeft * crossfade_factor;
-                right_sample = right_sample * (1.0f - crossfade_factor) + note.prevSampleRight * crossfade_factor;
-
-                // Sauvegarder pour le prochain cycle
-                note.prevSampleLeft = left_sample;
-                note.prevSampleRight = right_sample;
-
-                // Convertir en échantillon 16 bits avec un gain adapté
-                int16_t left_int_sample = static_cast<int16_t>(SDL_clamp(left_sample * 32767.0f * 0.75f, -32767.0f,
-                                                                         32767.0f));
-                int16_t right_int_sample = static_cast<int16_t>(SDL_clamp(right_sample * 32767.0f * 0.75f, -32767.0f,
-                                                                          32767.0f));
+        void SDLAudioEngine::applyDueCommands() {
+            const Uint64 position = framePosition_.load(std::memory_order_relaxed);
+            AudioCommand command;
+            while (scheduledCommands_.popDue(position, command)) {
+                synthesizer_.applyCommand(command);
+            }
+        }
 
-                buffer[i] = left_int_sample;
-                buffer[i + 1] = right_int_sample;
+        const void *SDLAudioEngine::renderBlock(int numStereoSampleFrames) {
+            float *bus = synthesizer_.renderBlock(numStereoSampleFrames);
+            if (outputFormat_ == SDL_AUDIO_S16) {
+                synthesizer_.getOutputStage().convertToS16(bus, outputBuffer_.data(),
+                                                           static_cast<size_t>(numStereoSampleFrames) * 2);
+                return outputBuffer_.data();
             }
+            return bus;
         }
 
         void SDLAudioEngine::audioCallback(void *userdata, SDL_AudioStream *sdlStream, int additional_amount,
                                            int total_amount) {
             auto *engine = static_cast<SDLAudioEngine *>(userdata);
-            if (!engine || !engine->isInitialized_ || !engine->activeNotesMutex_) {
-                std::vector<uint8_t> silence(additional_amount, 0);
-                SDL_PutAudioStreamData(sdlStream, silence.data(), additional_amount);
+            if (!engine || !engine->isInitialized_) {
+                static const Uint8 silence[4096] = {};
+                while (additional_amount > 0) {
+                    int chunk = std::min(additional_amount, static_cast<int>(sizeof(silence)));
+                    SDL_PutAudioStreamData(sdlStream, silence, chunk);
+                    additional_amount -= chunk;
+                }
                 return;
             }
 
-            int stereoSampleFramesNeeded = additional_amount / (sizeof(int16_t) * 2);
-            if (stereoSampleFramesNeeded <= 0) return;
-
-            std::vector<int16_t> mixBuffer(stereoSampleFramesNeeded * 2, 0);
-
-            SDL_LockMutex(engine->activeNotesMutex_);
-
-            std::vector<std::string> notesToRemove;
-            for (auto &pair: engine->activeNotes_) {
-                ActiveNote &note = pair.second;
-
-                if (note.isPlaying || note.needsRelease) {
-                    std::vector<int16_t> noteChunkBuffer(stereoSampleFramesNeeded * 2);
-
-                    if (note.instrumentName == "Xylophone") {
-                        engine->generateXylophoneAudioChunk(note, noteChunkBuffer, stereoSampleFramesNeeded);
-                    } else if (note.instrumentName == "8BitConsole") {
-                        engine->generate8BitAudioChunk(note, noteChunkBuffer, stereoSampleFramesNeeded);
-                    } else {
-                        engine->generateAudioChunk(note, noteChunkBuffer, stereoSampleFramesNeeded);
-                    }
+            RealtimeAllocationTracker::Scope realtimeScope;
 
-                    for (size_t i = 0; i < mixBuffer.size(); ++i) {
-                        float mixed_sample = static_cast<float>(mixBuffer[i]) + static_cast<float>(noteChunkBuffer[i]);
-                        mixBuffer[i] = static_cast<int16_t>(SDL_clamp(mixed_sample, -32768.0f, 32767.0f));
-                    }
+            const int bytesPerFrame = (engine->outputFormat_ == SDL_AUDIO_S16 ? sizeof(int16_t) : sizeof(float)) * 2;
+            int stereoSampleFramesNeeded = additional_amount / bytesPerFrame;
+            if (stereoSampleFramesNeeded <= 0) return;
+            const Uint64 callbackStart = SDL_GetPerformanceCounter();
+            const Uint64 budgetNs = static_cast<Uint64>(stereoSampleFramesNeeded) * SDL_NS_PER_SECOND / getSampleRate();
+
+            // Les événements en attente sont appliqués au début de chaque bloc, sans jamais prendre de verrou
+            engine->drainCommands(SDL_GetTicksNS());
+
+            // Les tampons de travail sont préalloués : une demande plus grande que prévu est rendue en plusieurs fois.
+            // Un bloc s'arrête aussi à la prochaine commande datée, qui tombe ainsi exactement sur sa trame.
+            while (stereoSampleFramesNeeded > 0) {
+                engine->applyDueCommands();
+
+                int blockFrames = std::min(stereoSampleFramesNeeded, engine->synthesizer_.getMaxBlockFrames());
+                const Uint64 position = engine->framePosition_.load(std::memory_order_relaxed);
+                const Uint64 nextEventFrame = engine->scheduledCommands_.nextFrame();
+                if (nextEventFrame - position < static_cast<Uint64>(blockFrames)) {
+                    blockFrames = static_cast<int>(nextEventFrame - position);
+                }
 
-                    if (!note.isPlaying && !note.needsRelease) {
-                        notesToRemove.push_back(pair.first);
-                    }
+                const void *blockData = engine->renderBlock(blockFrames);
+                engine->framePosition_.store(position + blockFrames, std::memory_order_release);
+                if (!SDL_PutAudioStreamData(sdlStream, blockData, blockFrames * bytesPerFrame)) {
+                    std::cerr << "SDLAudioEngine::audioCallback: Failed to put audio stream data: " << SDL_GetError()
+                              << std::endl;
+                    return;
                 }
+                stereoSampleFramesNeeded -= blockFrames;
             }
 
-            for (const auto &noteId: notesToRemove) {
-                engine->activeNotes_.erase(noteId);
-                std::cout << "SDLAudioEngine: Removed note \'" << noteId << "\' from active list after release." <<
-                          std::endl;
-            }
+            const Uint64 renderTicks = SDL_GetPerformanceCounter() - callbackStart;
+            engine->metrics_.recordCallback(renderTicks * SDL_NS_PER_SECOND / engine->performanceFrequency_, budgetNs,
+                                            static_cast<Uint32>(engine->synthesizer_.getActiveVoiceCount()));
+        }
 
-            SDL_UnlockMutex(engine->activeNotesMutex_);
+        void SDLAudioEngine::setTuning(const TuningTable &table) {
+            std::atomic_store(&tuning_, std::shared_ptr<const TuningTable>(std::make_shared<TuningTable>(table)));
+            std::cout << "SDLAudioEngine: Tuning set to " << table.name << " (A4 = " << table.referenceFrequency
+                      << " Hz)." << std::endl;
+        }
 
-            if (SDL_PutAudioStreamData(sdlStream, mixBuffer.data(), additional_amount) < 0) {
-                std::cerr << "SDLAudioEngine::audioCallback: Failed to put audio stream data: " << SDL_GetError()
-                          << std::endl;
-            }
+        Uint64 SDLAudioEngine::getRealtimeAllocationCount() const {
+            return RealtimeAllocationTracker::allocationCount();
         }
 
         bool SDLAudioEngine::isNotePlaying(const std::string &instrumentName, const Core::Note &note) {
-            if (!isInitialized_ || !activeNotesMutex_) return false;
-            std::string noteId = instrumentName + "_" + note.pitchName;
-
-            SDL_LockMutex(activeNotesMutex_);
-            auto it = activeNotes_.find(noteId);
-            bool isCurrentlyPlaying = false;
-            if (it != activeNotes_.end()) {
-                isCurrentlyPlaying = (it->second.isPlaying || it->second.needsRelease);
-            }
-            SDL_UnlockMutex(activeNotesMutex_);
+            if (!isInitialized_ || !commandMutex_) return false;
+            const int pitchId = note.midiNumber;
+            if (!note.isValid()) return false;
+
+            SDL_LockMutex(commandMutex_);
+            bool isCurrentlyPlaying = heldNotes_.test(
+                    heldNoteIndex(Synthesizer::instrumentIdForName(instrumentName), static_cast<Uint8>(pitchId)));
+            SDL_UnlockMutex(commandMutex_);
             return isCurrentlyPlaying;
         }
 
         void SDLAudioEngine::cleanupLongPlayingNotes(Uint32 maxDurationMs) {
-            if (!isInitialized_ || !activeNotesMutex_) return;
+            if (!isInitialized_ || !commandMutex_) return;
 
             Uint32 currentTimeMs = SDL_GetTicks();
-            std::vector<std::pair<std::string, Core::Note>> notesToActuallyStop;
 
-            SDL_LockMutex(activeNotesMutex_);
-            for (auto const &[noteId, activeNote]: activeNotes_) {
-                if (activeNote.isPlaying && !activeNote.needsRelease) {
-                    if ((currentTimeMs - activeNote.systemStartTimeMs) > maxDurationMs) {
-                        notesToActuallyStop.push_back({activeNote.instrumentName, Core::Note(activeNote.pitchName)});
-                    }
+            SDL_LockMutex(commandMutex_);
+            for (std::size_t heldIndex = 0; heldIndex < heldNotes_.size(); ++heldIndex) {
+                if (heldNotes_.test(heldIndex) && (currentTimeMs - heldNoteStartMs_[heldIndex]) > maxDurationMs) {
+                    auto instrumentId = static_cast<InstrumentId>(heldIndex / PITCH_COUNT);
+                    auto pitchId = static_cast<Uint8>(heldIndex % PITCH_COUNT);
+                    std::cout << "SDLAudioEngine: Note " << static_cast<int>(pitchId)
+                              << " on instrument " << static_cast<int>(instrumentId)
+                              << " auto-stopped by cleanup after " << maxDurationMs << "ms" << std::endl;
+                    releaseHeldNote(instrumentId, pitchId);
                 }
             }
-            SDL_UnlockMutex(activeNotesMutex_);
-
-            for (const auto &item: notesToActuallyStop) {
-                std::cout << "SDLAudioEngine: Note \'" << item.second.pitchName
-                          << "\' on instrument \'" << item.first
-                          << "\' auto-stopped by cleanup after " << maxDurationMs << "ms" << std::endl;
-                stopSound(item.first, item.second);
-            }
+            SDL_UnlockMutex(commandMutex_);
         }
 
     } // namespace Audio
@@ -0,0 +1,171 @@
+#include "../../include/Audio/ScoreTextParser.h"
+#include "../../include/Audio/Synthesizer.h"
+#include "../../include/Core/Note.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string_view>
+
+namespace MusicApp {
+    namespace Audio {
+
+        namespace {
+            inline bool isBlank(char c) {
+                return c == ' ' || c == '\t' || c == '\v' || c == '\f';
+            }
+
+            inline const char *skipBlanks(const char *p, const char *end) {
+                while (p != end && isBlank(*p)) ++p;
+                return p;
+            }
+
+            inline const char *skipToken(const char *p, const char *end) {
+                while (p != end && !isBlank(*p)) ++p;
+                return p;
+            }
+        }
+
+        constexpr std::size_t ScoreTextParser::DEFAULT_CHUNK_EVENTS;
+        constexpr std::size_t ScoreTextParser::MAX_REPORTED_ERRORS;
+
+        bool ScoreTextParser::open(const std::string &filePath) {
+            reset(nullptr, 0);
+            if (!file_.open(filePath)) {
+                return false;
+            }
+            reset(reinterpret_cast<const char *>(file_.data()), file_.size());
+            return true;
+        }
+
+        void ScoreTextParser::reset(const char *data, std::size_t size) {
+            cursor_ = data;
+            end_ = data ? data + size : nullptr;
+            // Marque d'ordre d'octets UTF-8 laissée par certains éditeurs
+            if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+                cursor_ += 3;
+            }
+            line_ = 0;
+            elapsedSeconds_ = 0.0;
+            lengthFrames_ = 0;
+            errors_.clear();
+            errorCount_ = 0;
+        }
+
+        void ScoreTextParser::addError(std::size_t column, std::string message) {
+            ++errorCount_;
+            if (errors_.size() < MAX_REPORTED_ERRORS) {
+                errors_.push_back({line_, column, std::move(message)});
+            }
+        }
+
+        std::size_t ScoreTextParser::parseChunk(std::vector<ScoreEventRecord> &out, std::size_t maxEvents) {
+            const double sampleRate = Synthesizer::SAMPLE_RATE;
+            std::size_t produced = 0;
+
+            while (cursor_ != end_ && produced < maxEvents) {
+                const char *lineStart = cursor_;
+                const char *lineEnd = static_cast<const char *>(std::memchr(cursor_, '\n',
+                                                                            static_cast<std::size_t>(end_ - cursor_)));
+                if (lineEnd) {
+                    cursor_ = lineEnd + 1;
+                } else {
+                    lineEnd = end_;
+                    cursor_ = end_;
+                }
+                ++line_;
+                if (lineEnd != lineStart && lineEnd[-1] == '\r') {
+                    --lineEnd;
+                }
+
+                const char *pitchBegin = skipBlanks(lineStart, lineEnd);
+                if (pitchBegin == lineEnd) {
+                    continue; // Ligne vide
+                }
+                const char *pitchEnd = skipToken(pitchBegin, lineEnd);
+                const std::string_view pitch(pitchBegin, static_cast<std::size_t>(pitchEnd - pitchBegin));
+
+                const char *durationBegin = skipBlanks(pitchEnd, lineEnd);
+                if (durationBegin == lineEnd) {
+                    addError(static_cast<std::size_t>(pitchBegin - lineStart) + 1,
+                             "missing duration after '" + std::string(pitch) + "'");
+                    continue;
+                }
+                const char *durationEnd = skipToken(durationBegin, lineEnd);
+                const char *numberBegin = *durationBegin == '+' ? durationBegin + 1 : durationBegin;
+                float duration = 0.0f;
+                const std::from_chars_result parsed = std::from_chars(numberBegin, durationEnd, duration);
+                if (parsed.ec != std::errc() || parsed.ptr != durationEnd || !std::isfinite(duration) ||
+                    duration < 0.0f) {
+                    addError(static_cast<std::size_t>(durationBegin - lineStart) + 1,
+                             "invalid duration '" + std::string(durationBegin, durationEnd) + "'");
+                    continue;
+                }
+
+                // Comme l'ancien parseMusicFile, le reste de la ligne après la durée est ignoré (commentaires)
+
+                // Même placement que CompiledScore::fromMusicalEvents (le début est la fin arrondie de la ligne précédente)
+                const Uint64 startFrame = lengthFrames_;
+                elapsedSeconds_ += duration;
+                const Uint64 endFrame = static_cast<Uint64>(std::llround(elapsedSeconds_ * sampleRate));
+                lengthFrames_ = endFrame;
+
+                if (pitch == "0" || pitch == "Unknown") {
+                    continue; // Silence
+                }
+                const int midiNumber = Core::Note::parse(pitch);
+                if (midiNumber == Core::Note::INVALID) {
+                    addError(static_cast<std::size_t>(pitchBegin - lineStart) + 1,
+                             "unknown note '" + std::string(pitch) + "'");
+                    continue;
+                }
+
+                ScoreEventRecord record;
+                record.onsetFrame = static_cast<Uint32>(startFrame);
+                record.durationFrames = static_cast<Uint32>(endFrame - startFrame);
+                record.midiNumber = static_cast<Uint8>(midiNumber);
+                record.velocity = 127;
+                record.channel = 0;
+                record.reserved = 0;
+                out.push_back(record);
+                ++produced;
+            }
+            return produced;
+        }
+
+        ScoreTextParser::Result ScoreTextParser::parseBuffer(const char *data, std::size_t size) {
+            ScoreTextParser parser(data, size);
+            Result result;
+            result.events.reserve(size / 8); // "C4 0.5\n" : une note pour environ 7 octets
+            parser.parseChunk(result.events, std::numeric_limits<std::size_t>::max());
+            result.lengthFrames = parser.lengthFrames_;
+            result.lineCount = parser.line_;
+            result.errors = std::move(parser.errors_);
+            result.errorCount = parser.errorCount_;
+            result.opened = true;
+            return result;
+        }
+
+        ScoreTextParser::Result ScoreTextParser::parseFile(const std::string &filePath) {
+            MappedFile file;
+            if (!file.open(filePath)) {
+                return Result();
+            }
+            return parseBuffer(reinterpret_cast<const char *>(file.data()), file.size());
+        }
+
+        void ScoreTextParser::reportErrors(const std::string &sourceName, const std::vector<ScoreParseError> &errors,
+                                           std::size_t errorCount) {
+            for (const ScoreParseError &error: errors) {
+                std::cerr << sourceName << ':' << error.line << ':' << error.column << ": " << error.message
+                          << std::endl;
+            }
+            if (errorCount > errors.size()) {
+                std::cerr << sourceName << ": " << (errorCount - errors.size()) << " more errors not shown."
+                          << std::endl;
+            }
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
@@ -1,9 +1,17 @@
 #include "../../include/Audio/SongPlayer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 namespace MusicApp {
     namespace Audio {
         SongPlayer::SongPlayer(MusicApp::Audio::SDLAudioEngine *audioEngine)
             : audioEngine_(audioEngine),
+              sessionId_(audioEngine ? audioEngine->acquireSession() : LIVE_SESSION),
+              startEngineFrame_(0),
+              controlsChanged_(false),
+              heardTimeline_{0, 0, 0.0},
+              previousTimeline_{0, 0, 0.0},
               stopPlaybackSignal_(false),
               isCurrentlyPlaying_(false),
               isPaused_(false) {
@@ -23,41 +31,133 @@ namespace MusicApp {
         SongPlayer::~SongPlayer() {
             std::cout << "SongPlayer DESTRUCTOR: Entered." << std::endl;
             stopSong(); 
+            if (audioEngine_) {
+                audioEngine_->releaseSession(sessionId_);
+            }
             std::cout << "SongPlayer DESTRUCTOR: Exiting." << std::endl;
         }
 
-        bool SongPlayer::playSong(const std::vector<MusicalEvent>& events, const std::string& instrumentName) {
-            std::cout << "SongPlayer::playSong: Attempting to play song. Current isPlaying: " << isCurrentlyPlaying_.load() 
-                      << ", audioEngine_ address: " << audioEngine_ << std::endl;
+        bool SongPlayer::readyForNewSong() {
             if (isCurrentlyPlaying_.load()) { // Explicit load
                 std::cout << "SongPlayer: A song is already playing. Stop it first or wait for it to finish." << std::endl;
                 return false;
             }
             if (!audioEngine_) {
-                std::cerr << "SongPlayer FATAL ERROR: AudioEngine is not initialized at playSong entry (audioEngine_ is null). Cannot play song." << std::endl;
+                std::cerr << "SongPlayer FATAL ERROR: AudioEngine is not initialized (audioEngine_ is null). Cannot play song." << std::endl;
+                return false;
+            }
+            if (playbackThread_.joinable()) {
+                std::cout << "SongPlayer::playSong: Previous playback thread is joinable. Joining now..." << std::endl;
+                playbackThread_.join(); 
+                std::cout << "SongPlayer::playSong: Previous playback thread joined." << std::endl;
+            }
+            return true;
+        }
+
+        bool SongPlayer::playSong(std::shared_ptr<const Model::Score> score, Uint64 startEngineFrame) {
+            if (!readyForNewSong()) {
                 return false;
             }
-            std::cout << "SongPlayer::playSong: AudioEngine seems valid (not null)." << std::endl;
+            if (!score || score->empty()) {
+                std::cout << "SongPlayer: No events to play." << std::endl;
+                return false;
+            }
+            if (!score->isSorted()) {
+                std::cerr << "SongPlayer: The score must be sorted by onset before playback." << std::endl;
+                return false;
+            }
+
+            streamedScore_.reset();
+            streamingParser_.reset();
+            const std::string description = std::to_string(score->trackCount()) + " track(s)";
+            score_ = std::move(score);
+            return startPlayback(description, startEngineFrame);
+        }
+
+        bool SongPlayer::playSong(const std::vector<MusicalEvent>& events, const std::string& instrumentName) {
+            std::cout << "SongPlayer::playSong: Attempting to play song. Current isPlaying: " << isCurrentlyPlaying_.load() 
+                      << ", audioEngine_ address: " << audioEngine_ << std::endl;
             if (events.empty()) {
                 std::cout << "SongPlayer: No events to play." << std::endl;
                 return false;
             }
-            std::cout << "SongPlayer::playSong: Events list is not empty, size: " << events.size() << std::endl;
 
-            currentSongEvents_ = events; // Copy events
-            currentInstrumentName_ = instrumentName;
-            stopPlaybackSignal_ = false;
+            // Les notes sont analysées une seule fois, ici, en une partition datée en trames
+            Uint64 lengthFrames = 0;
+            const std::vector<ScoreEventRecord> records = CompiledScore::fromMusicalEvents(events, lengthFrames);
+            return playSong(std::make_shared<const Model::Score>(
+                    Model::Score::fromRecords(records.data(), records.size(), lengthFrames,
+                                              Synthesizer::instrumentIdForName(instrumentName))));
+        }
 
-            if (playbackThread_.joinable()) {
-                std::cout << "SongPlayer::playSong: Previous playback thread is joinable. Joining now..." << std::endl;
-                playbackThread_.join(); 
-                std::cout << "SongPlayer::playSong: Previous playback thread joined." << std::endl;
+        bool SongPlayer::playSong(const std::shared_ptr<const CompiledScore> &score, const std::string &instrumentName) {
+            if (!score || !score->isOpen()) {
+                std::cerr << "SongPlayer: Cannot play compiled score (score not open)." << std::endl;
+                return false;
+            }
+            return playSong(std::make_shared<const Model::Score>(
+                    Model::Score::fromRecords(score->events(), score->eventCount(), score->lengthFrames(),
+                                              Synthesizer::instrumentIdForName(instrumentName))));
+        }
+
+        bool SongPlayer::playScoreFile(const std::string &filePath, const std::string &instrumentName) {
+            if (!readyForNewSong()) {
+                return false;
+            }
+
+            auto parser = std::make_unique<ScoreTextParser>();
+            if (!parser->open(filePath)) {
+                return false;
+            }
+            auto score = std::make_shared<Model::Score>();
+            score->addTrack(filePath, Synthesizer::instrumentIdForName(instrumentName));
+            streamedScore_ = score;
+            score_ = score;
+            streamingParser_ = std::move(parser);
+            streamingPath_ = filePath;
+
+            // Seule la première tranche est lue avant de démarrer ; le thread de lecture lit la suite
+            while (score_->empty() && !streamingParser_->done()) {
+                streamNextChunk();
+            }
+            if (score_->empty()) {
+                std::cout << "SongPlayer: No events to play in " << filePath << std::endl;
+                streamingParser_.reset();
+                streamedScore_.reset();
+                score_.reset();
+                return false;
+            }
+            return startPlayback(filePath + " (" + instrumentName + ")");
+        }
+
+        void SongPlayer::streamNextChunk() {
+            streamChunk_.clear();
+            streamingParser_->parseChunk(streamChunk_);
+            streamedScore_->appendRecords(streamChunk_.data(), streamChunk_.size(), 0);
+            streamedScore_->setLengthFrames(streamingParser_->lengthFrames());
+            if (streamingParser_->done()) {
+                ScoreTextParser::reportErrors(streamingPath_, streamingParser_->errors(), streamingParser_->errorCount());
+            }
+        }
+
+        bool SongPlayer::startPlayback(const std::string &description, Uint64 startEngineFrame) {
+            currentSongDescription_ = description;
+            startEngineFrame_ = startEngineFrame;
+            stopPlaybackSignal_ = false;
+            {
+                // Chaque morceau repart du début, sans boucle ; le tempo choisi est conservé
+                std::lock_guard<std::mutex> lock(controlMutex_);
+                controls_.seekRequested = false;
+                controls_.loopStartFrame = 0;
+                controls_.loopEndFrame = 0;
+                controlsChanged_ = false;
+                heardTimeline_ = previousTimeline_ = {0, 0, 0.0};
             }
 
             try {
                 std::cout << "SongPlayer::playSong: Setting isCurrentlyPlaying_ to true." << std::endl;
                 isCurrentlyPlaying_ = true; 
-                std::cout << "SongPlayer::playSong: About to create new playback thread for instrument: " << currentInstrumentName_ << std::endl;
+                std::cout << "SongPlayer::playSong: About to create new playback thread for: " << currentSongDescription_ << std::endl;
                 playbackThread_ = std::thread(&SongPlayer::playbackLoop, this);
                 std::cout << "SongPlayer::playSong: Playback thread object created." << std::endl;
                 // Note: Thread starts executing immediately. Success here doesn't mean the thread function itself is error-free.
@@ -70,9 +170,17 @@ namespace MusicApp {
         }
 
         void SongPlayer::stopSong() {
-            if (isCurrentlyPlaying_ && playbackThread_.joinable()) {
-                std::cout << "SongPlayer: Signaling playback thread to stop..." << std::endl;
-                stopPlaybackSignal_ = true;
+            if (playbackThread_.joinable()) {
+                if (isCurrentlyPlaying_) {
+                    std::cout << "SongPlayer: Signaling playback thread to stop..." << std::endl;
+                    {
+                        // Sous le verrou : le thread ne peut pas manquer le réveil entre son test et son attente
+                        std::lock_guard<std::mutex> lock(controlMutex_);
+                        stopPlaybackSignal_ = true;
+                    }
+                    controlChanged_.notify_all();
+                }
+                // Un morceau fini tout seul laisse aussi un thread à joindre
                 playbackThread_.join();
                 std::cout << "SongPlayer: Playback thread stopped." << std::endl;
             }
@@ -94,7 +202,11 @@ namespace MusicApp {
                 std::cout << "SongPlayer: Cannot toggle pause, no song is playing." << std::endl;
                 return;
             }
-            isPaused_ = !isPaused_.load();
+            {
+                std::lock_guard<std::mutex> lock(controlMutex_);
+                isPaused_ = !isPaused_.load();
+            }
+            controlChanged_.notify_all();
             if (isPaused_.load()) {
                 std::cout << "SongPlayer: Playback PAUSED." << std::endl;
             } else {
@@ -102,8 +214,141 @@ namespace MusicApp {
             }
         }
 
+        constexpr float SongPlayer::MIN_PLAYBACK_RATE;
+        constexpr float SongPlayer::MAX_PLAYBACK_RATE;
+        constexpr double SongPlayer::MIN_LOOP_SECONDS;
+
+        void SongPlayer::seek(double seconds) {
+            {
+                std::lock_guard<std::mutex> lock(controlMutex_);
+                controls_.seekRequested = true;
+                controls_.seekFrame = seconds > 0.0 ? static_cast<Uint64>(std::llround(seconds * SDLAudioEngine::getSampleRate()))
+                                                    : 0;
+                controlsChanged_ = true;
+            }
+            controlChanged_.notify_all();
+        }
+
+        double SongPlayer::getPositionSeconds() const {
+            if (!isCurrentlyPlaying_.load() || !audioEngine_) return 0.0;
+            // Calculée à la demande depuis l'horloge du moteur : le thread de lecture n'a pas à se réveiller pour ça
+            const Uint64 engineFrame = audioEngine_->getFramePosition();
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            return static_cast<double>(songPositionAt(heardTimeline_, previousTimeline_, engineFrame)) /
+                   SDLAudioEngine::getSampleRate();
+        }
+
+        bool SongPlayer::setLoopRegion(double startSeconds, double endSeconds) {
+            startSeconds = std::max(0.0, startSeconds);
+            if (endSeconds - startSeconds < MIN_LOOP_SECONDS) {
+                std::cerr << "SongPlayer: Loop region [" << startSeconds << " s, " << endSeconds
+                          << " s) is too short." << std::endl;
+                return false;
+            }
+            {
+                std::lock_guard<std::mutex> lock(controlMutex_);
+                controls_.loopStartFrame = static_cast<Uint64>(std::llround(startSeconds * SDLAudioEngine::getSampleRate()));
+                controls_.loopEndFrame = static_cast<Uint64>(std::llround(endSeconds * SDLAudioEngine::getSampleRate()));
+                controlsChanged_ = true;
+            }
+            controlChanged_.notify_all();
+            return true;
+        }
+
+        void SongPlayer::clearLoopRegion() {
+            {
+                std::lock_guard<std::mutex> lock(controlMutex_);
+                controls_.loopStartFrame = 0;
+                controls_.loopEndFrame = 0;
+                controlsChanged_ = true;
+            }
+            controlChanged_.notify_all();
+        }
+
+        bool SongPlayer::hasLoopRegion() const {
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            return controls_.loopEndFrame > controls_.loopStartFrame;
+        }
+
+        void SongPlayer::setPlaybackRate(float rate) {
+            {
+                std::lock_guard<std::mutex> lock(controlMutex_);
+                controls_.rate = std::min(MAX_PLAYBACK_RATE, std::max(MIN_PLAYBACK_RATE, rate));
+                controlsChanged_ = true;
+            }
+            controlChanged_.notify_all();
+        }
+
+        float SongPlayer::getPlaybackRate() const {
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            return static_cast<float>(controls_.rate);
+        }
+
+        SongPlayer::TransportControls SongPlayer::readControls() {
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            TransportControls controls = controls_;
+            controls_.seekRequested = false; // Une demande de saut n'est appliquée qu'une fois
+            controlsChanged_ = false;
+            return controls;
+        }
+
+        Uint64 SongPlayer::songPositionAt(const Timeline &current, const Timeline &previous, Uint64 engineFrame) {
+            const bool wrapPending = engineFrame < current.anchorEngineFrame &&
+                                     previous.anchorEngineFrame < current.anchorEngineFrame;
+            return wrapPending ? previous.songFrameAt(engineFrame) : current.songFrameAt(engineFrame);
+        }
+
+        void SongPlayer::publishTimeline(const Timeline &current, const Timeline &previous) {
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            heardTimeline_ = current;
+            previousTimeline_ = previous;
+        }
+
+        Uint64 SongPlayer::Timeline::engineFrameFor(Uint64 songFrame) const {
+            const double frame = static_cast<double>(anchorEngineFrame) +
+                                 (static_cast<double>(songFrame) - static_cast<double>(anchorSongFrame)) / rate;
+            return frame > 0.0 ? static_cast<Uint64>(std::llround(frame)) : 0;
+        }
+
+        Uint64 SongPlayer::Timeline::songFrameAt(Uint64 engineFrame) const {
+            if (engineFrame <= anchorEngineFrame) return anchorSongFrame;
+            return anchorSongFrame + static_cast<Uint64>(std::llround(static_cast<double>(engineFrame - anchorEngineFrame) * rate));
+        }
+
+        constexpr Uint32 SongPlayer::LOOKAHEAD_MS;
+        constexpr Uint32 SongPlayer::START_LATENCY_MS;
+        constexpr Uint32 SongPlayer::MAX_SCHEDULER_SLEEP_MS;
+        constexpr size_t SongPlayer::STREAM_REFILL_EVENTS;
+
+        void SongPlayer::silenceSongNotes(Uint64 songPosition, size_t scheduledCount) {
+            audioEngine_->cancelScheduledEvents(sessionId_);
+            // Seules les notes commencées avant songPosition et pas encore finies sont à relâcher
+            const Model::Score &score = *score_;
+            for (size_t i = score.seek(songPosition).firstActive; i < scheduledCount; ++i) {
+                if (score.onsetFrame(i) > songPosition) break;
+                if (score.endFrame(i) > songPosition) {
+                    audioEngine_->scheduleNoteOff(score.instrument(i), score.midiNumber(i), 0, sessionId_);
+                }
+            }
+        }
+
+        size_t SongPlayer::rescheduleFrom(const Timeline &timeline, Uint64 songPosition, size_t scheduledCount,
+                                          Uint64 loopEndFrame) {
+            audioEngine_->cancelScheduledEvents(sessionId_);
+            const Model::Score &score = *score_;
+            const size_t firstUnstarted = std::min(score.seek(songPosition + 1).next, scheduledCount);
+            for (size_t i = score.seek(songPosition).firstActive; i < firstUnstarted; ++i) {
+                const Uint64 endFrame = loopEndFrame > 0 ? std::min(score.endFrame(i), loopEndFrame) : score.endFrame(i);
+                if (endFrame > songPosition) {
+                    audioEngine_->scheduleNoteOff(score.instrument(i), score.midiNumber(i),
+                                                  timeline.engineFrameFor(endFrame), sessionId_);
+                }
+            }
+            return firstUnstarted;
+        }
+
         void SongPlayer::playbackLoop() {
-            std::cout << "SongPlayer: Playback loop entered for instrument: " << currentInstrumentName_ << " with " << currentSongEvents_.size() << " events." << std::endl;
+            std::cout << "SongPlayer: Playback loop entered for " << currentSongDescription_ << " with " << score_->size() << " events." << std::endl;
 
             if (!audioEngine_) {
                 std::cerr << "SongPlayer FATAL ERROR: audioEngine_ is null at the start of playbackLoop! Aborting loop." << std::endl;
@@ -111,62 +356,171 @@ namespace MusicApp {
                 return;
             }
 
-            for (size_t i = 0; i < currentSongEvents_.size(); ++i) {
-                const auto& event = currentSongEvents_[i];
-                std::cout << "SongPlayer: Processing event " << i << ": Note '" << event.pitchName << "', Duration " << event.durationSeconds << std::endl;
+            // Les notes sont datées en trames sur l'horloge du moteur et transmises un peu en avance :
+            // le callback les déclenche à l'échantillon près, sans dépendre de la précision du réveil de ce thread
+            const Uint64 framesPerMs = SDLAudioEngine::getSampleRate() / 1000;
+            const Uint64 lookaheadFrames = LOOKAHEAD_MS * framesPerMs;
+            const Uint64 startLatencyFrames = START_LATENCY_MS * framesPerMs;
+            const Uint64 minLoopFrames = static_cast<Uint64>(MIN_LOOP_SECONDS * SDLAudioEngine::getSampleRate());
+            const Model::Score &score = *score_;
 
-                while (isPaused_.load()) {
-                    if (stopPlaybackSignal_) break;
-                    SDL_Delay(50);
-                }
+            TransportControls applied = readControls();
+            // Premier son à la trame demandée (plusieurs joueurs calés ensemble), sinon START_LATENCY_MS après maintenant
+            const Uint64 clockAtStart = audioEngine_->getFramePosition();
+            const Uint64 firstFrame = startEngineFrame_ > 0 ? std::max(startEngineFrame_, clockAtStart)
+                                                            : clockAtStart + startLatencyFrames;
+            Timeline timeline{firstFrame, 0, applied.rate};
+            // Passage précédent de la boucle : c'est lui qu'on entend tant que le retour au point A n'a pas sonné
+            Timeline previous = timeline;
+            size_t nextNote = 0;
+            publishTimeline(timeline, previous);
 
-                if (stopPlaybackSignal_) {
-                    std::cout << "SongPlayer: Stop signal received in playback loop (before processing event " << i << ")." << std::endl;
-                    break;
+            auto positionAt = [&](Uint64 engineFrame) {
+                return songPositionAt(timeline, previous, engineFrame);
+            };
+            auto isStreaming = [&]() {
+                return streamingParser_ && !streamingParser_->done();
+            };
+            // Fin de boucle effective (0 sans boucle), bornée à la durée du morceau quand elle est connue
+            auto loopEndFor = [&](const TransportControls &controls) -> Uint64 {
+                if (controls.loopEndFrame <= controls.loopStartFrame) return 0;
+                const Uint64 loopEnd = isStreaming() ? controls.loopEndFrame
+                                                     : std::min(controls.loopEndFrame, score.lengthFrames());
+                return loopEnd >= controls.loopStartFrame + minLoopFrames ? loopEnd : 0;
+            };
+            // Un saut au-delà de ce qui a été lu d'une partition en flux termine d'abord la lecture jusque-là
+            auto seekTarget = [&](Uint64 frame) {
+                while (isStreaming() && streamedScore_->lengthFrames() <= frame) {
+                    streamNextChunk();
                 }
+                return std::min(frame, score.lengthFrames());
+            };
 
-                int delayMilliseconds = static_cast<int>(event.durationSeconds * 1000.0f);
+            while (!stopPlaybackSignal_) {
+                if (isPaused_.load()) {
+                    // Couper ce qui sonne et oublier ce qui était programmé, puis reprendre au même endroit du morceau
+                    Uint64 songPosition = positionAt(audioEngine_->getFramePosition());
+                    silenceSongNotes(songPosition, nextNote);
+                    const Timeline frozen{0, songPosition, 0.0};
+                    publishTimeline(frozen, frozen);
 
-                if (event.pitchName != "0" && !event.pitchName.empty()) {
-                    std::cout << "SongPlayer: Playing note '" << event.pitchName << "'" << std::endl;
-                    MusicApp::Core::Note noteToPlay(event.pitchName);
-                    
-                    audioEngine_->playSound(currentInstrumentName_, noteToPlay, 1.0f); // Default velocity
-                    std::cout << "SongPlayer: Note '" << event.pitchName << "' sound played command sent." << std::endl;
+                    // Aucun réveil pendant la pause, sauf pour reprendre, arrêter ou déplacer la position
+                    while (true) {
+                        {
+                            std::unique_lock<std::mutex> lock(controlMutex_);
+                            controlChanged_.wait(lock, [this] {
+                                return !isPaused_.load() || stopPlaybackSignal_.load() || controlsChanged_;
+                            });
+                            if (!isPaused_.load() || stopPlaybackSignal_.load()) break;
+                        }
+                        const TransportControls controls = readControls();
+                        if (controls.seekRequested) {
+                            songPosition = seekTarget(controls.seekFrame);
+                            const Timeline moved{0, songPosition, 0.0};
+                            publishTimeline(moved, moved);
+                        }
+                    }
+                    if (stopPlaybackSignal_) break;
 
-                    if (delayMilliseconds > 0) {
-                        std::cout << "SongPlayer: Delaying for " << delayMilliseconds << " ms for note '" << event.pitchName << "'" << std::endl;
-                        SDL_Delay(delayMilliseconds);
-                        std::cout << "SongPlayer: Delay finished for note '" << event.pitchName << "'" << std::endl;
+                    applied = readControls();
+                    if (applied.seekRequested) {
+                        songPosition = seekTarget(applied.seekFrame);
                     }
+                    timeline = {audioEngine_->getFramePosition() + startLatencyFrames, songPosition, applied.rate};
+                    previous = timeline;
+                    publishTimeline(timeline, previous);
+                    nextNote = score.seek(songPosition).next;
+                    continue;
+                }
+
+                const Uint64 now = audioEngine_->getFramePosition();
+                const TransportControls controls = readControls();
+                if (controls.seekRequested) {
+                    // Saut : recherche dichotomique dans la partition, pas de relecture depuis le début
+                    const Uint64 target = seekTarget(controls.seekFrame);
+                    silenceSongNotes(positionAt(now), nextNote);
+                    timeline = {now + startLatencyFrames, target, controls.rate};
+                    previous = timeline;
+                    publishTimeline(timeline, previous);
+                    nextNote = score.seek(target).next;
+                } else if (controls.rate != applied.rate || controls.loopStartFrame != applied.loopStartFrame ||
+                           controls.loopEndFrame != applied.loopEndFrame) {
+                    // Nouveau tempo ou nouvelle boucle : on repart de la position entendue, les notes tenues continuent
+                    const Uint64 position = positionAt(now);
+                    const bool inStartLatency = now < timeline.anchorEngineFrame &&
+                                                previous.anchorEngineFrame == timeline.anchorEngineFrame;
+                    timeline = {inStartLatency ? timeline.anchorEngineFrame : now, position, controls.rate};
+                    previous = timeline;
+                    publishTimeline(timeline, previous);
+                    nextNote = rescheduleFrom(timeline, position, nextNote, loopEndFor(controls));
+                }
+                applied = controls;
+
+                if (isStreaming() && score.size() - nextNote < STREAM_REFILL_EVENTS) {
+                    streamNextChunk();
+                }
+                const bool streaming = isStreaming();
+                const Uint64 loopEnd = loopEndFor(applied);
 
-                    if (stopPlaybackSignal_) { 
-                        std::cout << "SongPlayer: Stop signal received after delay for note '" << event.pitchName << "'. Stopping sound." << std::endl;
-                        audioEngine_->stopSound(currentInstrumentName_, noteToPlay);
+                const Uint64 horizon = now + lookaheadFrames;
+                Uint64 wakeFrame = 0; // Trame moteur à laquelle le prochain événement entre dans la fenêtre
+                while (true) {
+                    if (nextNote < score.size() && (loopEnd == 0 || score.onsetFrame(nextNote) < loopEnd)) {
+                        const Uint64 onFrame = timeline.engineFrameFor(score.onsetFrame(nextNote));
+                        if (onFrame >= horizon) {
+                            wakeFrame = onFrame - lookaheadFrames;
+                            break;
+                        }
+                        // En boucle, une note tenue au-delà du point B s'arrête au retour au point A
+                        const Uint64 endFrame = loopEnd > 0 ? std::min(score.endFrame(nextNote), loopEnd)
+                                                            : score.endFrame(nextNote);
+                        const InstrumentId instrument = score.instrument(nextNote);
+                        const Uint8 midiNumber = score.midiNumber(nextNote);
+                        audioEngine_->scheduleNoteOn(instrument, midiNumber, score.velocity(nextNote) / 127.0f, onFrame,
+                                                     sessionId_);
+                        audioEngine_->scheduleNoteOff(instrument, midiNumber,
+                                                      std::max(onFrame, timeline.engineFrameFor(endFrame)), sessionId_);
+                        ++nextNote;
+                        continue;
+                    }
+                    if (loopEnd == 0) {
+                        // Plus rien à programmer : on attend la fin du morceau (ou le prochain bloc lu en flux)
+                        wakeFrame = streaming ? now : timeline.engineFrameFor(score.lengthFrames());
                         break;
                     }
-                    std::cout << "SongPlayer: Stopping note '" << event.pitchName << "'" << std::endl;
-                    audioEngine_->stopSound(currentInstrumentName_, noteToPlay);
-                    std::cout << "SongPlayer: Note '" << event.pitchName << "' sound stopped command sent." << std::endl;
-
-                } else { // Silence
-                    std::cout << "SongPlayer: Processing silence for " << delayMilliseconds << " ms." << std::endl;
-                    if (delayMilliseconds > 0) {
-                        SDL_Delay(delayMilliseconds);
+                    if (streaming && nextNote == score.size()) {
+                        wakeFrame = now;
+                        break;
                     }
-                    std::cout << "SongPlayer: Silence finished." << std::endl;
+
+                    // Retour au point A, programmé à la trame près comme les notes
+                    const Uint64 wrapFrame = timeline.engineFrameFor(loopEnd);
+                    if (wrapFrame >= horizon) {
+                        wakeFrame = wrapFrame - lookaheadFrames;
+                        break;
+                    }
+                    previous = timeline;
+                    timeline = {wrapFrame, applied.loopStartFrame, timeline.rate};
+                    publishTimeline(timeline, previous);
+                    nextNote = score.seek(applied.loopStartFrame).next;
                 }
 
-                if (stopPlaybackSignal_) {
-                     std::cout << "SongPlayer: Stop signal received after event " << i << " processing." << std::endl;
-                    break; 
+                if (!streaming && loopEnd == 0 && nextNote == score.size() &&
+                    now >= timeline.engineFrameFor(score.lengthFrames())) {
+                    break;
                 }
-                std::cout << "SongPlayer: Inter-event delay (10ms)." << std::endl;
-                SDL_Delay(10); 
-                std::cout << "SongPlayer: Inter-event delay finished." << std::endl;
+
+                // Sommeil jusqu'à l'échéance, interrompu aussitôt par stop, pause, saut, boucle ou tempo
+                const Uint64 sleepMs = std::min<Uint64>(MAX_SCHEDULER_SLEEP_MS,
+                                                        std::max<Uint64>(1, (wakeFrame > now ? wakeFrame - now : 0) / framesPerMs));
+                std::unique_lock<std::mutex> lock(controlMutex_);
+                controlChanged_.wait_for(lock, std::chrono::milliseconds(sleepMs), [this] {
+                    return stopPlaybackSignal_.load() || isPaused_.load() || controlsChanged_;
+                });
             }
 
             if (stopPlaybackSignal_) {
+                silenceSongNotes(positionAt(audioEngine_->getFramePosition()), nextNote);
                 std::cout << "SongPlayer: Playback loop terminated by stop signal." << std::endl;
             }
             else {
@@ -0,0 +1,150 @@
+#include "../../include/Audio/SongSessionManager.h"
+#include <algorithm>
+#include <iostream>
+
+namespace MusicApp {
+    namespace Audio {
+
+        constexpr float SongSessionManager::MAX_GAIN;
+        constexpr Uint32 SongSessionManager::SYNC_START_MS;
+
+        SongSessionManager::SongSessionManager(SDLAudioEngine *audioEngine) : audioEngine_(audioEngine) {
+        }
+
+        SongSessionManager::~SongSessionManager() {
+            stopAll();
+        }
+
+        int SongSessionManager::createSession(const std::string &name) {
+            if (!audioEngine_) {
+                std::cerr << "SongSessionManager: No audio engine, cannot open session '" << name << "'." << std::endl;
+                return -1;
+            }
+            std::unique_ptr<SongPlayer> player(new SongPlayer(audioEngine_));
+            if (player->getSessionId() == LIVE_SESSION) {
+                // Plus de session moteur : ses notes se mêleraient au jeu en direct
+                std::cerr << "SongSessionManager: Cannot open session '" << name << "'." << std::endl;
+                return -1;
+            }
+
+            std::unique_ptr<Session> session(new Session());
+            session->name = name;
+            session->player = std::move(player);
+            sessions_.push_back(std::move(session));
+            updateGains();
+            return static_cast<int>(sessions_.size() - 1);
+        }
+
+        void SongSessionManager::removeSession(int session) {
+            if (!find(session)) return;
+            sessions_[session].reset(); // Le destructeur du SongPlayer arrête la lecture et rend la session moteur
+            updateGains();
+        }
+
+        std::size_t SongSessionManager::sessionCount() const {
+            return static_cast<std::size_t>(std::count_if(sessions_.begin(), sessions_.end(),
+                                                          [](const std::unique_ptr<Session> &s) { return s != nullptr; }));
+        }
+
+        SongPlayer *SongSessionManager::player(int session) {
+            Session *entry = find(session);
+            return entry ? entry->player.get() : nullptr;
+        }
+
+        std::string SongSessionManager::getName(int session) const {
+            const Session *entry = find(session);
+            return entry ? entry->name : std::string();
+        }
+
+        void SongSessionManager::setGain(int session, float gain) {
+            Session *entry = find(session);
+            if (!entry) return;
+            entry->gain = std::min(MAX_GAIN, std::max(0.0f, gain));
+            updateGains();
+        }
+
+        float SongSessionManager::getGain(int session) const {
+            const Session *entry = find(session);
+            return entry ? entry->gain : 0.0f;
+        }
+
+        void SongSessionManager::setMuted(int session, bool muted) {
+            Session *entry = find(session);
+            if (!entry) return;
+            entry->muted = muted;
+            updateGains();
+        }
+
+        bool SongSessionManager::isMuted(int session) const {
+            const Session *entry = find(session);
+            return entry && entry->muted;
+        }
+
+        void SongSessionManager::setSolo(int session, bool solo) {
+            Session *entry = find(session);
+            if (!entry) return;
+            entry->solo = solo;
+            updateGains();
+        }
+
+        bool SongSessionManager::isSolo(int session) const {
+            const Session *entry = find(session);
+            return entry && entry->solo;
+        }
+
+        std::vector<int> SongSessionManager::playTracks(const std::shared_ptr<const Model::Score> &score) {
+            std::vector<int> opened;
+            if (!score || !audioEngine_) return opened;
+            if (!score->isSorted()) {
+                std::cerr << "SongSessionManager: The score must be sorted by onset before playback." << std::endl;
+                return opened;
+            }
+
+            // Découpage avant de dater le départ : il peut prendre du temps sur une grosse partition
+            std::vector<Model::Score> parts = score->splitByTrack();
+            const Uint64 startFrame = audioEngine_->getFramePosition() +
+                                      static_cast<Uint64>(SYNC_START_MS) * SDLAudioEngine::getSampleRate() / 1000;
+
+            for (Model::Score &part: parts) {
+                if (part.empty()) continue;
+                const std::string name = part.track(0).name;
+                const int session = createSession(name);
+                if (session < 0) break;
+                if (!player(session)->playSong(std::make_shared<const Model::Score>(std::move(part)), startFrame)) {
+                    removeSession(session);
+                    continue;
+                }
+                opened.push_back(session);
+            }
+            std::cout << "SongSessionManager: Playing " << opened.size() << " track(s) in parallel." << std::endl;
+            return opened;
+        }
+
+        void SongSessionManager::stopAll() {
+            for (std::unique_ptr<Session> &session: sessions_) {
+                if (session) session->player->stopSong();
+            }
+        }
+
+        SongSessionManager::Session *SongSessionManager::find(int session) {
+            if (session < 0 || static_cast<std::size_t>(session) >= sessions_.size()) return nullptr;
+            return sessions_[session].get();
+        }
+
+        const SongSessionManager::Session *SongSessionManager::find(int session) const {
+            if (session < 0 || static_cast<std::size_t>(session) >= sessions_.size()) return nullptr;
+            return sessions_[session].get();
+        }
+
+        void SongSessionManager::updateGains() {
+            const bool anySolo = std::any_of(sessions_.begin(), sessions_.end(),
+                                             [](const std::unique_ptr<Session> &s) { return s && s->solo; });
+            for (const std::unique_ptr<Session> &session: sessions_) {
+                if (!session) continue;
+                const bool audible = !session->muted && (!anySolo || session->solo);
+                audioEngine_->setSessionGain(session->player->getSessionId(), audible ? session->gain : 0.0f);
+            }
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
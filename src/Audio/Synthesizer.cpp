@@ -0,0 +1,138 @@
+#include "../../include/Audio/Synthesizer.h"
+#include "../../include/Instruments/PianoInstrument.h"
+#include "../../include/Instruments/XylophoneInstrument.h"
+#include "../../include/Instruments/SimpleSynthInstrument.h"
+#include "../../include/Instruments/GuitarInstrument.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+namespace MusicApp {
+    namespace Audio {
+
+        constexpr int Synthesizer::DEFAULT_MAX_BLOCK_FRAMES;
+
+        Synthesizer::Synthesizer(std::size_t polyphony)
+                : maxBlockFrames_(0), voicePool_(polyphony) {
+            sessionGains_.fill(1.0f);
+            // Les tables d'onde et le choix des noyaux SIMD sont faits ici, jamais pendant le rendu
+            Wavetables::prepare();
+            MixKernels::prepare();
+            setMaxBlockFrames(DEFAULT_MAX_BLOCK_FRAMES);
+
+            registerGenerator(InstrumentId::Piano, std::unique_ptr<VoiceGenerator>(new Instruments::PianoInstrument()));
+            registerGenerator(InstrumentId::Xylophone,
+                              std::unique_ptr<VoiceGenerator>(new Instruments::XylophoneInstrument()));
+            registerGenerator(InstrumentId::Chiptune8Bit,
+                              std::unique_ptr<VoiceGenerator>(new Instruments::SimpleSynthInstrument()));
+            registerGenerator(InstrumentId::Guitar, std::unique_ptr<VoiceGenerator>(new Instruments::GuitarInstrument()));
+        }
+
+        void Synthesizer::registerGenerator(InstrumentId instrumentId, std::unique_ptr<VoiceGenerator> generator) {
+            const std::size_t index = static_cast<std::size_t>(instrumentId);
+            if (index >= INSTRUMENT_COUNT || !generator) {
+                std::cerr << "Synthesizer: Invalid voice generator registration for instrument "
+                          << static_cast<int>(instrumentId) << "." << std::endl;
+                return;
+            }
+            generators_[index] = std::move(generator);
+        }
+
+        VoiceGenerator &Synthesizer::generatorFor(InstrumentId instrumentId) {
+            const std::size_t index = static_cast<std::size_t>(instrumentId);
+            // Sans générateur propre (ou identifiant hors bornes), une voix prend le timbre du piano
+            if (index < INSTRUMENT_COUNT && generators_[index]) return *generators_[index];
+            return *generators_[static_cast<std::size_t>(InstrumentId::Piano)];
+        }
+
+        void Synthesizer::setMaxBlockFrames(int frames) {
+            maxBlockFrames_ = std::max(1, frames);
+            mixBuffer_.assign(static_cast<size_t>(maxBlockFrames_) * 2, 0.0f);
+            envelopeBuffer_.assign(static_cast<size_t>(maxBlockFrames_), 0.0f);
+            voiceBuffer_.assign(static_cast<size_t>(maxBlockFrames_), 0.0f);
+        }
+
+        float Synthesizer::frequencyForNote(const std::string &pitchName) {
+            const float frequency = Core::PitchTable::frequency(Core::Note::parse(pitchName));
+            if (frequency <= 0.0f) {
+                std::cerr << "Synthesizer: Frequency for note \'" << pitchName
+                          << "\' not found. Defaulting to 0 Hz (silence)." << std::endl;
+            }
+            return frequency;
+        }
+
+        InstrumentId Synthesizer::instrumentIdForName(const std::string &instrumentName) {
+            if (instrumentName == "Xylophone") {
+                return InstrumentId::Xylophone;
+            }
+            if (instrumentName == "8BitConsole" || instrumentName == "Synth") {
+                return InstrumentId::Chiptune8Bit;
+            }
+            if (instrumentName == "Guitar") {
+                return InstrumentId::Guitar;
+            }
+            return InstrumentId::Piano;
+        }
+
+        int Synthesizer::pitchIdForNote(const std::string &pitchName) {
+            return Core::Note::parse(pitchName);
+        }
+
+        void Synthesizer::applyCommand(const AudioCommand &command) {
+            switch (command.type) {
+                case AudioCommand::Type::NoteOn: {
+                    ActiveNote &voice = voicePool_.allocate(command.instrumentId, command.pitchId, command.sessionId);
+                    voice.frequency = command.frequency;
+                    voice.isPlaying = true;
+                    voice.systemStartTimeMs = command.systemStartTimeMs;
+                    voice.velocity = command.velocity;
+                    generatorFor(voice.instrumentId).prepare(voice);
+                    break;
+                }
+                case AudioCommand::Type::NoteOff: {
+                    ActiveNote *voice = voicePool_.find(command.instrumentId, command.pitchId, command.sessionId);
+                    if (voice && voicePool_.releaseHeldNote(*voice)) {
+                        generatorFor(voice->instrumentId).release(*voice);
+                    }
+                    break;
+                }
+                case AudioCommand::Type::Velocity: {
+                    ActiveNote *voice = voicePool_.find(command.instrumentId, command.pitchId, command.sessionId);
+                    if (voice && voice->isPlaying) {
+                        voice->velocity = command.velocity;
+                    }
+                    break;
+                }
+                case AudioCommand::Type::SessionGain:
+                    sessionGains_[command.sessionId % MAX_SESSIONS] = std::max(0.0f, command.velocity);
+                    break;
+                case AudioCommand::Type::ClearScheduled:
+                    break;
+            }
+        }
+
+        float *Synthesizer::renderBlock(int numStereoSampleFrames) {
+            const size_t numSamples = static_cast<size_t>(numStereoSampleFrames) * 2;
+            float *bus = mixBuffer_.data();
+            std::fill(bus, bus + numSamples, 0.0f);
+            const VoiceScratch scratch = {envelopeBuffer_.data(), voiceBuffer_.data()};
+
+            for (ActiveNote &note: voicePool_) {
+                if (!note.isActive()) continue;
+
+                VoiceGenerator &generator = generatorFor(note.instrumentId);
+                generator.renderBlock(note, bus, numStereoSampleFrames, sessionGains_[note.sessionId % MAX_SESSIONS],
+                                      scratch);
+                // Une voix dont le relâchement est terminé (ou que son générateur déclare éteinte) redevient libre
+                if (note.isActive() && generator.isFinished(note)) {
+                    note.isPlaying = false;
+                    note.needsRelease = false;
+                }
+            }
+
+            outputStage_.softClip(bus, numSamples);
+            return bus;
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
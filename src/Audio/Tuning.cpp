@@ -0,0 +1,185 @@
+#include "../../include/Audio/Tuning.h"
+#include "../../include/Core/PitchTable.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace MusicApp {
+    namespace Audio {
+        namespace Tunings {
+
+            namespace {
+                float validReference(float referenceFrequency) {
+                    if (!(referenceFrequency > 0.0f) || !std::isfinite(referenceFrequency)) {
+                        std::cerr << "Tunings: Invalid reference frequency " << referenceFrequency << " Hz, using "
+                                  << DEFAULT_REFERENCE_FREQUENCY << " Hz." << std::endl;
+                        return DEFAULT_REFERENCE_FREQUENCY;
+                    }
+                    return referenceFrequency;
+                }
+
+                // Rapport d'une note à la tonique : degré dans la gamme, puis autant de périodes que nécessaire
+                double ratioFromTonic(const std::vector<double> &ratios, int tonic, int midiNumber) {
+                    const int degreeCount = static_cast<int>(ratios.size());
+                    const int offset = midiNumber - tonic;
+                    int periods = offset / degreeCount;
+                    int degree = offset % degreeCount;
+                    if (degree < 0) {
+                        degree += degreeCount;
+                        --periods;
+                    }
+                    const double degreeRatio = degree == 0 ? 1.0 : ratios[degree - 1];
+                    return std::pow(ratios.back(), periods) * degreeRatio;
+                }
+
+                // Un degré Scala : cents s'il contient un point, rapport sinon ("3/2" ou "2"). 0 si invalide.
+                double parseScalaPitch(const std::string &token) {
+                    char *end = nullptr;
+                    if (token.find('.') != std::string::npos) {
+                        const double cents = std::strtod(token.c_str(), &end);
+                        if (end == token.c_str() || *end != '\0') return 0.0;
+                        return std::pow(2.0, cents / 1200.0);
+                    }
+
+                    const size_t slash = token.find('/');
+                    const std::string numeratorText = token.substr(0, slash);
+                    const double numerator = std::strtod(numeratorText.c_str(), &end);
+                    if (numeratorText.empty() || *end != '\0') return 0.0;
+                    double denominator = 1.0;
+                    if (slash != std::string::npos) {
+                        const std::string denominatorText = token.substr(slash + 1);
+                        denominator = std::strtod(denominatorText.c_str(), &end);
+                        if (denominatorText.empty() || *end != '\0' || denominator <= 0.0) return 0.0;
+                    }
+                    return numerator > 0.0 ? numerator / denominator : 0.0;
+                }
+
+                // Prochaine ligne qui n'est pas un commentaire Scala ('!')
+                bool nextScalaLine(std::istream &input, std::string &line) {
+                    while (std::getline(input, line)) {
+                        if (!line.empty() && line.back() == '\r') line.pop_back();
+                        if (line.empty() || line[0] != '!') return true;
+                    }
+                    return false;
+                }
+            }
+
+            TuningTable equalTemperament(float referenceFrequency) {
+                referenceFrequency = validReference(referenceFrequency);
+
+                TuningTable table;
+                table.name = "Equal temperament";
+                table.referenceFrequency = referenceFrequency;
+                const float scale = referenceFrequency / static_cast<float>(Core::PitchTable::A4_FREQUENCY);
+                for (int note = 0; note < Core::Note::COUNT; ++note) {
+                    table.frequencies[note] = Core::PitchTable::EQUAL_TEMPERAMENT[note] * scale;
+                }
+                return table;
+            }
+
+            TuningTable justIntonation(float referenceFrequency, int tonic) {
+                return fromRatios("Just intonation",
+                                  {16.0 / 15.0, 9.0 / 8.0, 6.0 / 5.0, 5.0 / 4.0, 4.0 / 3.0, 45.0 / 32.0, 3.0 / 2.0,
+                                   8.0 / 5.0, 5.0 / 3.0, 9.0 / 5.0, 15.0 / 8.0, 2.0},
+                                  referenceFrequency, tonic);
+            }
+
+            TuningTable pythagorean(float referenceFrequency, int tonic) {
+                return fromRatios("Pythagorean",
+                                  {256.0 / 243.0, 9.0 / 8.0, 32.0 / 27.0, 81.0 / 64.0, 4.0 / 3.0, 729.0 / 512.0,
+                                   3.0 / 2.0, 128.0 / 81.0, 27.0 / 16.0, 16.0 / 9.0, 243.0 / 128.0, 2.0},
+                                  referenceFrequency, tonic);
+            }
+
+            TuningTable fromRatios(const std::string &name, const std::vector<double> &ratios,
+                                   float referenceFrequency, int tonic) {
+                if (ratios.empty()) {
+                    std::cerr << "Tunings: Scale '" << name << "' has no degrees, using equal temperament."
+                              << std::endl;
+                    return equalTemperament(referenceFrequency);
+                }
+                referenceFrequency = validReference(referenceFrequency);
+
+                TuningTable table;
+                table.name = name;
+                table.referenceFrequency = referenceFrequency;
+
+                // La tonique est placée de sorte que A4 tombe exactement sur le diapason
+                const double tonicFrequency = referenceFrequency /
+                                              ratioFromTonic(ratios, tonic, Core::PitchTable::A4_MIDI_NUMBER);
+                for (int note = 0; note < Core::Note::COUNT; ++note) {
+                    table.frequencies[note] = static_cast<float>(tonicFrequency * ratioFromTonic(ratios, tonic, note));
+                }
+                return table;
+            }
+
+            bool loadScala(const std::string &filePath, float referenceFrequency, TuningTable &table, int tonic) {
+                std::ifstream file(filePath);
+                if (!file.is_open()) {
+                    std::cerr << "Tunings: Could not open Scala file '" << filePath << "'." << std::endl;
+                    return false;
+                }
+                return parseScala(file, filePath, referenceFrequency, table, tonic);
+            }
+
+            bool parseScala(std::istream &input, const std::string &sourceName, float referenceFrequency,
+                            TuningTable &table, int tonic) {
+                std::string line;
+                if (!nextScalaLine(input, line)) {
+                    std::cerr << "Tunings: '" << sourceName << "' is empty." << std::endl;
+                    return false;
+                }
+                const size_t descriptionStart = line.find_first_not_of(" \t");
+                const std::string description = descriptionStart == std::string::npos ? std::string()
+                                                                                      : line.substr(descriptionStart);
+
+                int degreeCount = 0;
+                if (!nextScalaLine(input, line) || !(std::istringstream(line) >> degreeCount) || degreeCount <= 0) {
+                    std::cerr << "Tunings: '" << sourceName << "' has no valid note count." << std::endl;
+                    return false;
+                }
+
+                std::vector<double> ratios;
+                ratios.reserve(static_cast<size_t>(degreeCount));
+                while (static_cast<int>(ratios.size()) < degreeCount) {
+                    std::string token;
+                    if (!nextScalaLine(input, line) || !(std::istringstream(line) >> token)) {
+                        std::cerr << "Tunings: '" << sourceName << "' declares " << degreeCount << " notes but only "
+                                  << ratios.size() << " were found." << std::endl;
+                        return false;
+                    }
+                    const double ratio = parseScalaPitch(token);
+                    if (ratio <= 0.0) {
+                        std::cerr << "Tunings: Invalid pitch '" << token << "' in '" << sourceName << "'."
+                                  << std::endl;
+                        return false;
+                    }
+                    ratios.push_back(ratio);
+                }
+
+                table = fromRatios(description.empty() ? sourceName : description, ratios, referenceFrequency, tonic);
+                return true;
+            }
+
+            bool fromName(const std::string &nameOrPath, float referenceFrequency, TuningTable &table) {
+                if (nameOrPath == "equal") {
+                    table = equalTemperament(referenceFrequency);
+                } else if (nameOrPath == "just") {
+                    table = justIntonation(referenceFrequency);
+                } else if (nameOrPath == "pythagorean") {
+                    table = pythagorean(referenceFrequency);
+                } else if (nameOrPath.size() > 4 && nameOrPath.compare(nameOrPath.size() - 4, 4, ".scl") == 0) {
+                    return loadScala(nameOrPath, referenceFrequency, table);
+                } else {
+                    std::cerr << "Tunings: Unknown tuning '" << nameOrPath
+                              << "' (expected equal, just, pythagorean or a .scl file)." << std::endl;
+                    return false;
+                }
+                return true;
+            }
+
+        } // namespace Tunings
+    } // namespace Audio
+} // namespace MusicApp
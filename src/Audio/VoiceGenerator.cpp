@@ -0,0 +1,71 @@
+#include "../../include/Audio/VoiceGenerator.h"
+
+namespace MusicApp {
+    namespace Audio {
+        namespace VoiceDsp {
+
+            int renderEnvelope(ActiveNote &note, const EnvelopeShape &shape, float *envelope, int frames) {
+                float time = note.currentTimeInSamples;
+                int i = 0;
+
+                if (note.needsRelease) {
+                    const float level = note.currentEnvelopeValue;
+                    const float inverseRelease = 1.0f / shape.releaseSamples;
+                    const int end = framesBefore(time, shape.releaseSamples, frames);
+                    for (; i < end; ++i, time += 1.0f) {
+                        envelope[i] = level * shape.releaseCurve->at(time * inverseRelease);
+                    }
+                    if (i < frames) {
+                        note.needsRelease = false;
+                    }
+                    note.currentTimeInSamples = time;
+                    return i;
+                }
+
+                if (!note.isPlaying) return 0;
+
+                const EnvelopeCurve &attackCurve = Wavetables::attackCurve();
+                const float inverseAttack = 1.0f / shape.attackSamples;
+                int end = framesBefore(time, shape.attackSamples, frames);
+                for (; i < end; ++i, time += 1.0f) {
+                    envelope[i] = attackCurve.at(time * inverseAttack);
+                }
+
+                const float decayEnd = shape.attackSamples + shape.decaySamples;
+                const float inverseDecay = 1.0f / shape.decaySamples;
+                end = i + framesBefore(time, decayEnd, frames - i);
+                if (shape.decayCurve) {
+                    for (; i < end; ++i, time += 1.0f) {
+                        envelope[i] = shape.decayCurve->at((time - shape.attackSamples) * inverseDecay);
+                    }
+                } else {
+                    const float decayDepth = 1.0f - shape.sustainLevel;
+                    for (; i < end; ++i, time += 1.0f) {
+                        envelope[i] = 1.0f - decayDepth * (time - shape.attackSamples) * inverseDecay;
+                    }
+                }
+
+                for (; i < frames; ++i) {
+                    envelope[i] = shape.sustainLevel;
+                }
+                time += static_cast<float>(frames - end);
+
+                // Point de départ d'un relâchement éventuel
+                note.currentEnvelopeValue = envelope[frames - 1];
+                note.currentTimeInSamples = time;
+                return frames;
+            }
+
+            void smoothVoice(float *voice, int frames, float crossfade, float &previous) {
+                const float direct = 1.0f - crossfade;
+                float last = previous;
+                for (int i = 0; i < frames; ++i) {
+                    last = voice[i] * direct + last * crossfade;
+                    voice[i] = last;
+                }
+                previous = last;
+            }
+
+        } // namespace VoiceDsp
+    } // namespace Audio
+} // namespace MusicApp
@@ -0,0 +1,89 @@
+#include "../../include/Audio/VoicePool.h"
+#include <algorithm>
+
+namespace MusicApp {
+    namespace Audio {
+
+        VoicePool::VoicePool(std::size_t polyphony)
+                : voices_(std::max<std::size_t>(1, polyphony)), eventCounter_(0) {
+        }
+
+        ActiveNote *VoicePool::find(InstrumentId instrumentId, Uint8 pitchId, SessionId sessionId) {
+            for (ActiveNote &voice: voices_) {
+                if (voice.isActive() && voice.instrumentId == instrumentId && voice.pitchId == pitchId &&
+                    voice.sessionId == sessionId) {
+                    return &voice;
+                }
+            }
+            return nullptr;
+        }
+
+        ActiveNote &VoicePool::allocate(InstrumentId instrumentId, Uint8 pitchId, SessionId sessionId) {
+            ActiveNote *target = find(instrumentId, pitchId, sessionId);
+            // La note est relancée sur la même voix, mais chaque note-on attend son propre note-off
+            const Uint16 heldNoteCount = target && target->isPlaying ? target->heldNoteCount : 0;
+
+            if (!target) {
+                ActiveNote *oldestReleased = nullptr;
+                ActiveNote *oldestHeld = nullptr;
+                for (ActiveNote &voice: voices_) {
+                    if (!voice.isActive()) {
+                        target = &voice;
+                        break;
+                    }
+                    if (voice.needsRelease) {
+                        if (!oldestReleased || voice.releaseOrder < oldestReleased->releaseOrder) {
+                            oldestReleased = &voice;
+                        }
+                    } else if (!oldestHeld || voice.noteOnOrder < oldestHeld->noteOnOrder) {
+                        oldestHeld = &voice;
+                    }
+                }
+                if (!target) {
+                    target = oldestReleased ? oldestReleased : oldestHeld;
+                }
+            }
+
+            *target = ActiveNote();
+            target->instrumentId = instrumentId;
+            target->pitchId = pitchId;
+            target->sessionId = sessionId;
+            target->heldNoteCount = static_cast<Uint16>(heldNoteCount + 1);
+            target->noteOnOrder = ++eventCounter_;
+            // Graine différente par voix, jamais nulle pour le xorshift
+            target->noiseState = static_cast<Uint32>(target->noteOnOrder * 0x9E3779B9u) | 1u;
+            return *target;
+        }
+
+        void VoicePool::release(ActiveNote &voice) {
+            voice.isPlaying = false;
+            voice.needsRelease = true;
+            voice.currentTimeInSamples = 0;
+            voice.resonancePhase = 0;
+            voice.modulationPhase = 0;
+            voice.resonanceLevel = 1.0f;
+            voice.releaseOrder = ++eventCounter_;
+
+            if (voice.currentEnvelopeValue < 0.05f) {
+                voice.currentEnvelopeValue = 0.05f;
+            }
+        }
+
+        bool VoicePool::releaseHeldNote(ActiveNote &voice) {
+            if (!voice.isPlaying) return false;
+            if (voice.heldNoteCount > 1) {
+                --voice.heldNoteCount;
+                return false;
+            }
+            voice.heldNoteCount = 0;
+            release(voice);
+            return true;
+        }
+
+        std::size_t VoicePool::activeCount() const {
+            return static_cast<std::size_t>(std::count_if(voices_.begin(), voices_.end(),
+                                                          [](const ActiveNote &voice) { return voice.isActive(); }));
+        }
+
+    } // namespace Audio
+} // namespace MusicApp
@@ -0,0 +1,152 @@
+#include "../../include/Audio/Wavetable.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace MusicApp {
+    namespace Audio {
+
+        namespace {
+            constexpr float WAVETABLE_SAMPLE_RATE = 44100.0f;
+        }
+
+        constexpr int Wavetable::TABLE_SIZE;
+        constexpr int Wavetable::MIP_LEVELS;
+        constexpr float Wavetable::LOWEST_MIP_FREQUENCY;
+        constexpr int Wavetable::FRACTION_BITS;
+        constexpr Uint32 Wavetable::FRACTION_MASK;
+        constexpr float Wavetable::FRACTION_SCALE;
+
+        Wavetable::Wavetable(const std::vector<std::vector<Partial>> &layers, float sampleRate)
+                : layerCount_(static_cast<int>(layers.size())),
+                  mipStride_(static_cast<std::size_t>(TABLE_SIZE + 1) * layers.size()),
+                  data_(mipStride_ * MIP_LEVELS, 0.0f) {
+            const double nyquist = sampleRate * 0.5;
+
+            for (int mip = 0; mip < MIP_LEVELS; ++mip) {
+                // Note la plus aiguë jouée avec ce niveau : haut de l'octave
+                const double topFrequency = LOWEST_MIP_FREQUENCY * std::pow(2.0, mip + 1);
+                float *table = data_.data() + mipStride_ * mip;
+
+                for (int layer = 0; layer < layerCount_; ++layer) {
+                    for (const Partial &partial: layers[layer]) {
+                        if (partial.harmonic * topFrequency >= nyquist && partial.harmonic > 1) continue;
+                        if (partial.harmonic >= TABLE_SIZE / 2) continue;
+
+                        for (int i = 0; i <= TABLE_SIZE; ++i) {
+                            const double phase = 2.0 * M_PI * partial.harmonic * i / TABLE_SIZE;
+                            table[static_cast<std::size_t>(i) * layerCount_ + layer] +=
+                                    partial.amplitude * static_cast<float>(std::sin(phase));
+                        }
+                    }
+                }
+            }
+        }
+
+        const float *Wavetable::mipFor(float frequency) const {
+            int mip = 0;
+            float bandTop = LOWEST_MIP_FREQUENCY * 2.0f;
+            while (mip < MIP_LEVELS - 1 && frequency >= bandTop) {
+                bandTop *= 2.0f;
+                ++mip;
+            }
+            return data_.data() + mipStride_ * mip;
+        }
+
+        EnvelopeCurve::EnvelopeCurve(const std::function<float(float)> &shape) {
+            for (int i = 0; i <= CURVE_SIZE; ++i) {
+                points_[i] = shape(static_cast<float>(i) / CURVE_SIZE);
+            }
+        }
+
+        namespace Wavetables {
+
+            const Wavetable &piano() {
+                static const Wavetable table({
+                                                     {{1, 1.0f}},
+                                                     {{2, 0.5f}, {3, 0.3f}},
+                                                     {{4, 0.2f}},
+                                                     {{5, 0.1f}}
+                                             }, WAVETABLE_SAMPLE_RATE);
+                return table;
+            }
+
+            const Wavetable &xylophone() {
+                static const Wavetable table({
+                                                     {{1, 1.0f}},
+                                                     {{2, 0.5f}, {4, 0.33f}},
+                                                     {{6, 0.25f}}
+                                             }, WAVETABLE_SAMPLE_RATE);
+                return table;
+            }
+
+            const Wavetable &square() {
+                static const Wavetable table([] {
+                    std::vector<Partial> partials;
+                    for (int harmonic = 1; harmonic < Wavetable::TABLE_SIZE / 2; harmonic += 2) {
+                        partials.push_back({harmonic, static_cast<float>(4.0 / (M_PI * harmonic))});
+                    }
+                    return std::vector<std::vector<Partial>>{partials};
+                }(), WAVETABLE_SAMPLE_RATE);
+                return table;
+            }
+
+            const Wavetable &sine() {
+                static const Wavetable table({{{1, 1.0f}}}, WAVETABLE_SAMPLE_RATE);
+                return table;
+            }
+
+            const EnvelopeCurve &attackCurve() {
+                static const EnvelopeCurve curve([](float x) {
+                    return (1.0f - std::cos(x * static_cast<float>(M_PI))) * 0.5f;
+                });
+                return curve;
+            }
+
+            const EnvelopeCurve &releaseCurve() {
+                static const EnvelopeCurve curve([](float x) {
+                    return (0.5f + 0.5f * std::cos(x * static_cast<float>(M_PI))) * std::exp(-3.0f * x);
+                });
+                return curve;
+            }
+
+            const EnvelopeCurve &chiptuneReleaseCurve() {
+                static const EnvelopeCurve curve([](float x) {
+                    return (0.5f + 0.5f * std::cos(x * static_cast<float>(M_PI))) * std::exp(-2.0f * x);
+                });
+                return curve;
+            }
+
+            const EnvelopeCurve &xylophoneDecayCurve() {
+                static const EnvelopeCurve curve([](float x) {
+                    return std::exp(-x * 2.5f);
+                });
+                return curve;
+            }
+
+            const EnvelopeCurve &pluckDecayCurve() {
+                static const EnvelopeCurve curve([](float x) {
+                    return std::exp(-x * 4.0f) * (1.0f - x);
+                });
+                return curve;
+            }
+
+            void prepare() {
+                piano();
+                xylophone();
+                square();
+                sine();
+                attackCurve();
+                releaseCurve();
+                chiptuneReleaseCurve();
+                xylophoneDecayCurve();
+                pluckDecayCurve();
+            }
+
+        } // namespace Wavetables
+
+    } // namespace Audio
+} // namespace MusicApp
@@ -1,8 +1,32 @@
 #include "../../include/Instruments/GuitarInstrument.h"
+#include "../../include/Audio/Synthesizer.h" // For SAMPLE_RATE
+#include <algorithm>
+#include <cmath>
 
 namespace MusicApp {
 namespace Instruments {
 
+using Audio::ActiveNote;
+using Audio::Wavetable;
+using Audio::EnvelopeCurve;
+using Audio::bipolarNoise;
+namespace Wavetables = Audio::Wavetables;
+namespace MixKernels = Audio::MixKernels;
+namespace VoiceDsp = Audio::VoiceDsp;
+
+namespace {
+    const unsigned int SAMPLE_RATE = Audio::Synthesizer::SAMPLE_RATE;
+
+    // Pluck envelope: near-instant attack, then the string rings down to silence (no sustain). Low strings
+    // ring longer than high ones; a note-off damps the string quickly.
+    VoiceDsp::EnvelopeShape pluckShape(const ActiveNote &note) {
+        const float ringSeconds = (1.2f + 2.0f * SDL_clamp(196.0f / note.frequency, 0.0f, 1.0f)) *
+                                  (0.8f + note.velocity * 0.4f);
+        return {SAMPLE_RATE * 0.003f, SAMPLE_RATE * ringSeconds, 0.0f, SAMPLE_RATE * 0.08f,
+                &Wavetables::pluckDecayCurve(), &Wavetables::releaseCurve()};
+    }
+}
+
 // Constructor
 GuitarInstrument::GuitarInstrument() {
     setName("Guitar");
@@ -17,5 +41,62 @@ void GuitarInstrument::playNote(
     audioEngine.playSound(getName(), note);
 }
 
+// Plucked string: bright attack that mellows as the string rings, plus pick noise
+void GuitarInstrument::renderBlock(ActiveNote &note, float *bus, int numStereoSampleFrames, float gain,
+                                   const Audio::VoiceScratch &scratch) {
+    const float blockStartTime = note.currentTimeInSamples;
+    const VoiceDsp::EnvelopeShape shape = pluckShape(note);
+    float *envelope = scratch.envelope;
+    const int frames = VoiceDsp::renderEnvelope(note, shape, envelope, numStereoSampleFrames);
+    if (frames == 0) return;
+
+    // Piano table layers (fundamental, 2+3, 4, 5): the upper harmonics fade with the string's level,
+    // so the tone darkens as the note rings, release included
+    const float *table = Wavetables::piano().mipFor(note.frequency);
+    const Uint32 phaseIncrement = Wavetable::phaseIncrement(note.frequency, SAMPLE_RATE);
+    const float pluckBrightness = 0.6f + note.velocity * 0.8f;
+    const float normalization = 1.0f / (1.0f + pluckBrightness * 0.6f);
+
+    float *voice = scratch.voice;
+    Uint32 phase = note.phase;
+    for (int i = 0; i < frames; ++i) {
+        float layers[4];
+        Wavetable::read<4>(table, phase, layers);
+        const float brightness = pluckBrightness * envelope[i];
+        voice[i] = layers[0] +
+                   brightness * (layers[1] * 0.9f + brightness * (layers[2] * 0.6f + brightness * layers[3] * 0.4f));
+        phase += phaseIncrement;
+    }
+    note.phase = phase;
+
+    // Pick noise fading out over the first milliseconds of the note (not replayed by the release)
+    const float noiseSpan = shape.attackSamples * 4;
+    const int noiseFrames = note.isPlaying ? VoiceDsp::framesBefore(blockStartTime + 1.0f, noiseSpan, frames) : 0;
+    if (noiseFrames > 0) {
+        const EnvelopeCurve &attackCurve = Wavetables::attackCurve();
+        const float noiseDepth = 0.08f * note.velocity;
+        for (int i = 0; i < noiseFrames; ++i) {
+            const float noiseEnvelope = 1.0f - attackCurve.at((blockStartTime + 1.0f + i) / noiseSpan);
+            voice[i] += bipolarNoise(note.noiseState) * noiseDepth * noiseEnvelope;
+        }
+    }
+
+    MixKernels::applyEnvelope(voice, envelope, normalization * note.velocity * gain, frames);
+    VoiceDsp::smoothVoice(voice, frames, 0.05f, note.prevSample);
+
+    // Slight stereo spread: low strings left, high strings right
+    const float stereoPan = SDL_clamp(0.5f + (note.frequency - 330.0f) / 1500.0f, 0.3f, 0.7f);
+    const float leftVolume = 1.0f - stereoPan * 0.4f;  // 0.72 to 0.88
+    const float rightVolume = 0.6f + stereoPan * 0.4f; // 0.72 to 0.88
+    MixKernels::accumulateStereo(bus, voice, leftVolume * 0.8f, rightVolume * 0.8f, frames);
+}
+
+// A string that has stopped ringing frees its voice even while the key is still held
+bool GuitarInstrument::isFinished(const ActiveNote &note) const {
+    if (!note.isActive()) return true;
+    const VoiceDsp::EnvelopeShape shape = pluckShape(note);
+    return note.isPlaying && note.currentTimeInSamples >= shape.attackSamples + shape.decaySamples;
+}
+
 } // namespace Instruments
 } // namespace MusicApp
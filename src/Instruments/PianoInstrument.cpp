@@ -1,8 +1,23 @@
 #include "../../include/Instruments/PianoInstrument.h"
+#include "../../include/Audio/Synthesizer.h" // For SAMPLE_RATE
+#include <algorithm>
+#include <cmath>
 
 namespace MusicApp {
 namespace Instruments {
 
+using Audio::ActiveNote;
+using Audio::Wavetable;
+using Audio::EnvelopeCurve;
+using Audio::bipolarNoise;
+namespace Wavetables = Audio::Wavetables;
+namespace MixKernels = Audio::MixKernels;
+namespace VoiceDsp = Audio::VoiceDsp;
+
+namespace {
+    const unsigned int SAMPLE_RATE = Audio::Synthesizer::SAMPLE_RATE;
+}
+
 // Constructor
     PianoInstrument::PianoInstrument(){
         setName("Piano");
@@ -17,5 +32,87 @@ void PianoInstrument::playNote(
     audioEngine.playSound(getName(), note);
 }
 
+// Piano voice: harmonic wavetable, sympathetic string resonance and hammer noise
+void PianoInstrument::renderBlock(ActiveNote &note, float *bus, int numStereoSampleFrames, float gain,
+                                  const Audio::VoiceScratch &scratch) {
+    // Ajuster les paramètres ADSR en fonction de la vélocité
+    // Attaque plus courte pour les notes fortes, plus longue pour les notes douces
+    float attackDuration =
+            ActiveNote::ATTACK_DURATION_SAMPLES * (1.2f - note.velocity * 0.6f); // 6ms à 14ms selon la vélocité
+    float decayDuration = ActiveNote::DECAY_DURATION_SAMPLES *
+                          (0.8f + note.velocity * 0.4f);   // 80ms à 120ms selon la vélocité
+    float sustainLevel = ActiveNote::SUSTAIN_LEVEL *
+                         (0.6f + note.velocity * 0.4f);             // 42% à 70% selon la vélocité
+    float releaseDuration = ActiveNote::RELEASE_DURATION_SAMPLES * (1.0f + note.velocity * 0.5f);
+
+    // Le temps de la note au début du bloc : le bruit de marteau dépend de la position dans la note
+    const float blockStartTime = note.currentTimeInSamples;
+    const VoiceDsp::EnvelopeShape shape = {attackDuration, decayDuration, sustainLevel, releaseDuration, nullptr,
+                                 &Wavetables::releaseCurve()};
+    float *envelope = scratch.envelope;
+    const int frames = VoiceDsp::renderEnvelope(note, shape, envelope, numStereoSampleFrames);
+    if (frames == 0) return;
+
+    // Calculer les paramètres de filtre basés sur la vélocité pour les harmoniques
+    // Une vélocité plus élevée donne des harmoniques plus brillantes
+    float harmonic_factor = note.velocity * 1.3f; // Plus de brillance pour les notes fortes
+
+    // Poids des couches de la table : fondamentale, harmoniques 2+3, harmonique 4, harmonique 5
+    const float layerWeights[4] = {1.0f, harmonic_factor, harmonic_factor * note.velocity,
+                                   harmonic_factor * note.velocity * note.velocity};
+    const float normalization = 1.0f / (1.0f + harmonic_factor * 0.5f);
+
+    const float *pianoTable = Wavetables::piano().mipFor(note.frequency);
+    const float *resonanceTable = Wavetables::sine().mipFor(note.frequency * 1.01f);
+    const Uint32 phaseIncrement = Wavetable::phaseIncrement(note.frequency, SAMPLE_RATE);
+    const Uint32 resonanceIncrement = Wavetable::phaseIncrement(note.frequency * 1.01f, SAMPLE_RATE);
+    // exp(-0.5 t) calculé par récurrence : un facteur constant par échantillon
+    static const float resonanceDecayPerSample = std::exp(-0.5f / SAMPLE_RATE);
+    const float resonanceDepth = 0.02f * note.velocity;
+
+    float *voice = scratch.voice;
+
+    // Modèle de synthèse de piano : une seule lecture de table donne toutes les harmoniques,
+    // plus l'effet de résonance des cordes (vibrations sympathiques), ajouté par une seconde passe
+    MixKernels::WavetableBlock strings = {pianoTable, 4, layerWeights, note.phase, phaseIncrement, 1.0f, 1.0f};
+    MixKernels::renderWavetable(strings, voice, frames, false);
+    MixKernels::WavetableBlock resonance = {resonanceTable, 1, &resonanceDepth, note.resonancePhase,
+                                            resonanceIncrement, note.resonanceLevel, resonanceDecayPerSample};
+    MixKernels::renderWavetable(resonance, voice, frames, true);
+
+    // Effet d'attaque subtil (bruit de marteau) au début de la note, seulement sur les premières trames
+    const float noiseSpan = attackDuration * 2;
+    const int noiseFrames = VoiceDsp::framesBefore(blockStartTime + 1.0f, noiseSpan, frames);
+    if (noiseFrames > 0) {
+        const EnvelopeCurve &attackCurve = Wavetables::attackCurve();
+        const float noiseDepth = 0.03f * note.velocity;
+        for (int i = 0; i < noiseFrames; ++i) {
+            const float noiseEnvelope = attackCurve.at((blockStartTime + 1.0f + i) / noiseSpan);
+            voice[i] += bipolarNoise(note.noiseState) * noiseDepth * noiseEnvelope;
+        }
+    }
+
+    note.phase = strings.phase;
+    note.resonancePhase = resonance.phase;
+    note.resonanceLevel = resonance.level;
+
+    // Enveloppe, normalisation et vélocité en une passe vectorielle
+    MixKernels::applyEnvelope(voice, envelope, normalization * note.velocity * gain, frames);
+
+    // Crossfade pour minimiser les clics/pops
+    VoiceDsp::smoothVoice(voice, frames, 0.1f, note.prevSample);
+
+    // Ajouter un léger effet de stéréo en fonction de la fréquence (graves à gauche, aigus à droite)
+    float stereoPan = 0.5f + (note.frequency - 440.0f) / 2000.0f; // Centrée autour de La4 (440Hz)
+    stereoPan = SDL_clamp(stereoPan, 0.2f, 0.8f); // Limiter le panning pour éviter les extrêmes
+
+    const float leftPan = 1.0f - stereoPan * 0.5f;  // 0.6 à 0.9
+    const float rightPan = 0.5f + stereoPan * 0.5f; // 0.6 à 0.9
+
+    // Accumuler sur le bus float32 avec le gain propre à l'instrument
+    // (l'écrêtage n'est fait qu'une seule fois, dans l'étage de sortie)
+    MixKernels::accumulateStereo(bus, voice, leftPan * 0.8f, rightPan * 0.8f, frames);
+}
+
 } // namespace Instruments
 } // namespace MusicApp
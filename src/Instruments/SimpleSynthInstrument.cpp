@@ -1,4 +1,18 @@
 #include "../../include/Instruments/SimpleSynthInstrument.h"
+#include "../../include/Audio/Synthesizer.h" // For SAMPLE_RATE
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    using MusicApp::Audio::ActiveNote;
+    using MusicApp::Audio::Wavetable;
+    using MusicApp::Audio::bipolarNoise;
+    namespace Wavetables = MusicApp::Audio::Wavetables;
+    namespace MixKernels = MusicApp::Audio::MixKernels;
+    namespace VoiceDsp = MusicApp::Audio::VoiceDsp;
+
+    const unsigned int SAMPLE_RATE = MusicApp::Audio::Synthesizer::SAMPLE_RATE;
+}
 
 // Constructor
 MusicApp::Instruments::SimpleSynthInstrument::SimpleSynthInstrument(){
@@ -14,3 +28,97 @@ void MusicApp::Instruments::SimpleSynthInstrument::playNote(
     // The audio engine is responsible for how this translates to actual audio.
     audioEngine.playSound(getName(), note);
 }
+
+// 8-bit console voice: band-limited square wave, vibrato and bit reduction
+void MusicApp::Instruments::SimpleSynthInstrument::renderBlock(ActiveNote &note, float *bus, int numStereoSampleFrames,
+                                                               float gain, const Audio::VoiceScratch &scratch) {
+    // Paramètres spécifiques au son 8-bit, ajustés selon la vélocité
+    const float base_attack = 0.01f;   // 10ms
+    const float base_decay = 0.05f;    // 50ms
+    const float base_release = 0.05f;  // 50ms
+
+    // Ajuster les paramètres en fonction de la vélocité
+    const float CHIPTUNE_ATTACK_DURATION =
+            base_attack * (1.1f - note.velocity * 0.5f); // Plus court pour les notes fortes
+    const float CHIPTUNE_DECAY_DURATION = base_decay * (0.9f + note.velocity * 0.2f);
+    const float CHIPTUNE_RELEASE_DURATION = base_release * (0.8f + note.velocity * 0.4f);
+    const float CHIPTUNE_SUSTAIN_LEVEL = 0.6f + (note.velocity * 0.2f);     // 60-80% de volume selon vélocité
+
+    // Convertir en échantillons
+    const float CHIPTUNE_ATTACK_SAMPLES = 44100 * CHIPTUNE_ATTACK_DURATION;
+    const float CHIPTUNE_DECAY_SAMPLES = 44100 * CHIPTUNE_DECAY_DURATION;
+    const float CHIPTUNE_RELEASE_SAMPLES = 44100 * CHIPTUNE_RELEASE_DURATION;
+
+    const VoiceDsp::EnvelopeShape shape = {CHIPTUNE_ATTACK_SAMPLES, CHIPTUNE_DECAY_SAMPLES, CHIPTUNE_SUSTAIN_LEVEL,
+                                 CHIPTUNE_RELEASE_SAMPLES, nullptr, &Wavetables::chiptuneReleaseCurve()};
+    float *envelope = scratch.envelope;
+    const int frames = VoiceDsp::renderEnvelope(note, shape, envelope, numStereoSampleFrames);
+    if (frames == 0) return;
+
+    // Facteur de quantification pour le son 8-bit, peut varier avec la vélocité
+    // Pour les notes fortes, moins de bits = son plus saturé et agressif
+    const int BIT_DEPTH = std::max(3, static_cast<int>(6 - note.velocity *
+                                                           2));  // Entre 3 et 6 bits selon la vélocité
+    const float QUANTIZE_LEVELS = (1 << BIT_DEPTH) - 1;  // Niveaux de quantification
+    const float inverseQuantizeLevels = 1.0f / QUANTIZE_LEVELS;
+    const int QUANTIZE_OFFSET = 256; // Rend la valeur positive avant troncature (|signal| * 63 < 256)
+
+    // Onde carrée à bande limitée : la version par octave évite le repliement des harmoniques aiguës
+    const float *squareTable = Wavetables::square().mipFor(note.frequency);
+    const float *sineTable = Wavetables::sine().mipFor(note.frequency);
+    const Uint32 phaseIncrement = Wavetable::phaseIncrement(note.frequency, SAMPLE_RATE);
+    const Uint32 distortionIncrement = Wavetable::phaseIncrement(note.frequency * 2.0f, SAMPLE_RATE);
+    const Uint32 vibratoIncrement = Wavetable::phaseIncrement(7.0f, SAMPLE_RATE);
+
+    const float vibratoDepth = 0.05f * note.velocity;
+    const float distortionDepth = 0.1f + note.velocity * 0.2f;
+    // "Bitcrush noise" caractéristique des consoles rétro, uniquement pour les vélocités fortes
+    const float noiseDepth = note.velocity > 0.7f ? 0.05f * (note.velocity - 0.7f) / 0.3f : 0.0f;
+
+    float *voice = scratch.voice;
+
+    // Onde carrée (caractéristique du son 8-bit), vibrato et distorsion qui varient avec la vélocité
+    const float squareWeight = 1.0f;
+    MixKernels::WavetableBlock square = {squareTable, 1, &squareWeight, note.phase, phaseIncrement, 1.0f, 1.0f};
+    MixKernels::renderWavetable(square, voice, frames, false);
+    MixKernels::WavetableBlock vibrato = {sineTable, 1, &vibratoDepth, note.modulationPhase, vibratoIncrement,
+                                          1.0f, 1.0f};
+    MixKernels::renderWavetable(vibrato, voice, frames, true);
+    MixKernels::WavetableBlock distortion = {sineTable, 1, &distortionDepth, note.resonancePhase,
+                                             distortionIncrement, 1.0f, 1.0f};
+    MixKernels::renderWavetable(distortion, voice, frames, true);
+
+    Uint32 noiseState = note.noiseState;
+    for (int i = 0; i < frames; ++i) {
+        float oscillatorValue = voice[i];
+        if (noiseDepth > 0.0f) {
+            oscillatorValue += bipolarNoise(noiseState) * noiseDepth;
+        }
+
+        // Appliquer la quantification (effet de réduction de bit)
+        // (arrondi par conversion entière décalée, sans appel à std::floor)
+        voice[i] = static_cast<float>(
+                static_cast<int>(oscillatorValue * QUANTIZE_LEVELS + 0.5f + QUANTIZE_OFFSET) -
+                QUANTIZE_OFFSET) * inverseQuantizeLevels;
+    }
+
+    note.phase = square.phase;
+    note.resonancePhase = distortion.phase;
+    note.modulationPhase = vibrato.phase;
+    note.noiseState = noiseState;
+
+    MixKernels::applyEnvelope(voice, envelope, (0.7f + note.velocity * 0.3f) * gain, frames);
+
+    // Crossfade très léger pour les sons 8-bit (pour préserver la netteté)
+    VoiceDsp::smoothVoice(voice, frames, 0.05f, note.prevSample);
+
+    // Appliquer un effet stéréo léger pour les sons 8-bit
+    // Moduler le panoramique en fonction de la note et de la vélocité
+    float stereoPan = 0.5f + ((note.frequency - 440.0f) / 1500.0f) * note.velocity * 0.5f;
+    stereoPan = SDL_clamp(stereoPan, 0.3f, 0.7f); // Limiter l'effet stéréo
+
+    const float leftVolume = 1.0f - (stereoPan * 0.3f);  // 0.79 à 0.91
+    const float rightVolume = 0.7f + (stereoPan * 0.3f); // 0.79 à 0.91
+
+    MixKernels::accumulateStereo(bus, voice, leftVolume * 0.75f, rightVolume * 0.75f, frames);
+}
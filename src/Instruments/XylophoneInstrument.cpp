@@ -1,8 +1,23 @@
 #include "../../include/Instruments/XylophoneInstrument.h"
+#include "../../include/Audio/Synthesizer.h" // For SAMPLE_RATE
+#include <algorithm>
+#include <cmath>
 
 namespace MusicApp {
 namespace Instruments {
 
+using Audio::ActiveNote;
+using Audio::Wavetable;
+using Audio::EnvelopeCurve;
+using Audio::bipolarNoise;
+namespace Wavetables = Audio::Wavetables;
+namespace MixKernels = Audio::MixKernels;
+namespace VoiceDsp = Audio::VoiceDsp;
+
+namespace {
+    const unsigned int SAMPLE_RATE = Audio::Synthesizer::SAMPLE_RATE;
+}
+
 // Constructor
     XylophoneInstrument::XylophoneInstrument(){
         setName("Xylophone");
@@ -17,5 +32,93 @@ void XylophoneInstrument::playNote(
     audioEngine.playSound(getName(), note);
 }
 
+// Struck bar: bright harmonics, short metallic resonance, no sustain
+void XylophoneInstrument::renderBlock(ActiveNote &note, float *bus, int numStereoSampleFrames, float gain,
+                                      const Audio::VoiceScratch &scratch) {
+    // Paramètres spécifiques au xylophone, ajustés selon la vélocité
+    const float base_attack_duration = 0.005f; // 5ms (très court pour le xylophone)
+    const float base_decay_duration = 0.5f;    // 500ms (plus court que le piano)
+    const float base_release_duration = 0.1f;  // 100ms release
+
+    // Ajuster les paramètres en fonction de la vélocité
+    const float XYLOPHONE_ATTACK_DURATION =
+            base_attack_duration * (1.2f - note.velocity * 0.4f); // Plus court pour les notes fortes
+    const float XYLOPHONE_DECAY_DURATION =
+            base_decay_duration * (0.7f + note.velocity * 0.6f);   // Plus long pour les notes fortes
+    const float XYLOPHONE_RELEASE_DURATION = base_release_duration * (0.8f + note.velocity * 0.4f);
+    const float XYLOPHONE_SUSTAIN_LEVEL = 0.0f;    // Pas de sustain pour le xylophone
+
+    // Convertir en échantillons
+    const float XYLOPHONE_ATTACK_SAMPLES = 44100 * XYLOPHONE_ATTACK_DURATION;
+    const float XYLOPHONE_DECAY_SAMPLES = 44100 * XYLOPHONE_DECAY_DURATION;
+    const float XYLOPHONE_RELEASE_SAMPLES = 44100 * XYLOPHONE_RELEASE_DURATION;
+
+    // Décroissance exponentielle (plus naturelle) et relâchement rapide mais progressif
+    const float blockStartTime = note.currentTimeInSamples;
+    const VoiceDsp::EnvelopeShape shape = {XYLOPHONE_ATTACK_SAMPLES, XYLOPHONE_DECAY_SAMPLES, XYLOPHONE_SUSTAIN_LEVEL,
+                                 XYLOPHONE_RELEASE_SAMPLES, &Wavetables::xylophoneDecayCurve(),
+                                 &Wavetables::releaseCurve()};
+    float *envelope = scratch.envelope;
+    const int frames = VoiceDsp::renderEnvelope(note, shape, envelope, numStereoSampleFrames);
+    if (frames == 0) return;
+
+    // Facteur de brillance des harmoniques basé sur la vélocité
+    const float brightness_factor = 0.8f + note.velocity * 0.4f;
+
+    // Poids des couches de la table : fondamentale, harmoniques 2+4, harmonique 6
+    const float layerWeights[3] = {1.0f, brightness_factor, brightness_factor * note.velocity};
+    const float normalization = 1.0f / (1.5f + brightness_factor * 0.5f);
+
+    const float *xylophoneTable = Wavetables::xylophone().mipFor(note.frequency);
+    const float *resonanceTable = Wavetables::sine().mipFor(note.frequency * 12.0f);
+    const Uint32 phaseIncrement = Wavetable::phaseIncrement(note.frequency, SAMPLE_RATE);
+    const Uint32 resonanceIncrement = Wavetable::phaseIncrement(note.frequency * 12.0f, SAMPLE_RATE);
+    // exp(-8 t) calculé par récurrence
+    static const float resonanceDecayPerSample = std::exp(-8.0f / SAMPLE_RATE);
+    const float resonanceDepth = 0.1f * note.velocity;
+
+    float *voice = scratch.voice;
+
+    // Mélange des harmoniques pour obtenir un son plus brillant de xylophone,
+    // plus la résonance métallique caractéristique (décroît rapidement)
+    MixKernels::WavetableBlock bar = {xylophoneTable, 3, layerWeights, note.phase, phaseIncrement, 1.0f, 1.0f};
+    MixKernels::renderWavetable(bar, voice, frames, false);
+    MixKernels::WavetableBlock resonance = {resonanceTable, 1, &resonanceDepth, note.resonancePhase,
+                                            resonanceIncrement, note.resonanceLevel, resonanceDecayPerSample};
+    MixKernels::renderWavetable(resonance, voice, frames, true);
+
+    // Léger bruit d'impact au début (mallet hit), modulé par la vélocité
+    const float noiseSpan = XYLOPHONE_ATTACK_SAMPLES * 2;
+    const int noiseFrames = VoiceDsp::framesBefore(blockStartTime + 1.0f, noiseSpan, frames);
+    if (noiseFrames > 0) {
+        const EnvelopeCurve &attackCurve = Wavetables::attackCurve();
+        const float noiseDepth = 0.1f * note.velocity;
+        for (int i = 0; i < noiseFrames; ++i) {
+            const float noiseEnvelope = attackCurve.at((blockStartTime + 1.0f + i) / noiseSpan);
+            voice[i] += bipolarNoise(note.noiseState) * noiseDepth * noiseEnvelope;
+        }
+    }
+
+    note.phase = bar.phase;
+    note.resonancePhase = resonance.phase;
+    note.resonanceLevel = resonance.level;
+
+    MixKernels::applyEnvelope(voice, envelope, normalization * note.velocity * gain, frames);
+
+    // Légèrement moins de crossfade que le piano (son plus percussif)
+    VoiceDsp::smoothVoice(voice, frames, 0.08f, note.prevSample);
+
+    // Ajouter un léger effet stéréo (panning) basé sur la fréquence
+    // Les notes basses plus à gauche, les notes hautes plus à droite
+    float normalizedFreq = (note.frequency - 200.0f) / 800.0f;  // Normaliser entre 0-1
+    normalizedFreq = SDL_clamp(normalizedFreq, 0.0f, 1.0f);
+
+    // Calculer les volumes des canaux gauche et droit
+    const float leftVolume = 1.0f - (normalizedFreq * 0.5f);   // 1.0 à 0.5
+    const float rightVolume = 0.5f + (normalizedFreq * 0.5f);  // 0.5 à 1.0
+
+    MixKernels::accumulateStereo(bus, voice, leftVolume * 0.85f, rightVolume * 0.85f, frames);
+}
+
 } // namespace Instruments
 } // namespace MusicApp
@@ -8,12 +8,28 @@
 #include <SDL3/SDL_dialog.h>
 #include "../../include/Audio/MusicFileReader.h"
 #include "../../include/Audio/SDLAudioEngine.h"
+#include "../../include/Audio/OfflineRenderer.h"
+#include "../../include/Audio/CompiledScore.h"
+#include "../../include/Audio/ScoreTextParser.h"
+#include "../../include/Audio/MidiFileReader.h"
 #include "../../include/View/ButtonView.h"
 
+// Wakes the event-driven main loop once the dialog has answered, so the new song name gets drawn
+// (the dialog may call back from another thread; the pushed event makes the loop redraw)
+struct RedrawRequest {
+    ~RedrawRequest() {
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        SDL_PushEvent(&event);
+    }
+};
+
 // Callback function for SDL_ShowOpenFileDialog
 static void FileDialogCallback(void *userdata, const char *const *filePaths, int numFiles) {
     Controller *controller = static_cast<Controller *>(userdata);
     if (!controller) return;
+    RedrawRequest redrawRequest;
 
     // If a new file is being imported, we should consider any currently playing song stopped
     // from the perspective of the *new* song that's about to be loaded.
@@ -32,22 +48,69 @@ static void FileDialogCallback(void *userdata, const char *const *filePaths, int
 
         std::cout << "Controller: Attempting to load new song: " << controller->importedFileName << std::endl;
 
-        // Parse the new song file
-        std::vector<MusicalEvent> newSongEvents = parseMusicFile(controller->importedFilePath);
+        // Compiled score: mapped and played in place, nothing to parse
+        const std::string &path = controller->importedFilePath;
+        const std::string compiledExtension = MusicApp::Audio::CompiledScore::FILE_EXTENSION;
+        if (path.size() > compiledExtension.size() &&
+            path.compare(path.size() - compiledExtension.size(), compiledExtension.size(), compiledExtension) == 0) {
+            auto compiledScore = std::make_shared<MusicApp::Audio::CompiledScore>();
+            controller->midiSong_.reset();
+            controller->songPlayRequested_ = false;
+            if (compiledScore->open(path)) {
+                controller->compiledSong_ = compiledScore;
+                controller->songLoaded = true;
+                std::cout << "Controller: New compiled song loaded: " << controller->importedFileName
+                          << " with " << compiledScore->eventCount() << " events." << std::endl;
+            } else {
+                controller->compiledSong_.reset();
+                controller->songLoaded = false;
+                controller->importedFileName.clear();
+                std::cerr << "Controller: Failed to open compiled song file: " << path << std::endl;
+            }
+            return;
+        }
+        controller->compiledSong_.reset();
+        controller->midiSong_.reset();
+
+        // MIDI file: decoded once into polyphonic records with absolute frame onsets
+        if (MusicApp::Audio::MidiFileReader::isMidiPath(path)) {
+            MusicApp::Audio::MidiFileReader::Result midi;
+            controller->songPlayRequested_ = false;
+            if (MusicApp::Audio::MidiFileReader::read(path, midi)) {
+                auto score = std::make_shared<Model::Score>(Model::Score::fromRecords(
+                        midi.events.data(), midi.events.size(), midi.lengthFrames,
+                        MusicApp::Audio::InstrumentId::Piano));
+                std::cout << "Controller: New MIDI song loaded: " << controller->importedFileName << " with "
+                          << score->size() << " notes on " << score->trackCount() << " channels." << std::endl;
+                controller->midiSong_ = std::move(score);
+                controller->songLoaded = true;
+            } else {
+                controller->songLoaded = false;
+                controller->importedFileName.clear();
+                std::cerr << "Controller: Failed to read MIDI file: " << path << std::endl;
+            }
+            return;
+        }
+
+        // Text score: only the first chunk is parsed here, to validate the file; SongPlayer streams the rest
+        MusicApp::Audio::ScoreTextParser parser;
+        std::vector<MusicApp::Audio::ScoreEventRecord> firstEvents;
+        if (parser.open(path)) {
+            while (firstEvents.empty() && !parser.done()) {
+                parser.parseChunk(firstEvents);
+            }
+            MusicApp::Audio::ScoreTextParser::reportErrors(path, parser.errors(), parser.errorCount());
+        }
 
-        if (!newSongEvents.empty()) {
-            controller->currentSongEvents_for_playback = newSongEvents; // Replace old events
+        controller->songPlayRequested_ = false; // A new song is loaded, so any previous play request is for the old song
+        if (!firstEvents.empty()) {
             controller->songLoaded = true;
-            controller->songPlayRequested_ = false; // A new song is loaded, so any previous play request is for the old song
-            std::cout << "Controller: New song loaded: " << controller->importedFileName
-                      << " with " << controller->currentSongEvents_for_playback.size() << " events." << std::endl;
+            std::cout << "Controller: New song loaded: " << controller->importedFileName << " (first "
+                      << firstEvents.size() << " events checked, the rest is read during playback)." << std::endl;
         } else {
-            // Keep the old song loaded if the new one fails to parse? Or clear it?
             // For now, let's say a failed import clears the current song.
             controller->songLoaded = false;
-            controller->songPlayRequested_ = false;
             controller->importedFileName.clear();
-            controller->currentSongEvents_for_playback.clear();
             std::cerr << "Controller: Failed to parse new song file: " << controller->importedFilePath << std::endl;
         }
     } else {
@@ -57,9 +120,57 @@ static void FileDialogCallback(void *userdata, const char *const *filePaths, int
     }
 }
 
+// Callback function for SDL_ShowSaveFileDialog ("Export" button)
+void Controller::exportDialogCallback(void *userdata, const char *const *filePaths, int) {
+    Controller *controller = static_cast<Controller *>(userdata);
+    if (!controller) return;
+
+    if (!filePaths || !filePaths[0]) {
+        std::cerr << "Controller: No destination selected for export." << std::endl;
+        return;
+    }
+
+    std::string exportPath = filePaths[0];
+    MusicApp::Audio::OfflineRenderer::FileFormat format = MusicApp::Audio::OfflineRenderer::FileFormat::Wav;
+    if (exportPath.size() > 4 && exportPath.compare(exportPath.size() - 4, 4, ".pcm") == 0) {
+        format = MusicApp::Audio::OfflineRenderer::FileFormat::RawPcm;
+    } else if (exportPath.size() < 4 || exportPath.compare(exportPath.size() - 4, 4, ".wav") != 0) {
+        exportPath += ".wav";
+    }
+
+    // Rendu hors ligne : n'utilise pas le moteur temps réel, qui peut continuer à jouer
+    MusicApp::Audio::OfflineRenderer renderer;
+    // L'export sonne comme la lecture : même diapason et même tempérament que le moteur temps réel
+    if (auto *engine = dynamic_cast<MusicApp::Audio::SDLAudioEngine *>(controller->audioEngine)) {
+        renderer.setTuning(*engine->getTuning());
+    }
+    bool exported = false;
+    if (controller->compiledSong_) {
+        exported = renderer.renderToFile(*controller->compiledSong_, controller->exportInstrumentName_, exportPath,
+                                         format);
+    } else if (controller->midiSong_) {
+        Model::Score arranged = *controller->midiSong_;
+        arranged.setInstrument(MusicApp::Audio::Synthesizer::instrumentIdForName(controller->exportInstrumentName_));
+        exported = renderer.renderToFile(arranged, exportPath, format);
+    } else {
+        const MusicApp::Audio::ScoreTextParser::Result score =
+                MusicApp::Audio::ScoreTextParser::parseFile(controller->importedFilePath);
+        MusicApp::Audio::ScoreTextParser::reportErrors(controller->importedFilePath, score.errors, score.errorCount);
+        exported = score.opened &&
+                   renderer.renderToFile(score.events.data(), score.events.size(), score.lengthFrames,
+                                         controller->exportInstrumentName_, exportPath, format);
+    }
+    if (exported) {
+        std::cout << "Controller: Exported " << controller->importedFileName << " to " << exportPath << std::endl;
+    } else {
+        std::cerr << "Controller: Export to " << exportPath << " failed." << std::endl;
+    }
+}
+
 Controller::Controller() : font(nullptr), audioEngine(nullptr), currentWindowWidth(0), currentWindowHeight(0),
-                           songLoaded(false), buttonView_(nullptr), songPlayRequested_(false) {
-    font = TextHelper::LoadFont("Roboto-SemiBold.ttf", 16);
+                           songLoaded(false), buttonView_(nullptr), songPlayRequested_(false),
+                           needsRedraw_(true) {
+    font = TextHelper::GetFont("Roboto-SemiBold.ttf", 16); // Owned by the font registry
     buttonView_ = new ButtonView();
     if (buttonView_) {
         buttonView_->initialize(font);
@@ -70,8 +181,8 @@ Controller::Controller() : font(nullptr), audioEngine(nullptr), currentWindowWid
 Controller::Controller(MusicApp::Audio::AudioEngine *audioE) : audioEngine(audioE), font(nullptr),
                                                                currentWindowWidth(0), currentWindowHeight(0),
                                                                songLoaded(false), buttonView_(nullptr),
-                                                               songPlayRequested_(false) {
-    font = TextHelper::LoadFont("Roboto-SemiBold.ttf", 16);
+                                                               songPlayRequested_(false), needsRedraw_(true) {
+    font = TextHelper::GetFont("Roboto-SemiBold.ttf", 16); // Owned by the font registry
     buttonView_ = new ButtonView();
     if (buttonView_) {
         buttonView_->initialize(font);
@@ -80,10 +191,7 @@ Controller::Controller(MusicApp::Audio::AudioEngine *audioE) : audioEngine(audio
 }
 
 Controller::~Controller() {
-    if (font) {
-        TTF_CloseFont(font);
-        font = nullptr;
-    }
+    font = nullptr; // Closed by TextHelper::CloseFonts()
     delete buttonView_;
     buttonView_ = nullptr;
 }
@@ -177,7 +285,7 @@ int Controller::handleButtonClick(float x, float y) {
 }
 
 void Controller::handleImportSong() {
-    SDL_DialogFileFilter filters[1] = {{"Text files", "txt"}};
+    SDL_DialogFileFilter filters[3] = {{"Text files", "txt"}, {"MIDI files", "mid;midi"}, {"Compiled scores", "mlsc"}};
     SDL_ShowOpenFileDialog(FileDialogCallback, this, nullptr, filters, SDL_arraysize(filters), nullptr, false);
 }
 
@@ -193,12 +301,30 @@ void Controller::handlePlaySongClicked(const std::string &instrumentName) {
     }
 }
 
+void Controller::handleExportSong(const std::string &instrumentName) {
+    if (!songLoaded) {
+        std::cerr << "Controller: No song loaded to export." << std::endl;
+        return;
+    }
+    exportInstrumentName_ = instrumentName;
+    SDL_DialogFileFilter filters[2] = {{"WAV audio", "wav"}, {"Raw PCM (16-bit stereo)", "pcm"}};
+    SDL_ShowSaveFileDialog(exportDialogCallback, this, nullptr, filters, SDL_arraysize(filters), nullptr);
+}
+
 std::string Controller::getCurrentInstrumentForSong() const {
     return currentInstrumentName_for_song_;
 }
 
-const std::vector<MusicalEvent> &Controller::getLoadedSongEvents() const {
-    return currentSongEvents_for_playback;
+const std::string &Controller::getLoadedScorePath() const {
+    return importedFilePath;
+}
+
+std::shared_ptr<const MusicApp::Audio::CompiledScore> Controller::getLoadedCompiledScore() const {
+    return compiledSong_;
+}
+
+std::shared_ptr<const Model::Score> Controller::getLoadedScore() const {
+    return midiSong_;
 }
 
 bool Controller::isSongReadyToPlay() const {
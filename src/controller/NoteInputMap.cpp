@@ -0,0 +1,60 @@
+#include "../../include/controller/NoteInputMap.h"
+#include "../../include/Core/Note.h"
+#include <cmath>
+
+NoteInputMap::NoteInputMap() : instrumentId(MusicApp::Audio::InstrumentId::Piano) {
+}
+
+void NoteInputMap::bindKey(SDL_Keycode key, int midiNumber, float velocity) {
+    if (!MusicApp::Core::Note::isInRange(midiNumber)) return;
+    keys[key] = {midiNumber, velocity};
+}
+
+void NoteInputMap::clearRegions() {
+    regions.clear();
+}
+
+void NoteInputMap::addRegion(const SDL_FRect &rect, int midiNumber, VelocityShape shape) {
+    if (!MusicApp::Core::Note::isInRange(midiNumber) || rect.w <= 0 || rect.h <= 0) return;
+    regions.push_back({rect, midiNumber, shape});
+}
+
+bool NoteInputMap::triggerForKey(SDL_Keycode key, NoteTrigger &trigger) const {
+    auto it = keys.find(key);
+    if (it == keys.end()) return false;
+
+    trigger = {instrumentId, it->second.midiNumber, it->second.velocity};
+    return true;
+}
+
+bool NoteInputMap::triggerAt(float x, float y, NoteTrigger &trigger) const {
+    for (auto it = regions.rbegin(); it != regions.rend(); ++it) {
+        const SDL_FRect &rect = it->rect;
+        if (x >= rect.x && x <= rect.x + rect.w && y >= rect.y && y <= rect.y + rect.h) {
+            trigger = {instrumentId, it->midiNumber, velocityAt(*it, x, y)};
+            return true;
+        }
+    }
+    return false;
+}
+
+float NoteInputMap::velocityAt(const Region &region, float x, float y) {
+    const float relativeX = (x - region.rect.x) / region.rect.w;
+    const float relativeY = (y - region.rect.y) / region.rect.h;
+
+    switch (region.shape) {
+        case VelocityShape::Vertical:
+            // Same curve as VideoGameAppController::handleVideoGameKeyClick
+            return SDL_clamp(0.3f + relativeY * 0.7f, 0.3f, 1.0f);
+        case VelocityShape::Strike: {
+            // Same curve as XylophoneAppController::handleXylophoneKeyClick
+            float distanceFromCenter = std::abs(relativeX - 0.5f) * 2.0f;
+            float verticalFactor = 1.0f - relativeY;
+            float velocity = 0.4f + ((distanceFromCenter * 0.5f) + (verticalFactor * 0.5f)) * 0.6f;
+            return SDL_clamp(velocity, 0.4f, 1.0f);
+        }
+        case VelocityShape::Fixed:
+        default:
+            return 1.0f;
+    }
+}
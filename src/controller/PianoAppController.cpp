@@ -2,9 +2,14 @@
 #include "../../include/model/Piano.h"
 #include "../../include/view/PianoView.h"
 #include "../../include/View/ButtonView.h"
-
-PianoAppController::PianoAppController(int windowWidth, int windowHeight, MusicApp::Audio::AudioEngine *audioE)
-        : Controller(audioE) {
+#include "../../include/controller/NoteInputMap.h"
+#include "../../include/Core/Note.h"
+#include "../../include/Audio/Synthesizer.h"
+
+PianoAppController::PianoAppController(int windowWidth, int windowHeight, MusicApp::Audio::AudioEngine *audioE,
+                                       const std::string &instrumentName)
+        : Controller(audioE), instrumentName(instrumentName),
+          instrumentId(MusicApp::Audio::Synthesizer::instrumentIdForName(instrumentName)) {
     // Mettre à jour les dimensions selon la taille de la fenêtre
     updateDimensions(windowWidth, windowHeight);
 
@@ -50,9 +55,7 @@ void PianoAppController::handlePianoKeyClick(float mouseX, float mouseY) {
 
     if (!pitchName.empty()) {
         MusicApp::Core::Note note(pitchName);
-        // Assuming "Piano" is the instrument name the SDLAudioEngine expects for piano sounds.
-        // This might need to be configurable or based on a more robust instrument mapping.
-        audioEngine->playSound("Piano", note);
+        audioEngine->playSound(instrumentName, note);
         // For debugging:
         // SDL_Log("Piano key clicked: %s", pitchName.c_str());
     }
@@ -63,7 +66,22 @@ void PianoAppController::handlePianoKeyHover(float mouseX, float mouseY) {
         return;
     }
 
+    int previousHoveredKey = piano->getHoveredKeyIndex();
     piano->updateHoveredKey(mouseX, mouseY);
+    if (piano->getHoveredKeyIndex() != previousHoveredKey) {
+        markDirty();
+    }
+}
+
+void PianoAppController::fillNoteInputMap(NoteInputMap &map) const {
+    map.setInstrument(instrumentId);
+    map.clearRegions();
+    if (!piano) return;
+
+    // Same order as Piano::getPitchAt: keys added last (black keys) win where they overlap
+    for (const PianoKey &key: piano->getPianoKeys()) {
+        map.addRegion(key.rect, MusicApp::Core::Note::parse(key.pitchName), NoteInputMap::VelocityShape::Fixed);
+    }
 }
 
 void PianoAppController::render(SDL_Renderer *renderer, int windowWidth, int windowHeight, bool isSongPlayingActive, bool isSongPaused) {
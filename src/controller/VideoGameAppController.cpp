@@ -3,11 +3,12 @@
 #include "../../include/view/VideoGameView.h"
 #include "../../include/view/ButtonView.h"
 #include "../../include/core/Note.h"
+#include "../../include/controller/NoteInputMap.h"
 #include "../../include/audio/AudioEngine.h"
 #include "../../include/audio/SDLAudioEngine.h"
 
 VideoGameAppController::VideoGameAppController(int windowWidth, int windowHeight, MusicApp::Audio::AudioEngine *audioE)
-        : Controller(audioE) {
+        : Controller(audioE), showAudioMetrics(false) {
     // Mettre à jour les dimensions selon la taille de la fenêtre
     updateDimensions(windowWidth, windowHeight);
 
@@ -71,10 +72,33 @@ void VideoGameAppController::handleVideoGameKeyHover(float mouseX, float mouseY)
     }
 
     // Mettre à jour l'état de survol du bouton
-    videoGame->updateHoveredButton(mouseX, mouseY);
+    bool buttonChanged = videoGame->updateHoveredButton(mouseX, mouseY);
 
     // Mettre à jour l'état de survol des contrôles
-    videoGame->updateHoveredControl(mouseX, mouseY);
+    bool controlChanged = videoGame->updateHoveredControl(mouseX, mouseY);
+
+    if (buttonChanged || controlChanged) {
+        markDirty();
+    }
+}
+
+void VideoGameAppController::fillNoteInputMap(NoteInputMap &map) const {
+    map.setInstrument(MusicApp::Audio::InstrumentId::Chiptune8Bit);
+    map.clearRegions();
+    if (!videoGame) return;
+
+    // Même ordre que VideoGame::getButtonAt (les touches noires, en fin de tableau, passent devant) et
+    // mêmes notes que getNoteAt ("8bit_N")
+    const std::vector<GameButton> &buttons = videoGame->getButtons();
+    for (size_t i = 0; i < buttons.size(); i++) {
+        map.addRegion(buttons[i].rect, MusicApp::Core::Note::parse("8bit_" + std::to_string(i)),
+                      NoteInputMap::VelocityShape::Vertical);
+    }
+}
+
+bool VideoGameAppController::isAnimating() const {
+    // Bouton survolé (pulsation) ou mesures audio en direct
+    return showAudioMetrics || (videoGame && videoGame->getHoveredButtonIndex() != -1);
 }
 
 void VideoGameAppController::processButtonAction(int buttonIndex) {
@@ -154,5 +178,12 @@ void VideoGameAppController::render(SDL_Renderer *renderer, int windowWidth, int
     SDL_RenderFillRect(renderer, &rightDigit);
 
     // Rendre l'instrument de jeu vidéo
+    MusicApp::Audio::SDLAudioEngine *engine = dynamic_cast<MusicApp::Audio::SDLAudioEngine *>(audioEngine);
+    if (showAudioMetrics && engine) {
+        MusicApp::Audio::AudioMetricsSnapshot metrics = engine->getMetrics();
+        videoGameView->setAudioMetrics(&metrics);
+    } else {
+        videoGameView->setAudioMetrics(nullptr);
+    }
     videoGameView->render(renderer, windowWidth, windowHeight);
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "../../include/core/Note.h"
 #include "../../include/audio/AudioEngine.h"
 #include "../../include/audio/SDLAudioEngine.h"
+#include "../../include/controller/NoteInputMap.h"
 
 XylophoneAppController::XylophoneAppController(int windowWidth, int windowHeight, MusicApp::Audio::AudioEngine *audioE)
         : Controller(audioE) {
@@ -131,8 +132,14 @@ void XylophoneAppController::handleXylophoneKeyHover(float mouseX, float mouseY)
     }
 
     // Mise à jour de l'état de survol des lames du xylophone
+    int previousHoveredBar = xylophone->getHoveredBarIndex();
     bool updated = xylophone->updateHoveredBar(mouseX, mouseY);
 
+    // Redessiner seulement si la lame survolée a changé
+    if (xylophone->getHoveredBarIndex() != previousHoveredBar) {
+        markDirty();
+    }
+
     // On pourrait ajouter ici du feedback audio léger au survol si nécessaire
     // Par exemple, jouer une note très douce ou afficher le nom de la note
 
@@ -143,6 +150,22 @@ void XylophoneAppController::handleXylophoneKeyHover(float mouseX, float mouseY)
     // }
 }
 
+void XylophoneAppController::fillNoteInputMap(NoteInputMap &map) const {
+    map.setInstrument(MusicApp::Audio::InstrumentId::Xylophone);
+    map.clearRegions();
+    if (!xylophone) return;
+
+    // Mêmes notes que handleXylophoneKeyClick : gamme de Do majeur de C4 à G5, C4 au-delà de 12 lames
+    static const int BAR_NOTES[] = {60, 62, 64, 65, 67, 69, 71, 72, 74, 76, 77, 79};
+    const int barNoteCount = static_cast<int>(sizeof(BAR_NOTES) / sizeof(BAR_NOTES[0]));
+    const std::vector<XylophoneBar> &bars = xylophone->getXylophoneBars();
+    // Les lames ne se chevauchent pas : l'ordre de test n'a pas d'importance
+    for (int i = 0; i < static_cast<int>(bars.size()); i++) {
+        map.addRegion(bars[i].rect, i < barNoteCount ? BAR_NOTES[i] : BAR_NOTES[0],
+                      NoteInputMap::VelocityShape::Strike);
+    }
+}
+
 void XylophoneAppController::render(SDL_Renderer *renderer, int windowWidth, int windowHeight, bool isSongPlayingActive, bool isSongPaused) {
     updateDimensions(windowWidth, windowHeight);
 
@@ -1,14 +1,145 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
 #include "../include/Application.h"
+#include "../include/Audio/OfflineRenderer.h"
+#include "../include/Audio/Tuning.h"
+#include "../include/Audio/CompiledScore.h"
+#include "../include/Audio/ScoreTextParser.h"
+#include "../include/Audio/MidiFileReader.h"
+
+// Même chemin, avec l'extension remplacée (ou ajoutée si le fichier n'en a pas)
+static std::string replaceExtension(const std::string &path, const std::string &extension) {
+    const size_t dot = path.find_last_of('.');
+    const size_t lastSlash = path.find_last_of("/\\");
+    const bool hasExtension = dot != std::string::npos && (lastSlash == std::string::npos || dot > lastSlash);
+    return (hasExtension ? path.substr(0, dot) : path) + extension;
+}
+
+// Options d'accord, communes aux deux modes : --tuning <equal|just|pythagorean|gamme.scl> --a4 <Hz>
+// Elles sont retirées de args ; renvoie false si une option est invalide.
+static bool parseTuningOptions(std::vector<std::string> &args, MusicApp::Audio::TuningTable &tuning) {
+    std::string tuningName = "equal";
+    float referenceFrequency = MusicApp::Audio::Tunings::DEFAULT_REFERENCE_FREQUENCY;
+
+    std::vector<std::string> remaining;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if ((args[i] == "--tuning" || args[i] == "--a4") && i + 1 >= args.size()) {
+            std::cerr << "Missing value after " << args[i] << std::endl;
+            return false;
+        }
+        if (args[i] == "--tuning") {
+            tuningName = args[++i];
+        } else if (args[i] == "--a4") {
+            referenceFrequency = std::strtof(args[++i].c_str(), nullptr);
+            if (referenceFrequency <= 0.0f) {
+                std::cerr << "Invalid A4 reference frequency '" << args[i] << "'" << std::endl;
+                return false;
+            }
+        } else {
+            remaining.push_back(args[i]);
+        }
+    }
+    args.swap(remaining);
+    return MusicApp::Audio::Tunings::fromName(tuningName, referenceFrequency, tuning);
+}
+
+// Partition texte ou fichier MIDI, en enregistrements datés en trames ; false si rien n'est jouable
+static bool readScore(const std::string &scorePath, std::vector<MusicApp::Audio::ScoreEventRecord> &events,
+                      Uint64 &lengthFrames) {
+    if (MusicApp::Audio::MidiFileReader::isMidiPath(scorePath)) {
+        MusicApp::Audio::MidiFileReader::Result midi;
+        if (!MusicApp::Audio::MidiFileReader::read(scorePath, midi)) {
+            return false;
+        }
+        events = std::move(midi.events);
+        lengthFrames = midi.lengthFrames;
+        return true;
+    }
+
+    MusicApp::Audio::ScoreTextParser::Result score = MusicApp::Audio::ScoreTextParser::parseFile(scorePath);
+    MusicApp::Audio::ScoreTextParser::reportErrors(scorePath, score.errors, score.errorCount);
+    events = std::move(score.events);
+    lengthFrames = score.lengthFrames;
+    return !events.empty();
+}
+
+// Mode par lots : MusicaLau --render <Piano|Xylophone|8BitConsole|Guitar> <partition.txt|morceau.mid>...
+// Chaque partition est rendue hors ligne à côté du fichier source (même nom, extension .wav).
+static int renderScores(const std::vector<std::string> &args, const MusicApp::Audio::TuningTable &tuning) {
+    if (args.size() < 4) {
+        std::cerr << "Usage: " << args[0] << " --render <Piano|Xylophone|8BitConsole|Guitar> <score.txt|song.mid>..."
+                  << " [--tuning <equal|just|pythagorean|scale.scl>] [--a4 <Hz>]" << std::endl;
+        return -1;
+    }
+
+    const std::string instrumentName = args[2];
+    MusicApp::Audio::OfflineRenderer renderer;
+    renderer.setTuning(tuning);
+    int failures = 0;
+    for (size_t i = 3; i < args.size(); ++i) {
+        const std::string &scorePath = args[i];
+        const std::string outputPath = replaceExtension(scorePath, ".wav");
+
+        std::vector<MusicApp::Audio::ScoreEventRecord> events;
+        Uint64 lengthFrames = 0;
+        if (!readScore(scorePath, events, lengthFrames) ||
+            !renderer.renderToFile(events.data(), events.size(), lengthFrames, instrumentName, outputPath)) {
+            std::cerr << "Failed to render " << scorePath << std::endl;
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : -1;
+}
+
+// Conversion par lots : MusicaLau --compile <partition.txt|morceau.mid>...
+// Chaque partition texte ou fichier MIDI est compilé à côté du fichier source (même nom, extension .mlsc).
+static int compileScores(const std::vector<std::string> &args) {
+    if (args.size() < 3) {
+        std::cerr << "Usage: " << args[0] << " --compile <score.txt|song.mid>..." << std::endl;
+        return -1;
+    }
+
+    int failures = 0;
+    for (size_t i = 2; i < args.size(); ++i) {
+        const std::string &scorePath = args[i];
+        const std::string outputPath = replaceExtension(scorePath, MusicApp::Audio::CompiledScore::FILE_EXTENSION);
+
+        std::vector<MusicApp::Audio::ScoreEventRecord> events;
+        Uint64 lengthFrames = 0;
+        if (!readScore(scorePath, events, lengthFrames) ||
+            !MusicApp::Audio::CompiledScore::write(outputPath, std::move(events), lengthFrames)) {
+            std::cerr << "Failed to compile " << scorePath << std::endl;
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : -1;
+}
 
 int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv, argv + argc);
+    MusicApp::Audio::TuningTable tuning;
+    if (!parseTuningOptions(args, tuning)) {
+        return -1;
+    }
+
+    if (args.size() > 1 && args[1] == "--render") {
+        return renderScores(args, tuning);
+    }
+    if (args.size() > 1 && args[1] == "--compile") {
+        return compileScores(args);
+    }
+
     Application app;
     if (!app.initialize()) {
         return -1;
     }
+    app.setTuning(tuning);
 
     app.run();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -2,7 +2,8 @@
 #include <array> // For pitch names
 
 Piano::Piano(float x, float y, float width, float height, int octaves)
-        : x(x), y(y), width(width), height(height), octaves(octaves), hoveredKeyIndex(-1) {
+        : x(x), y(y), width(width), height(height), octaves(octaves), hoveredKeyIndex(-1),
+          layoutVersion(0) {
     calculateKeyLayout(); // Calculate keys on construction
 }
 
@@ -31,6 +32,8 @@ void Piano::removeOctave() {
 }
 
 void Piano::calculateKeyLayout() {
+    layoutVersion++;
+
     // Sauvegarder l'index de la touche survolée avant de réinitialiser
     int previousHoveredIndex = hoveredKeyIndex;
     std::string previousHoveredPitchName;
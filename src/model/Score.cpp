@@ -3,3 +3,192 @@
 //
 
 #include "../../include/Model/Score.h"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+namespace Model {
+
+    namespace {
+        // Reorders one column along a permutation computed once for all columns
+        template<typename T>
+        void applyPermutation(std::vector<T> &column, const std::vector<std::size_t> &order) {
+            std::vector<T> sorted;
+            sorted.reserve(column.size());
+            for (std::size_t index: order) sorted.push_back(column[index]);
+            column.swap(sorted);
+        }
+    }
+
+    constexpr std::size_t Score::MAX_TRACKS;
+
+    std::size_t Score::addTrack(const std::string &name, InstrumentId instrument) {
+        if (tracks_.size() >= MAX_TRACKS) {
+            std::cerr << "Score: Too many tracks, '" << name << "' is merged into the last one." << std::endl;
+            return tracks_.size() - 1;
+        }
+        tracks_.push_back({name, instrument});
+        return tracks_.size() - 1;
+    }
+
+    void Score::setTrackInstrument(std::size_t track, InstrumentId instrument) {
+        if (track >= tracks_.size()) return;
+        tracks_[track].instrument = instrument;
+        for (std::size_t i = 0; i < trackIndices_.size(); ++i) {
+            if (trackIndices_[i] == track) instruments_[i] = instrument;
+        }
+    }
+
+    void Score::setInstrument(InstrumentId instrument) {
+        for (ScoreTrack &track: tracks_) track.instrument = instrument;
+        std::fill(instruments_.begin(), instruments_.end(), instrument);
+    }
+
+    void Score::addEvent(Uint64 onsetFrame, Uint32 durationFrames, Uint8 midiNumber, Uint8 velocity,
+                         std::size_t track) {
+        if (track >= tracks_.size()) {
+            std::cerr << "Score: Event added to unknown track " << track << ", ignored." << std::endl;
+            return;
+        }
+        push(onsetFrame, durationFrames, midiNumber, velocity, static_cast<Uint16>(track), tracks_[track].instrument);
+    }
+
+    void Score::addEvent(Uint64 onsetFrame, Uint32 durationFrames, Uint8 midiNumber, Uint8 velocity,
+                         std::size_t track, InstrumentId instrument) {
+        if (track >= tracks_.size()) {
+            std::cerr << "Score: Event added to unknown track " << track << ", ignored." << std::endl;
+            return;
+        }
+        push(onsetFrame, durationFrames, midiNumber, velocity, static_cast<Uint16>(track), instrument);
+    }
+
+    void Score::appendRecords(const MusicApp::Audio::ScoreEventRecord *records, std::size_t count,
+                              std::size_t track) {
+        if (track >= tracks_.size()) {
+            std::cerr << "Score: Events added to unknown track " << track << ", ignored." << std::endl;
+            return;
+        }
+        reserve(size() + count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const MusicApp::Audio::ScoreEventRecord &record = records[i];
+            push(record.onsetFrame, record.durationFrames, record.midiNumber, record.velocity,
+                 static_cast<Uint16>(track), tracks_[track].instrument);
+        }
+    }
+
+    void Score::push(Uint64 onsetFrame, Uint32 durationFrames, Uint8 midiNumber, Uint8 velocity, Uint16 track,
+                     InstrumentId instrument) {
+        if (!onsetFrames_.empty() && onsetFrame < onsetFrames_.back()) {
+            sorted_ = false;
+        }
+        const Uint64 endFrame = onsetFrame + durationFrames;
+        onsetFrames_.push_back(onsetFrame);
+        durationFrames_.push_back(durationFrames);
+        midiNumbers_.push_back(midiNumber);
+        velocities_.push_back(velocity);
+        instruments_.push_back(instrument);
+        trackIndices_.push_back(track);
+        maxEndFrames_.push_back(maxEndFrames_.empty() ? endFrame : std::max(maxEndFrames_.back(), endFrame));
+        lengthFrames_ = std::max(lengthFrames_, endFrame);
+    }
+
+    void Score::reserve(std::size_t eventCount) {
+        onsetFrames_.reserve(eventCount);
+        durationFrames_.reserve(eventCount);
+        midiNumbers_.reserve(eventCount);
+        velocities_.reserve(eventCount);
+        instruments_.reserve(eventCount);
+        trackIndices_.reserve(eventCount);
+        maxEndFrames_.reserve(eventCount);
+    }
+
+    void Score::clear() {
+        tracks_.clear();
+        onsetFrames_.clear();
+        durationFrames_.clear();
+        midiNumbers_.clear();
+        velocities_.clear();
+        instruments_.clear();
+        trackIndices_.clear();
+        maxEndFrames_.clear();
+        lengthFrames_ = 0;
+        sorted_ = true;
+    }
+
+    void Score::sortByOnset() {
+        if (sorted_) return;
+
+        // Stable: events sharing an onset keep their insertion order
+        std::vector<std::size_t> order(size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+            return onsetFrames_[a] < onsetFrames_[b];
+        });
+        applyPermutation(onsetFrames_, order);
+        applyPermutation(durationFrames_, order);
+        applyPermutation(midiNumbers_, order);
+        applyPermutation(velocities_, order);
+        applyPermutation(instruments_, order);
+        applyPermutation(trackIndices_, order);
+
+        Uint64 maxEnd = 0;
+        for (std::size_t i = 0; i < size(); ++i) {
+            maxEnd = std::max(maxEnd, endFrame(i));
+            maxEndFrames_[i] = maxEnd;
+        }
+        sorted_ = true;
+    }
+
+    void Score::setLengthFrames(Uint64 frames) {
+        lengthFrames_ = std::max(frames, maxEndFrames_.empty() ? Uint64(0) : maxEndFrames_.back());
+    }
+
+    Score::SeekPosition Score::seek(Uint64 frame) const {
+        SeekPosition position;
+        position.next = static_cast<std::size_t>(
+                std::lower_bound(onsetFrames_.begin(), onsetFrames_.end(), frame) - onsetFrames_.begin());
+        // Before the first running maximum past frame, every note has already ended
+        position.firstActive = static_cast<std::size_t>(
+                std::upper_bound(maxEndFrames_.begin(), maxEndFrames_.begin() + position.next, frame) -
+                maxEndFrames_.begin());
+        return position;
+    }
+
+    std::vector<Score> Score::splitByTrack() const {
+        std::vector<Score> parts(tracks_.size());
+        for (std::size_t track = 0; track < tracks_.size(); ++track) {
+            parts[track].addTrack(tracks_[track].name, tracks_[track].instrument);
+        }
+        // A single pass: each part is sorted whenever this score is
+        for (std::size_t i = 0; i < size(); ++i) {
+            parts[trackIndices_[i]].push(onsetFrames_[i], durationFrames_[i], midiNumbers_[i], velocities_[i], 0,
+                                         instruments_[i]);
+        }
+        for (Score &part: parts) {
+            part.setLengthFrames(lengthFrames_);
+        }
+        return parts;
+    }
+
+    Score Score::fromRecords(const MusicApp::Audio::ScoreEventRecord *records, std::size_t count,
+                             Uint64 lengthFrames, InstrumentId instrument) {
+        Score score;
+        score.reserve(count);
+
+        std::size_t channelTracks[256];
+        std::fill(std::begin(channelTracks), std::end(channelTracks), MAX_TRACKS);
+        for (std::size_t i = 0; i < count; ++i) {
+            const MusicApp::Audio::ScoreEventRecord &record = records[i];
+            std::size_t &track = channelTracks[record.channel];
+            if (track == MAX_TRACKS) {
+                track = score.addTrack("Channel " + std::to_string(record.channel + 1), instrument);
+            }
+            score.push(record.onsetFrame, record.durationFrames, record.midiNumber, record.velocity,
+                       static_cast<Uint16>(track), instrument);
+        }
+        score.sortByOnset();
+        score.setLengthFrames(lengthFrames);
+        return score;
+    }
+
+} // namespace Model
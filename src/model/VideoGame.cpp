@@ -6,7 +6,7 @@
 
 VideoGame::VideoGame(float x, float y, float width, float height, int keys)
         : x(x), y(y), width(width), height(height), keys(keys),
-          hoveredButtonIndex(-1), hoveredControlIndex(-1) {
+          hoveredButtonIndex(-1), hoveredControlIndex(-1), layoutVersion(0) {
     calculateButtonsLayout();
     calculateControlsLayout();
 }
@@ -36,6 +36,7 @@ void VideoGame::removeKeys() {
 }
 
 void VideoGame::calculateButtonsLayout() {
+    layoutVersion++;
     buttons.clear();
 
     const int NOTES_PER_OCTAVE = 12;
@@ -118,6 +119,7 @@ void VideoGame::calculateButtonsLayout() {
 }
 
 void VideoGame::calculateControlsLayout() {
+    layoutVersion++;
     controls.clear();
 
     float consoleWidth = width * 0.98f;
@@ -5,7 +5,8 @@
 #include "../../include/Model/Xylophone.h"
 
 Xylophone::Xylophone(float x, float y, float width, float height, int bars)
-        : x(x), y(y), width(width), height(height), bars(bars), hoveredBarIndex(-1) {
+        : x(x), y(y), width(width), height(height), bars(bars), hoveredBarIndex(-1),
+          layoutVersion(0) {
     calculateBarsLayout();
 }
 
@@ -36,6 +37,8 @@ void Xylophone::removeBar() {
 }
 
 void Xylophone::calculateBarsLayout() {
+    layoutVersion++;
+
     // Sauvegarder l'index de la lame survolée
     int previousHoveredIndex = hoveredBarIndex;
 
@@ -1,5 +1,6 @@
 #include "../../include/utils/DropdownMenu.h"
 #include "../../include/utils/TextHelper.h"
+#include "../../include/utils/TextCache.h"
 #include <SDL3/SDL_ttf.h>
 #include <iostream>
 
@@ -15,18 +16,16 @@ DropdownMenu::DropdownMenu(float x, float y, float width, float height, const st
     hoverColor = {150, 190, 220, 255}; // Bleu plus foncé
     darkBlue = {100, 150, 200, 255};
 
-    // Charger la police avec l'utilitaire
-    font = TextHelper::LoadFont("Roboto-SemiBold.ttf", 16);
+    // Police partagée du registre (ouverte une seule fois par processus)
+    font = TextHelper::GetFont("Roboto-SemiBold.ttf", 16);
 
     // Ajouter le label d'en-tête
     itemLabels.push_back(headerLabel);
 }
 
 DropdownMenu::~DropdownMenu() {
-    if (font) {
-        TTF_CloseFont(font);
-        font = nullptr;
-    }
+    // La police appartient au registre de TextHelper
+    font = nullptr;
 }
 
 void DropdownMenu::addItem(const std::string &label, std::function<void()> action) {
@@ -48,33 +47,22 @@ void DropdownMenu::render(SDL_Renderer *renderer) {
     if (!renderer) return;
 
     // Dessiner l'en-tête
-    SDL_SetRenderDrawColor(renderer, headerColor.r, headerColor.g, headerColor.b, headerColor.a);
-    SDL_RenderFillRect(renderer, &headerRect);
+    geometry.setColor(headerColor.r, headerColor.g, headerColor.b, headerColor.a);
+    geometry.fillRect(headerRect);
 
     // Dessiner une bordure noire autour de l'en-tête
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderRect(renderer, &headerRect);
+    geometry.setColor(0, 0, 0, 255);
+    geometry.rect(headerRect);
 
     // Dessiner un indicateur visuel pour le titre - une petite barre plus foncée
-    SDL_SetRenderDrawColor(renderer, darkBlue.r, darkBlue.g, darkBlue.b, darkBlue.a);
+    geometry.setColor(darkBlue.r, darkBlue.g, darkBlue.b, darkBlue.a);
     SDL_FRect titleBar = {
             headerRect.x + 10,  // Un peu d'espace à gauche
             headerRect.y + 5,   // Un peu d'espace en haut
             30,                 // Largeur fixe
             headerRect.h - 10   // Presque toute la hauteur
     };
-    SDL_RenderFillRect(renderer, &titleBar);
-
-    // Afficher le texte sélectionné dans l'en-tête
-    if (itemLabels.size() > 0) {
-        SDL_FRect textRect = {
-                headerRect.x + 50, // Après la barre de titre
-                headerRect.y + 5,
-                headerRect.w - 100, // Laisser de l'espace pour l'indicateur
-                headerRect.h - 10
-        };
-        renderText(renderer, itemLabels[0], textRect, textColor);
-    }
+    geometry.fillRect(titleBar);
 
     // Positionnement et dimensions pour l'indicateur de menu déroulant 
     float triangleSize = headerRect.h * 0.3f;
@@ -89,8 +77,8 @@ void DropdownMenu::render(SDL_Renderer *renderer) {
             circleSize,
             circleSize
     };
-    SDL_SetRenderDrawColor(renderer, darkBlue.r, darkBlue.g, darkBlue.b, darkBlue.a);
-    SDL_RenderFillRect(renderer, &circleRect);
+    geometry.setColor(darkBlue.r, darkBlue.g, darkBlue.b, darkBlue.a);
+    geometry.fillRect(circleRect);
 
     // Centre exact du cercle
     float circleCenterX = circleRect.x + circleRect.w / 2;
@@ -107,12 +95,25 @@ void DropdownMenu::render(SDL_Renderer *renderer) {
     points[2] = {triangleLeft + triangleSize / 2, triangleTop + triangleSize};
 
     // On trace un triangle en blanc
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    geometry.setColor(255, 255, 255, 255);
     for (int i = 0; i < 3; i++) {
         int next = (i + 1) % 3;
-        SDL_RenderLine(renderer,
-                       points[i].x, points[i].y,
-                       points[next].x, points[next].y);
+        geometry.line(points[i].x, points[i].y,
+                      points[next].x, points[next].y);
+    }
+
+    // Formes de l'en-tête en un seul appel, puis son texte par-dessus
+    geometry.flush(renderer);
+
+    // Afficher le texte sélectionné dans l'en-tête
+    if (itemLabels.size() > 0) {
+        SDL_FRect textRect = {
+                headerRect.x + 50, // Après la barre de titre
+                headerRect.y + 5,
+                headerRect.w - 100, // Laisser de l'espace pour l'indicateur
+                headerRect.h - 10
+        };
+        renderText(renderer, itemLabels[0], textRect, textColor);
     }
 
     // Si le menu est ouvert, dessiner les éléments
@@ -120,29 +121,45 @@ void DropdownMenu::render(SDL_Renderer *renderer) {
         for (size_t i = 0; i < itemRects.size(); ++i) {
             // Utiliser une couleur différente pour l'élément survolé
             if (static_cast<int>(i) == selectedIndex) {
-                SDL_SetRenderDrawColor(renderer, hoverColor.r, hoverColor.g, hoverColor.b, hoverColor.a);
+                geometry.setColor(hoverColor.r, hoverColor.g, hoverColor.b, hoverColor.a);
             } else {
-                SDL_SetRenderDrawColor(renderer, itemColor.r, itemColor.g, itemColor.b, itemColor.a);
+                geometry.setColor(itemColor.r, itemColor.g, itemColor.b, itemColor.a);
             }
 
-            SDL_RenderFillRect(renderer, &itemRects[i]);
+            geometry.fillRect(itemRects[i]);
 
             // Dessiner une bordure noire
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-            SDL_RenderRect(renderer, &itemRects[i]);
+            geometry.setColor(0, 0, 0, 255);
+            geometry.rect(itemRects[i]);
 
             // Ajouter une séparation entre les éléments
             if (i > 0) {
-                SDL_SetRenderDrawColor(renderer, 150, 150, 150, 255);
+                geometry.setColor(150, 150, 150, 255);
                 SDL_FRect separatorLine = {
                         itemRects[i].x + 5,
                         itemRects[i].y,
                         itemRects[i].w - 10,
                         1
                 };
-                SDL_RenderFillRect(renderer, &separatorLine);
+                geometry.fillRect(separatorLine);
             }
 
+            // Ajouter un indicateur de sélection pour l'élément actif
+            if (i < itemRects.size() && i + 1 < itemLabels.size() && itemLabels[i + 1] == itemLabels[0]) {
+                geometry.setColor(darkBlue.r, darkBlue.g, darkBlue.b, darkBlue.a);
+                SDL_FRect activeIndicator = {
+                        itemRects[i].x + 10,
+                        itemRects[i].y + itemRects[i].h / 2 - 5,
+                        10,
+                        10
+                };
+                geometry.fillRect(activeIndicator);
+            }
+        }
+
+        // Formes de tous les éléments en un seul appel, puis leurs textes
+        geometry.flush(renderer);
+        for (size_t i = 0; i < itemRects.size(); ++i) {
             // Afficher le texte pour chaque élément
             if (i < itemRects.size() && i + 1 < itemLabels.size()) {
                 SDL_FRect textRect = {
@@ -153,26 +170,15 @@ void DropdownMenu::render(SDL_Renderer *renderer) {
                 };
                 renderText(renderer, itemLabels[i + 1], textRect, textColor);
             }
-
-            // Ajouter un indicateur de sélection pour l'élément actif
-            if (i < itemRects.size() && i + 1 < itemLabels.size() && itemLabels[i + 1] == itemLabels[0]) {
-                SDL_SetRenderDrawColor(renderer, darkBlue.r, darkBlue.g, darkBlue.b, darkBlue.a);
-                SDL_FRect activeIndicator = {
-                        itemRects[i].x + 10,
-                        itemRects[i].y + itemRects[i].h / 2 - 5,
-                        10,
-                        10
-                };
-                SDL_RenderFillRect(renderer, &activeIndicator);
-            }
         }
     }
 }
 
-void DropdownMenu::updateHoverState(float x, float y) {
+bool DropdownMenu::updateHoverState(float x, float y) {
+    int previousIndex = selectedIndex;
     selectedIndex = -1;
 
-    if (!isOpen) return;
+    if (!isOpen) return previousIndex != selectedIndex;
 
     for (size_t i = 0; i < itemRects.size(); ++i) {
         if (x >= itemRects[i].x && x <= itemRects[i].x + itemRects[i].w &&
@@ -181,6 +187,7 @@ void DropdownMenu::updateHoverState(float x, float y) {
             break;
         }
     }
+    return previousIndex != selectedIndex;
 }
 
 bool DropdownMenu::handleClick(float x, float y) {
@@ -228,26 +235,13 @@ void DropdownMenu::toggleOpen() {
 void DropdownMenu::renderText(SDL_Renderer *renderer, const std::string &text, SDL_FRect &targetRect, SDL_Color color) {
     if (!font || !renderer || text.empty()) return;
 
-    // Créer une surface de texte
-    SDL_Surface *textSurface = TextHelper::RenderTextSolid(font, text, color);
-    if (!textSurface) {
-        std::cerr << "Erreur lors du rendu du texte : " << SDL_GetError() << std::endl;
-        return;
-    }
-
-    // Créer une texture à partir de la surface
-    SDL_Texture *textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    SDL_DestroySurface(textSurface);
-
-    if (!textTexture) {
-        std::cerr << "Erreur lors de la création de la texture : " << SDL_GetError() << std::endl;
-        return;
-    }
-
-    // Calculer la position pour centrer verticalement le texte
+    // Texture conservée d'une image à l'autre par le cache partagé
     float textWidth, textHeight;
-    SDL_GetTextureSize(textTexture, &textWidth, &textHeight);
+    SDL_Texture *textTexture = TextHelper::TextCache::shared().get(renderer, font, text, color, &textWidth,
+                                                                   &textHeight);
+    if (!textTexture) return;
 
+    // Calculer la position pour centrer verticalement le texte
     SDL_FRect renderRect = {
             targetRect.x,
             targetRect.y + (targetRect.h - textHeight) / 2, // Centrage vertical
@@ -262,5 +256,4 @@ void DropdownMenu::renderText(SDL_Renderer *renderer, const std::string &text, S
 
     // Afficher la texture
     SDL_RenderTexture(renderer, textTexture, NULL, &renderRect);
-    SDL_DestroyTexture(textTexture);
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "../../include/utils/GeometryBatch.h"
+#include <cmath>
+#include <iostream>
+
+GeometryBatch::GeometryBatch() : color{1.0f, 1.0f, 1.0f, 1.0f} {
+}
+
+void GeometryBatch::setColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    color = {r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f};
+}
+
+void GeometryBatch::setColor(const SDL_Color &newColor) {
+    setColor(newColor.r, newColor.g, newColor.b, newColor.a);
+}
+
+void GeometryBatch::quad(const SDL_FPoint &a, const SDL_FPoint &b, const SDL_FPoint &c, const SDL_FPoint &d) {
+    const int first = static_cast<int>(vertices.size());
+    const SDL_FPoint noTexture = {0.0f, 0.0f};
+    vertices.push_back({a, color, noTexture});
+    vertices.push_back({b, color, noTexture});
+    vertices.push_back({c, color, noTexture});
+    vertices.push_back({d, color, noTexture});
+
+    const int quadIndices[] = {first, first + 1, first + 2, first, first + 2, first + 3};
+    indices.insert(indices.end(), quadIndices, quadIndices + 6);
+}
+
+void GeometryBatch::fillRect(const SDL_FRect &rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    quad({rect.x, rect.y}, {rect.x + rect.w, rect.y}, {rect.x + rect.w, rect.y + rect.h}, {rect.x, rect.y + rect.h});
+}
+
+void GeometryBatch::rect(const SDL_FRect &rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    // Bandes d'un pixel à l'intérieur du rectangle, comme SDL_RenderRect
+    fillRect({rect.x, rect.y, rect.w, 1});
+    if (rect.h > 1) fillRect({rect.x, rect.y + rect.h - 1, rect.w, 1});
+    if (rect.h > 2) {
+        fillRect({rect.x, rect.y + 1, 1, rect.h - 2});
+        if (rect.w > 1) fillRect({rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2});
+    }
+}
+
+void GeometryBatch::line(float x1, float y1, float x2, float y2) {
+    // Bande d'un pixel passant par le centre des pixels des extrémités, prolongée d'un demi-pixel de chaque côté
+    // pour couvrir les deux extrémités comme SDL_RenderLine
+    const float dx = x2 - x1;
+    const float dy = y2 - y1;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    const float ux = length > 0 ? dx / length * 0.5f : 0.5f;
+    const float uy = length > 0 ? dy / length * 0.5f : 0.0f;
+    const float startX = x1 + 0.5f - ux, startY = y1 + 0.5f - uy;
+    const float endX = x2 + 0.5f + ux, endY = y2 + 0.5f + uy;
+    quad({startX + uy, startY - ux}, {endX + uy, endY - ux}, {endX - uy, endY + ux}, {startX - uy, startY + ux});
+}
+
+void GeometryBatch::triangle(const SDL_FPoint &a, const SDL_FPoint &b, const SDL_FPoint &c) {
+    const int first = static_cast<int>(vertices.size());
+    const SDL_FPoint noTexture = {0.0f, 0.0f};
+    vertices.push_back({a, color, noTexture});
+    vertices.push_back({b, color, noTexture});
+    vertices.push_back({c, color, noTexture});
+    indices.push_back(first);
+    indices.push_back(first + 1);
+    indices.push_back(first + 2);
+}
+
+void GeometryBatch::clear() {
+    vertices.clear();
+    indices.clear();
+}
+
+bool GeometryBatch::flush(SDL_Renderer *renderer) {
+    if (empty()) return true;
+    bool drawn = renderer && SDL_RenderGeometry(renderer, nullptr, vertices.data(), static_cast<int>(vertices.size()),
+                                                indices.data(), static_cast<int>(indices.size()));
+    if (!drawn) {
+        std::cerr << "GeometryBatch Error: Failed to render geometry: " << SDL_GetError() << std::endl;
+    }
+    clear();
+    return drawn;
+}
@@ -0,0 +1,79 @@
+#include "../../include/utils/TextCache.h"
+#include "../../include/utils/TextHelper.h"
+#include <functional>
+#include <iostream>
+
+namespace TextHelper {
+    constexpr std::size_t TextCache::DEFAULT_CAPACITY;
+
+    std::size_t TextCache::KeyHash::operator()(const Key &key) const {
+        std::size_t hash = std::hash<std::string>()(key.text);
+        hash ^= std::hash<const void *>()(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<const void *>()(key.renderer) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<Uint32>()(key.color) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    TextCache::TextCache(std::size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {
+    }
+
+    TextCache::~TextCache() {
+        clear();
+    }
+
+    TextCache &TextCache::shared() {
+        static TextCache cache;
+        return cache;
+    }
+
+    SDL_Texture *TextCache::get(SDL_Renderer *renderer, TTF_Font *font, const std::string &text, SDL_Color color,
+                                float *width, float *height) {
+        if (!renderer || !font || text.empty()) return nullptr;
+
+        Key key = {renderer, font, text,
+                   (static_cast<Uint32>(color.r) << 24) | (static_cast<Uint32>(color.g) << 16) |
+                   (static_cast<Uint32>(color.b) << 8) | color.a};
+
+        auto found = index_.find(key);
+        if (found == index_.end()) {
+            SDL_Surface *textSurface = RenderTextSolid(font, text, color);
+            if (!textSurface) {
+                std::cerr << "TextCache Error: Failed to render text surface: " << SDL_GetError() << std::endl;
+                return nullptr;
+            }
+            SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, textSurface);
+            SDL_DestroySurface(textSurface);
+            if (!texture) {
+                std::cerr << "TextCache Error: Failed to create text texture: " << SDL_GetError() << std::endl;
+                return nullptr;
+            }
+
+            // Place libérée avant l'insertion : le texte le moins récemment affiché est détruit
+            if (entries_.size() >= capacity_) {
+                SDL_DestroyTexture(entries_.back().texture);
+                index_.erase(entries_.back().key);
+                entries_.pop_back();
+            }
+
+            Entry entry = {key, texture, 0.0f, 0.0f};
+            SDL_GetTextureSize(texture, &entry.width, &entry.height);
+            entries_.push_front(std::move(entry));
+            found = index_.emplace(std::move(key), entries_.begin()).first;
+        } else if (found->second != entries_.begin()) {
+            entries_.splice(entries_.begin(), entries_, found->second);
+        }
+
+        const Entry &entry = *found->second;
+        if (width) *width = entry.width;
+        if (height) *height = entry.height;
+        return entry.texture;
+    }
+
+    void TextCache::clear() {
+        for (Entry &entry: entries_) {
+            SDL_DestroyTexture(entry.texture);
+        }
+        entries_.clear();
+        index_.clear();
+    }
+}
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <array>
 #include <filesystem>
+#include <map>
+#include <utility>
 #include <vector>
 
 namespace TextHelper {
@@ -14,6 +16,36 @@ namespace TextHelper {
         return TTF_OpenFont("C:/Windows/Fonts/arial.ttf", ptsize);
     }
 
+    namespace {
+        // Polices ouvertes, par (fichier, taille) ; un échec est aussi mémorisé pour ne pas relire le disque
+        std::map<std::pair<std::string, int>, TTF_Font *> &fontRegistry() {
+            static std::map<std::pair<std::string, int>, TTF_Font *> fonts;
+            return fonts;
+        }
+    }
+
+    TTF_Font *GetFont(const std::string &fontName, int ptsize) {
+        std::map<std::pair<std::string, int>, TTF_Font *> &fonts = fontRegistry();
+        const std::pair<std::string, int> key(fontName, ptsize);
+        auto found = fonts.find(key);
+        if (found != fonts.end()) return found->second;
+
+        TTF_Font *font = LoadFont(fontName, ptsize);
+        if (!font) {
+            std::cerr << "TextHelper Error: Could not load font " << fontName << " (" << ptsize << " pt): "
+                      << SDL_GetError() << std::endl;
+        }
+        fonts.emplace(key, font);
+        return font;
+    }
+
+    void CloseFonts() {
+        for (auto &entry: fontRegistry()) {
+            if (entry.second) TTF_CloseFont(entry.second);
+        }
+        fontRegistry().clear();
+    }
+
     SDL_Surface *RenderTextSolid(TTF_Font *font, const std::string &text, SDL_Color fg) {
         return TTF_RenderText_Solid(font, text.c_str(), text.length(), fg);
     }
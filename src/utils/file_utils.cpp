@@ -3,3 +3,119 @@
 //
 
 #include "../../include/utils/file_utils.h"
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string &filePath) {
+    close();
+
+    // Les chemins des boîtes de dialogue SDL sont en UTF-8
+    int wideLength = MultiByteToWideChar(CP_UTF8, 0, filePath.c_str(), -1, nullptr, 0);
+    std::wstring widePath(wideLength > 0 ? wideLength : 0, L'\0');
+    if (wideLength <= 0 || MultiByteToWideChar(CP_UTF8, 0, filePath.c_str(), -1, &widePath[0], wideLength) <= 0) {
+        std::cerr << "MappedFile: Invalid path " << filePath << std::endl;
+        return false;
+    }
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "MappedFile: Could not open " << filePath << std::endl;
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        std::cerr << "MappedFile: Could not read the size of " << filePath << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle_ = file;
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+    isOpen_ = true;
+    if (size_ == 0) {
+        return true; // Rien à projeter
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        std::cerr << "MappedFile: Could not map " << filePath << std::endl;
+        if (mapping) CloseHandle(mapping);
+        close();
+        return false;
+    }
+    mappingHandle_ = mapping;
+    data_ = static_cast<const unsigned char *>(view);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) UnmapViewOfFile(data_);
+    if (mappingHandle_) CloseHandle(static_cast<HANDLE>(mappingHandle_));
+    if (fileHandle_) CloseHandle(static_cast<HANDLE>(fileHandle_));
+    data_ = nullptr;
+    mappingHandle_ = nullptr;
+    fileHandle_ = nullptr;
+    size_ = 0;
+    isOpen_ = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string &filePath) {
+    close();
+
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "MappedFile: Could not open " << filePath << std::endl;
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+        std::cerr << "MappedFile: Could not read the size of " << filePath << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    size_ = static_cast<std::size_t>(fileStat.st_size);
+    if (size_ > 0) {
+        void *view = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            std::cerr << "MappedFile: Could not map " << filePath << std::endl;
+            ::close(fd);
+            size_ = 0;
+            return false;
+        }
+        data_ = static_cast<const unsigned char *>(view);
+    }
+    ::close(fd); // La projection reste valide après la fermeture du descripteur
+    isOpen_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) munmap(const_cast<unsigned char *>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    isOpen_ = false;
+}
+
+#endif
@@ -12,38 +12,62 @@ void PianoView::render(SDL_Renderer *renderer, int windowWidth, int windowHeight
         float y = piano->getY();
         float w = piano->getWidth();
         float h = piano->getHeight();
-        SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255); // Light grey placeholder
+        geometry.setColor(200, 200, 200, 255); // Light grey placeholder
         SDL_FRect pianoBackground = {x, y, w, h};
-        SDL_RenderFillRect(renderer, &pianoBackground);
-        SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-        SDL_RenderRect(renderer, &pianoBackground);
+        geometry.fillRect(pianoBackground);
+        geometry.setColor(100, 100, 100, 255);
+        geometry.rect(pianoBackground);
         // Optionally, render text like "Piano keys not loaded"
+        geometry.flush(renderer);
         return;
     }
 
-    // Render white keys first
+    renderCachedLayer(renderer, {piano->getX(), piano->getY(), piano->getWidth(), piano->getHeight()},
+                      piano->getLayoutVersion());
+
+    // Hover highlights drawn over the cached keys
     for (const auto &key: keys) {
+        if (!key.isHovered) continue;
+
         if (!key.isBlack) {
-            SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White
-            // Si la touche est survolée, utiliser une couleur de surbrillance
-            if (key.isHovered) {
-                SDL_SetRenderDrawColor(renderer, 210, 230, 255, 255); // Bleu clair pour le hover
+            geometry.setColor(210, 230, 255, 255); // Bleu clair pour le hover
+            geometry.fillRect(key.rect);
+            geometry.setColor(0, 0, 0, 255); // Black border
+            geometry.rect(key.rect);
+
+            // Black keys overlapping the highlighted white key stay on top
+            geometry.setColor(0, 0, 0, 255);
+            for (const auto &blackKey: keys) {
+                if (blackKey.isBlack && SDL_HasRectIntersectionFloat(&blackKey.rect, &key.rect)) {
+                    geometry.fillRect(blackKey.rect);
+                }
             }
-            SDL_RenderFillRect(renderer, &key.rect);
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255); // Black border
-            SDL_RenderRect(renderer, &key.rect);
+        } else {
+            geometry.setColor(40, 40, 80, 255); // Bleu foncé pour le hover
+            geometry.fillRect(key.rect);
+        }
+    }
+    geometry.flush(renderer);
+}
+
+void PianoView::renderStaticLayer(SDL_Renderer *) {
+    const auto &keys = piano->getPianoKeys();
+
+    // Render white keys first
+    for (const auto &key: keys) {
+        if (!key.isBlack) {
+            geometry.setColor(255, 255, 255, 255); // White
+            geometry.fillRect(key.rect);
+            geometry.setColor(0, 0, 0, 255); // Black border
+            geometry.rect(key.rect);
         }
     }
 
     // Render black keys on top
+    geometry.setColor(0, 0, 0, 255); // Black
     for (const auto &key: keys) {
         if (key.isBlack) {
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255); // Black
-            // Si la touche est survolée, utiliser une couleur de surbrillance
-            if (key.isHovered) {
-                SDL_SetRenderDrawColor(renderer, 40, 40, 80, 255); // Bleu foncé pour le hover
-            }
-            SDL_RenderFillRect(renderer, &key.rect);
+            geometry.fillRect(key.rect);
             // Optionally, add a slight highlight or border to black keys if desired
         }
     }
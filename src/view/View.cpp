@@ -3,5 +3,80 @@
 //
 
 #include "../../include/View/View.h"
+#include <iostream>
 
+View::~View() {
+    if (staticLayer) {
+        SDL_DestroyTexture(staticLayer);
+        staticLayer = nullptr;
+    }
+}
 
+void View::invalidateStaticLayer(bool texturesLost) {
+    staticLayerValid = false;
+    if (texturesLost && staticLayer) {
+        SDL_DestroyTexture(staticLayer);
+        staticLayer = nullptr;
+    }
+}
+
+void View::renderCachedLayer(SDL_Renderer *renderer, const SDL_FRect &bounds, Uint32 layoutVersion) {
+    if (!renderer) return;
+    if (renderTargetsUnsupported) {
+        renderStaticLayer(renderer);
+        geometry.flush(renderer);
+        return;
+    }
+
+    int outputWidth = 0, outputHeight = 0;
+    if (!SDL_GetCurrentRenderOutputSize(renderer, &outputWidth, &outputHeight) || outputWidth <= 0 ||
+        outputHeight <= 0) {
+        renderStaticLayer(renderer);
+        geometry.flush(renderer);
+        return;
+    }
+
+    // La texture couvre toute la sortie : la couche se dessine sans translation et se recopie pixel pour pixel
+    float textureWidth = 0, textureHeight = 0;
+    if (staticLayer) {
+        SDL_GetTextureSize(staticLayer, &textureWidth, &textureHeight);
+    }
+    if (!staticLayer || staticLayerRenderer != renderer || static_cast<int>(textureWidth) != outputWidth ||
+        static_cast<int>(textureHeight) != outputHeight) {
+        if (staticLayer) SDL_DestroyTexture(staticLayer);
+        staticLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, outputWidth,
+                                        outputHeight);
+        staticLayerRenderer = renderer;
+        staticLayerValid = false;
+        if (!staticLayer) {
+            std::cerr << "View Warning: Render target textures unavailable, drawing every frame: " << SDL_GetError()
+                      << std::endl;
+            renderTargetsUnsupported = true;
+            renderStaticLayer(renderer);
+            geometry.flush(renderer);
+            return;
+        }
+        SDL_SetTextureBlendMode(staticLayer, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(staticLayer, SDL_SCALEMODE_NEAREST);
+    }
+
+    if (!staticLayerValid || staticLayerVersion != layoutVersion || staticLayerBounds.x != bounds.x ||
+        staticLayerBounds.y != bounds.y || staticLayerBounds.w != bounds.w || staticLayerBounds.h != bounds.h) {
+        SDL_Texture *previousTarget = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, staticLayer);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        renderStaticLayer(renderer);
+        geometry.flush(renderer);
+        SDL_SetRenderTarget(renderer, previousTarget);
+
+        staticLayerBounds = bounds;
+        staticLayerVersion = layoutVersion;
+        staticLayerValid = true;
+    }
+
+    // Recopie de toute la sortie : les éléments débordant de la zone (maillets, halos de la console) restent
+    // visibles, le reste de la texture est transparent
+    const SDL_FRect outputRect = {0, 0, static_cast<float>(outputWidth), static_cast<float>(outputHeight)};
+    SDL_RenderTexture(renderer, staticLayer, &outputRect, &outputRect);
+}
@@ -5,11 +5,79 @@
 #include "../../include/View/XylophoneView.h"
 #include "../../include/Model/Xylophone.h"
 #include <SDL3/SDL.h>
+#include <algorithm>
+
+// Définir les couleurs pour les lames (notes)
+static const SDL_Color noteColors[] = {
+        {220, 20,  60,  255},   // Rouge (Do - C)
+        {255, 140, 0,   255},   // Orange (Ré - D)
+        {255, 215, 0,   255},   // Jaune (Mi - E)
+        {50,  205, 50,  255},   // Vert (Fa - F)
+        {135, 206, 235, 255}, // Bleu ciel (Sol - G)
+        {65,  105, 225, 255},  // Bleu royal (La - A)
+        {138, 43,  226, 255},  // Violet (Si - B)
+        {220, 20,  60,  255},   // Rouge (Do - C)
+        {255, 140, 0,   255},   // Orange (Ré - D)
+        {255, 215, 0,   255},   // Jaune (Mi - E)
+        {50,  205, 50,  255},   // Vert (Fa - F)
+        {135, 206, 235, 255}  // Bleu ciel (Sol - G)
+};
 
 XylophoneView::XylophoneView(Xylophone *xylophone) : xylophone(xylophone) {
 }
 
 void XylophoneView::render(SDL_Renderer *renderer, int windowWidth, int windowHeight) {
+    renderCachedLayer(renderer, {xylophone->getX(), xylophone->getY(), xylophone->getWidth(), xylophone->getHeight()},
+                      xylophone->getLayoutVersion());
+
+    // Lames survolées, par-dessus la couche en cache
+    const auto &bars = xylophone->getXylophoneBars();
+    const int barCount = static_cast<int>(bars.size());
+    for (int i = 0; i < barCount; i++) {
+        if (!bars[i].isHovered) continue;
+
+        // Effet de surbrillance plus prononcé pour que ce soit bien visible
+        SDL_Color barColor = noteColors[i % 12];
+        barColor.r = std::min(255, barColor.r + 80);
+        barColor.g = std::min(255, barColor.g + 80);
+        barColor.b = std::min(255, barColor.b + 80);
+
+        // Afficher en console pour le débogage
+        SDL_Log("Rendering hovered xylophone bar at index: %d", i);
+
+        drawBar(bars[i].rect, barColor);
+        // La lame suivante recouvre les cordons de celle-ci
+        if (i + 1 < barCount) {
+            drawBar(bars[i + 1].rect, noteColors[(i + 1) % 12]);
+        }
+    }
+    geometry.flush(renderer);
+}
+
+void XylophoneView::drawBar(const SDL_FRect &rect, SDL_Color color) {
+    // Dessiner la lame
+    geometry.setColor(color.r, color.g, color.b, color.a);
+    geometry.fillRect(rect);
+
+    // Bordure noire pour la lame
+    geometry.setColor(0, 0, 0, 255);
+    geometry.rect(rect);
+
+    // Dessiner les cordons qui soutiennent la lame
+    geometry.setColor(50, 50, 50, 255);
+    float leftStringX = rect.x + rect.w * 0.25f;
+    float rightStringX = rect.x + rect.w * 0.75f;
+
+    // Cordon gauche
+    SDL_FRect leftString = {leftStringX, rect.y + rect.h - 2, 2, 10};
+    geometry.fillRect(leftString);
+
+    // Cordon droit
+    SDL_FRect rightString = {rightStringX, rect.y + rect.h - 2, 2, 10};
+    geometry.fillRect(rightString);
+}
+
+void XylophoneView::renderStaticLayer(SDL_Renderer *) {
     float x = xylophone->getX();
     float y = xylophone->getY();
     float w = xylophone->getWidth();
@@ -31,7 +99,7 @@ void XylophoneView::render(SDL_Renderer *renderer, int windowWidth, int windowHe
     }
 
     // Dessiner le cadre/support du xylophone
-    SDL_SetRenderDrawColor(renderer, 139, 69, 19, 255); // Brun pour le support en bois
+    geometry.setColor(139, 69, 19, 255); // Brun pour le support en bois
 
     // Support gauche
     SDL_FRect leftSupport = {
@@ -40,7 +108,7 @@ void XylophoneView::render(SDL_Renderer *renderer, int windowWidth, int windowHe
             xylophoneWidth * 0.05f,
             xylophoneHeight * 0.8f
     };
-    SDL_RenderFillRect(renderer, &leftSupport);
+    geometry.fillRect(leftSupport);
 
     // Support droit
     SDL_FRect rightSupport = {
@@ -49,7 +117,7 @@ void XylophoneView::render(SDL_Renderer *renderer, int windowWidth, int windowHe
             xylophoneWidth * 0.05f,
             xylophoneHeight * 0.8f
     };
-    SDL_RenderFillRect(renderer, &rightSupport);
+    geometry.fillRect(rightSupport);
 
     // Dessiner la base
     SDL_FRect base = {
@@ -58,23 +126,7 @@ void XylophoneView::render(SDL_Renderer *renderer, int windowWidth, int windowHe
             xylophoneWidth,
             xylophoneHeight * 0.1f
     };
-    SDL_RenderFillRect(renderer, &base);
-
-    // Définir les couleurs pour les lames (notes)
-    SDL_Color noteColors[] = {
-            {220, 20,  60,  255},   // Rouge (Do - C)
-            {255, 140, 0,   255},   // Orange (Ré - D)
-            {255, 215, 0,   255},   // Jaune (Mi - E)
-            {50,  205, 50,  255},   // Vert (Fa - F)
-            {135, 206, 235, 255}, // Bleu ciel (Sol - G)
-            {65,  105, 225, 255},  // Bleu royal (La - A)
-            {138, 43,  226, 255},  // Violet (Si - B)
-            {220, 20,  60,  255},   // Rouge (Do - C)
-            {255, 140, 0,   255},   // Orange (Ré - D)
-            {255, 215, 0,   255},   // Jaune (Mi - E)
-            {50,  205, 50,  255},   // Vert (Fa - F)
-            {135, 206, 235, 255}  // Bleu ciel (Sol - G)
-    };
+    geometry.fillRect(base);
 
     float barHeight = xylophoneHeight * 0.1f;
 
@@ -92,67 +144,13 @@ void XylophoneView::render(SDL_Renderer *renderer, int windowWidth, int windowHe
             float barX = barAreaX + (barAreaWidth - barWidth) / 2;
             float barY = xylophoneY + xylophoneHeight * 0.15f + i * barSpacing;
 
-            // Dessiner la lame
-            SDL_SetRenderDrawColor(renderer, noteColors[i].r, noteColors[i].g, noteColors[i].b, noteColors[i].a);
             SDL_FRect bar = {barX, barY, barWidth, barHeight};
-            SDL_RenderFillRect(renderer, &bar);
-
-            // Bordure noire pour la lame
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-            SDL_RenderRect(renderer, &bar);
-
-            // Dessiner les cordons qui soutiennent la lame
-            SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-            float leftStringX = barX + barWidth * 0.25f;
-            float rightStringX = barX + barWidth * 0.75f;
-
-            // Cordon gauche
-            SDL_FRect leftString = {leftStringX, barY + barHeight - 2, 2, 10};
-            SDL_RenderFillRect(renderer, &leftString);
-
-            // Cordon droit
-            SDL_FRect rightString = {rightStringX, barY + barHeight - 2, 2, 10};
-            SDL_RenderFillRect(renderer, &rightString);
+            drawBar(bar, noteColors[i]);
         }
     } else {
-        // Dessiner les lames horizontales en utilisant les données du modèle
-        for (int i = 0; i < bars.size(); i++) {
-            const auto &bar = bars[i];
-
-            // Sélectionner la couleur de la lame
-            SDL_Color barColor = noteColors[i % 12]; // Utiliser les couleurs de note pour les lames
-
-            // Si la lame est survolée, éclaircir la couleur
-            if (bar.isHovered) {
-                // Effet de surbrillance plus prononcé pour que ce soit bien visible
-                barColor.r = std::min(255, barColor.r + 80);
-                barColor.g = std::min(255, barColor.g + 80);
-                barColor.b = std::min(255, barColor.b + 80);
-
-                // Afficher en console pour le débogage
-                SDL_Log("Rendering hovered xylophone bar at index: %d", i);
-            }
-
-            // Dessiner la lame
-            SDL_SetRenderDrawColor(renderer, barColor.r, barColor.g, barColor.b, barColor.a);
-            SDL_RenderFillRect(renderer, &bar.rect);
-
-            // Bordure noire pour la lame
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-            SDL_RenderRect(renderer, &bar.rect);
-
-            // Dessiner les cordons qui soutiennent la lame
-            SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-            float leftStringX = bar.rect.x + bar.rect.w * 0.25f;
-            float rightStringX = bar.rect.x + bar.rect.w * 0.75f;
-
-            // Cordon gauche
-            SDL_FRect leftString = {leftStringX, bar.rect.y + bar.rect.h - 2, 2, 10};
-            SDL_RenderFillRect(renderer, &leftString);
-
-            // Cordon droit
-            SDL_FRect rightString = {rightStringX, bar.rect.y + bar.rect.h - 2, 2, 10};
-            SDL_RenderFillRect(renderer, &rightString);
+        // Dessiner les lames horizontales au repos en utilisant les données du modèle (survol : voir render)
+        for (std::size_t i = 0; i < bars.size(); i++) {
+            drawBar(bars[i].rect, noteColors[i % 12]);
         }
     }
 
@@ -162,42 +160,42 @@ void XylophoneView::render(SDL_Renderer *renderer, int windowWidth, int windowHe
     float malletStickWidth = 3.0f;
 
     // Maillet gauche - maintenant positionnés sur les côtés plutôt qu'au-dessus
-    SDL_SetRenderDrawColor(renderer, 70, 40, 10, 255); // Couleur du bâton
+    geometry.setColor(70, 40, 10, 255); // Couleur du bâton
     SDL_FRect leftMalletStick = {
             xylophoneX - malletLength * 0.8f,
             xylophoneY + xylophoneHeight * 0.3f,
             malletLength,
             malletStickWidth
     };
-    SDL_RenderFillRect(renderer, &leftMalletStick);
+    geometry.fillRect(leftMalletStick);
 
     // Tête du maillet gauche
-    SDL_SetRenderDrawColor(renderer, 240, 230, 140, 255); // Couleur de la tête
+    geometry.setColor(240, 230, 140, 255); // Couleur de la tête
     SDL_FRect leftMalletHead = {
             leftMalletStick.x - malletHeadSize * 0.8f,
             leftMalletStick.y - (malletHeadSize - malletStickWidth) / 2,
             malletHeadSize,
             malletHeadSize
     };
-    SDL_RenderFillRect(renderer, &leftMalletHead);
+    geometry.fillRect(leftMalletHead);
 
     // Maillet droit - maintenant positionnés sur les côtés plutôt qu'au-dessus
-    SDL_SetRenderDrawColor(renderer, 70, 40, 10, 255);
+    geometry.setColor(70, 40, 10, 255);
     SDL_FRect rightMalletStick = {
             xylophoneX + xylophoneWidth,
             xylophoneY + xylophoneHeight * 0.6f,
             malletLength,
             malletStickWidth
     };
-    SDL_RenderFillRect(renderer, &rightMalletStick);
+    geometry.fillRect(rightMalletStick);
 
     // Tête du maillet droit
-    SDL_SetRenderDrawColor(renderer, 240, 230, 140, 255);
+    geometry.setColor(240, 230, 140, 255);
     SDL_FRect rightMalletHead = {
             rightMalletStick.x + malletLength,
             rightMalletStick.y - (malletHeadSize - malletStickWidth) / 2,
             malletHeadSize,
             malletHeadSize
     };
-    SDL_RenderFillRect(renderer, &rightMalletHead);
+    geometry.fillRect(rightMalletHead);
 }
\ No newline at end of file
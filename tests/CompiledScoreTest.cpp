@@ -0,0 +1,126 @@
+#include "../include/Audio/CompiledScore.h"
+#include "TestCheck.h"
+#include <filesystem>
+#include <fstream>
+
+using MusicApp::Audio::CompiledScore;
+using MusicApp::Audio::ScoreEventRecord;
+
+namespace {
+    // Fichiers de travail dans le dossier temporaire, jamais dans les sources
+    std::string temporaryPath(const char *name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    ScoreEventRecord record(Uint32 onsetFrame, Uint32 durationFrames, Uint8 midiNumber) {
+        ScoreEventRecord result;
+        result.onsetFrame = onsetFrame;
+        result.durationFrames = durationFrames;
+        result.midiNumber = midiNumber;
+        result.velocity = 100;
+        result.channel = 1;
+        result.reserved = 0;
+        return result;
+    }
+
+    void writeBytes(const std::string &path, const std::string &bytes) {
+        std::ofstream file(path, std::ios::binary);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    std::string readBytes(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+}
+
+// Écriture puis projection : en-tête et événements relus tels quels, triés par début
+static void testWriteAndOpen() {
+    const std::string path = temporaryPath("musicalau_compiled_score_test.mlsc");
+    CHECK(CompiledScore::write(path, {record(300, 10, 64), record(0, 100, 60), record(100, 50, 62)}, 44100));
+
+    CompiledScore score;
+    CHECK(score.open(path));
+    CHECK(score.isOpen());
+    CHECK_EQ(score.eventCount(), static_cast<std::size_t>(3));
+    CHECK_EQ(score.lengthFrames(), static_cast<Uint64>(44100));
+    if (score.eventCount() == 3) {
+        const ScoreEventRecord *events = score.events();
+        CHECK_EQ(events[0].onsetFrame, 0u);
+        CHECK_EQ(static_cast<int>(events[0].midiNumber), 60);
+        CHECK_EQ(events[1].onsetFrame, 100u);
+        CHECK_EQ(events[1].durationFrames, 50u);
+        CHECK_EQ(events[2].onsetFrame, 300u);
+        CHECK_EQ(static_cast<int>(events[2].velocity), 100);
+        CHECK_EQ(static_cast<int>(events[2].channel), 1);
+    }
+    score.close();
+    CHECK(!score.isOpen());
+    CHECK_EQ(score.eventCount(), static_cast<std::size_t>(0));
+    std::filesystem::remove(path);
+}
+
+// Fichiers refusés : absent, trop court, mauvaise signature, mauvaise version, événements tronqués
+static void testRejectsInvalidFiles() {
+    const std::string validPath = temporaryPath("musicalau_compiled_score_valid.mlsc");
+    const std::string path = temporaryPath("musicalau_compiled_score_invalid.mlsc");
+    CHECK(CompiledScore::write(validPath, {record(0, 10, 60), record(10, 10, 62)}, 20));
+    const std::string valid = readBytes(validPath);
+    CHECK_EQ(valid.size(), sizeof(CompiledScore::Header) + 2 * sizeof(ScoreEventRecord));
+
+    CompiledScore score;
+    CHECK(!score.open(temporaryPath("musicalau_compiled_score_missing.mlsc")));
+
+    writeBytes(path, valid.substr(0, sizeof(CompiledScore::Header) - 1));
+    CHECK(!score.open(path));
+
+    std::string badMagic = valid;
+    badMagic[0] = 'X';
+    writeBytes(path, badMagic);
+    CHECK(!score.open(path));
+
+    std::string badVersion = valid;
+    badVersion[4] = static_cast<char>(CompiledScore::VERSION + 1);
+    writeBytes(path, badVersion);
+    CHECK(!score.open(path));
+
+    writeBytes(path, valid.substr(0, valid.size() - 1)); // Dernier enregistrement incomplet
+    CHECK(!score.open(path));
+    CHECK(!score.isOpen());
+
+    writeBytes(path, valid);
+    CHECK(score.open(path));
+    CHECK_EQ(score.eventCount(), static_cast<std::size_t>(2));
+    score.close();
+
+    std::filesystem::remove(validPath);
+    std::filesystem::remove(path);
+}
+
+// Conversion d'une partition texte : même placement que l'analyseur texte, silences compris
+static void testConvertTextScore() {
+    const std::string textPath = temporaryPath("musicalau_compiled_score_test.txt");
+    const std::string path = temporaryPath("musicalau_compiled_score_converted.mlsc");
+    writeBytes(textPath, "C4 0.5\n0 0.5\nE4 1\n");
+    CHECK(CompiledScore::convertTextScore(textPath, path));
+
+    CompiledScore score;
+    CHECK(score.open(path));
+    CHECK_EQ(score.eventCount(), static_cast<std::size_t>(2));
+    CHECK_EQ(score.lengthFrames(), static_cast<Uint64>(88200));
+    if (score.eventCount() == 2) {
+        CHECK_EQ(static_cast<int>(score.events()[1].midiNumber), 64);
+        CHECK_EQ(score.events()[1].onsetFrame, 44100u);
+        CHECK_EQ(score.events()[1].durationFrames, 44100u);
+    }
+    score.close();
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(path);
+}
+
+int main() {
+    testWriteAndOpen();
+    testRejectsInvalidFiles();
+    testConvertTextScore();
+    return TEST_RESULT();
+}
@@ -0,0 +1,85 @@
+#include "../include/Audio/EventScheduler.h"
+#include "TestCheck.h"
+
+using MusicApp::Audio::AudioCommand;
+using MusicApp::Audio::EventScheduler;
+
+namespace {
+    AudioCommand command(AudioCommand::Type type, Uint8 pitchId, Uint64 frame, MusicApp::Audio::SessionId sessionId = 0) {
+        AudioCommand result;
+        result.type = type;
+        result.pitchId = pitchId;
+        result.frame = frame;
+        result.sessionId = sessionId;
+        return result;
+    }
+}
+
+// Les commandes sortent par trame croissante, quel que soit l'ordre d'ajout, et seulement une fois dues
+static void testFrameOrder() {
+    EventScheduler scheduler;
+    CHECK_EQ(scheduler.nextFrame(), EventScheduler::NO_EVENT);
+    for (Uint64 frame: {500u, 100u, 300u, 200u, 400u}) {
+        CHECK(scheduler.push(command(AudioCommand::Type::NoteOn, 60, frame)));
+    }
+    CHECK_EQ(scheduler.nextFrame(), static_cast<Uint64>(100));
+
+    AudioCommand popped;
+    CHECK(!scheduler.popDue(99, popped));
+    Uint64 previous = 0;
+    int count = 0;
+    while (scheduler.popDue(1000, popped)) {
+        CHECK(popped.frame >= previous);
+        previous = popped.frame;
+        ++count;
+    }
+    CHECK_EQ(count, 5);
+    CHECK(scheduler.empty());
+}
+
+// Même trame : l'ordre d'arrivée est conservé (note-off puis note-on de la même touche)
+static void testSameFrameKeepsArrivalOrder() {
+    EventScheduler scheduler;
+    CHECK(scheduler.push(command(AudioCommand::Type::NoteOn, 64, 2000)));
+    for (Uint8 pitch = 0; pitch < 40; ++pitch) {
+        const AudioCommand::Type type = pitch % 2 == 0 ? AudioCommand::Type::NoteOff : AudioCommand::Type::NoteOn;
+        CHECK(scheduler.push(command(type, pitch, 1000)));
+    }
+
+    AudioCommand popped;
+    for (Uint8 pitch = 0; pitch < 40; ++pitch) {
+        CHECK(scheduler.popDue(1000, popped));
+        CHECK_EQ(popped.frame, static_cast<Uint64>(1000));
+        CHECK_EQ(static_cast<int>(popped.pitchId), static_cast<int>(pitch));
+        CHECK(popped.type == (pitch % 2 == 0 ? AudioCommand::Type::NoteOff : AudioCommand::Type::NoteOn));
+    }
+    CHECK(!scheduler.popDue(1999, popped));
+    CHECK(scheduler.popDue(2000, popped));
+    CHECK_EQ(static_cast<int>(popped.pitchId), 64);
+}
+
+// Capacité fixe, et le retrait d'une session garde l'ordre des autres
+static void testCapacityAndClearSession() {
+    EventScheduler scheduler(4);
+    CHECK(scheduler.push(command(AudioCommand::Type::NoteOn, 1, 10, 1)));
+    CHECK(scheduler.push(command(AudioCommand::Type::NoteOn, 2, 10, 2)));
+    CHECK(scheduler.push(command(AudioCommand::Type::NoteOff, 3, 10, 1)));
+    CHECK(scheduler.push(command(AudioCommand::Type::NoteOff, 4, 10, 2)));
+    CHECK(!scheduler.push(command(AudioCommand::Type::NoteOn, 5, 5, 1)));
+
+    scheduler.clearSession(1);
+    CHECK_EQ(scheduler.size(), static_cast<std::size_t>(2));
+    AudioCommand popped;
+    CHECK(scheduler.popDue(10, popped));
+    CHECK_EQ(static_cast<int>(popped.pitchId), 2);
+    CHECK(scheduler.popDue(10, popped));
+    CHECK_EQ(static_cast<int>(popped.pitchId), 4);
+    CHECK(scheduler.empty());
+}
+
+int main() {
+    testFrameOrder();
+    testSameFrameKeepsArrivalOrder();
+    testCapacityAndClearSession();
+    return TEST_RESULT();
+}
@@ -0,0 +1,139 @@
+#include "../include/Audio/MidiFileReader.h"
+#include "TestCheck.h"
+
+using MusicApp::Audio::MidiFileReader;
+
+namespace {
+    using Bytes = std::vector<unsigned char>;
+
+    const Uint32 FRAMES_PER_QUARTER = 22050; // 120 BPM à 44,1 kHz
+
+    // En-tête MThd : format, nombre de pistes, 480 ticks par noire
+    Bytes header(Uint16 format, Uint16 trackCount) {
+        return {'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, static_cast<unsigned char>(format), 0,
+                static_cast<unsigned char>(trackCount), 0x01, 0xE0};
+    }
+
+    // Morceau MTrk autour des événements ; declaredLength remplace la longueur réelle si non nul
+    void appendTrack(Bytes &file, const Bytes &events, Uint32 declaredLength = 0) {
+        const Uint32 length = declaredLength ? declaredLength : static_cast<Uint32>(events.size());
+        const Bytes chunk = {'M', 'T', 'r', 'k', static_cast<unsigned char>(length >> 24),
+                             static_cast<unsigned char>(length >> 16), static_cast<unsigned char>(length >> 8),
+                             static_cast<unsigned char>(length)};
+        file.insert(file.end(), chunk.begin(), chunk.end());
+        file.insert(file.end(), events.begin(), events.end());
+    }
+
+    bool parse(const Bytes &file, MidiFileReader::Result &result) {
+        return MidiFileReader::parse(file.data(), file.size(), "test.mid", result);
+    }
+}
+
+// Statut courant : les note-on et les note-off (vélocité nulle) sans octet de statut répété
+static void testRunningStatus() {
+    Bytes file = header(0, 1);
+    appendTrack(file, {
+            0x00, 0x90, 0x3C, 0x64,       // C4 on
+            0x00, 0x40, 0x50,             // E4 on, statut courant
+            0x83, 0x60, 0x3C, 0x00,       // 480 ticks plus tard : C4 off (note-on de vélocité nulle)
+            0x00, 0x40, 0x00,             // E4 off
+            0x00, 0x99, 0x24, 0x64,       // Percussion (canal 10) : ignorée
+            0x00, 0xFF, 0x2F, 0x00});
+
+    MidiFileReader::Result result;
+    CHECK(parse(file, result));
+    CHECK_EQ(result.events.size(), static_cast<std::size_t>(2));
+    if (result.events.size() == 2) {
+        CHECK_EQ(static_cast<int>(result.events[0].midiNumber), 60);
+        CHECK_EQ(static_cast<int>(result.events[1].midiNumber), 64);
+        CHECK_EQ(static_cast<int>(result.events[1].velocity), 0x50);
+        for (const auto &event: result.events) {
+            CHECK_EQ(event.onsetFrame, 0u);
+            CHECK_EQ(event.durationFrames, FRAMES_PER_QUARTER);
+        }
+    }
+    CHECK_EQ(result.skippedPercussionNotes, static_cast<std::size_t>(1));
+    CHECK_EQ(result.lengthFrames, static_cast<Uint64>(FRAMES_PER_QUARTER));
+}
+
+// Format 1 : la carte des tempos de la première piste s'applique aux notes des autres pistes
+static void testTempoMapAcrossTracks() {
+    Bytes file = header(1, 2);
+    appendTrack(file, {0x83, 0x60, 0xFF, 0x51, 0x03, 0x03, 0xD0, 0x90, // Noire à 250 000 µs dès le tick 480
+                       0x00, 0xFF, 0x2F, 0x00});
+    appendTrack(file, {0x83, 0x60, 0x91, 0x45, 0x64,  // A4 on au tick 480, canal 2
+                       0x83, 0x60, 0x81, 0x45, 0x40,  // A4 off au tick 960
+                       0x00, 0xFF, 0x2F, 0x00});
+
+    MidiFileReader::Result result;
+    CHECK(parse(file, result));
+    CHECK_EQ(result.trackCount, static_cast<Uint16>(2));
+    CHECK_EQ(result.tempoChangeCount, static_cast<std::size_t>(1));
+    CHECK_EQ(result.events.size(), static_cast<std::size_t>(1));
+    if (result.events.size() == 1) {
+        CHECK_EQ(result.events[0].onsetFrame, FRAMES_PER_QUARTER);
+        CHECK_EQ(result.events[0].durationFrames, FRAMES_PER_QUARTER / 2);
+        CHECK_EQ(static_cast<int>(result.events[0].channel), 1);
+    }
+}
+
+// Fichiers tronqués ou mal formés : refusés sans lecture hors du tampon
+static void testTruncatedFiles() {
+    const Bytes track = {0x00, 0x90, 0x3C, 0x64, 0x83, 0x60, 0x80, 0x3C, 0x40, 0x00, 0xFF, 0x2F, 0x00};
+    MidiFileReader::Result result;
+
+    Bytes complete = header(0, 1);
+    appendTrack(complete, track);
+    CHECK(parse(complete, result));
+
+    // Coupé à chaque octet : jamais accepté, jamais de lecture au-delà de la taille donnée
+    for (std::size_t size = 0; size < complete.size(); ++size) {
+        const Bytes truncated(complete.begin(), complete.begin() + static_cast<std::ptrdiff_t>(size));
+        CHECK(!parse(truncated, result));
+    }
+
+    // Longueur de piste plus grande que le fichier
+    Bytes overlong = header(0, 1);
+    appendTrack(overlong, track, static_cast<Uint32>(track.size() + 10));
+    CHECK(!parse(overlong, result));
+
+    // Événement coupé au milieu, dans une piste dont la longueur est cohérente
+    Bytes cutEvent = header(0, 1);
+    appendTrack(cutEvent, {0x00, 0x90, 0x3C});
+    CHECK(!parse(cutEvent, result));
+
+    // Statut courant sans statut précédent
+    Bytes noStatus = header(0, 1);
+    appendTrack(noStatus, {0x00, 0x3C, 0x64, 0x00, 0xFF, 0x2F, 0x00});
+    CHECK(!parse(noStatus, result));
+
+    // Format 2 : non pris en charge
+    Bytes format2 = header(2, 1);
+    appendTrack(format2, track);
+    CHECK(!parse(format2, result));
+}
+
+// Deux note-on de la même touche : le premier note-off ferme le plus ancien
+static void testOverlappingSameKey() {
+    Bytes file = header(0, 1);
+    appendTrack(file, {0x00, 0x90, 0x3C, 0x64,
+                       0x83, 0x60, 0x3C, 0x50,    // Deuxième C4 au tick 480
+                       0x83, 0x60, 0x80, 0x3C, 0x00,  // Tick 960 : ferme le premier
+                       0x83, 0x60, 0x3C, 0x00});  // Tick 1440 : ferme le second
+    MidiFileReader::Result result;
+    CHECK(parse(file, result));
+    CHECK_EQ(result.events.size(), static_cast<std::size_t>(2));
+    if (result.events.size() == 2) {
+        CHECK_EQ(result.events[0].durationFrames, FRAMES_PER_QUARTER * 2);
+        CHECK_EQ(result.events[1].onsetFrame, FRAMES_PER_QUARTER);
+        CHECK_EQ(result.events[1].durationFrames, FRAMES_PER_QUARTER * 2);
+    }
+}
+
+int main() {
+    testRunningStatus();
+    testTempoMapAcrossTracks();
+    testTruncatedFiles();
+    testOverlappingSameKey();
+    return TEST_RESULT();
+}
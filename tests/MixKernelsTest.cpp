@@ -0,0 +1,72 @@
+#include "../include/Audio/MixKernels.h"
+#include "../include/Audio/Wavetable.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using MusicApp::Audio::Wavetable;
+namespace MixKernels = MusicApp::Audio::MixKernels;
+namespace Wavetables = MusicApp::Audio::Wavetables;
+
+namespace {
+    const MixKernels::InstructionSet VECTOR_SETS[] = {MixKernels::InstructionSet::SSE2,
+                                                      MixKernels::InstructionSet::AVX2};
+
+    struct Rendered {
+        std::vector<float> samples;
+        MixKernels::WavetableBlock block;
+    };
+
+    // Rend frames échantillons avec la version demandée, par-dessus un fond non nul si accumulate
+    Rendered render(MixKernels::InstructionSet instructionSet, const Wavetable &table, int layers, int frames,
+                    bool accumulate) {
+        static const float weights[4] = {1.0f, 0.6f, 0.3f, 0.15f};
+        Rendered result;
+        result.samples.assign(static_cast<std::size_t>(frames), 0.0f);
+        for (int i = 0; i < frames; ++i) {
+            if (accumulate) result.samples[static_cast<std::size_t>(i)] = 0.01f * static_cast<float>(i % 7);
+        }
+        // Phase de départ proche du débordement : le bouclage de l'accumulateur est couvert
+        result.block = {table.mipFor(261.63f), layers, weights, 0xFFFF0000u,
+                        Wavetable::phaseIncrement(261.63f, 44100.0f), 0.8f, 0.9995f};
+        MixKernels::forceInstructionSet(instructionSet);
+        MixKernels::renderWavetable(result.block, result.samples.data(), frames, accumulate);
+        return result;
+    }
+
+    void compareWithScalar(const Wavetable &table, int layers) {
+        // Longueurs avec et sans reste après les paquets de 4 et 8 échantillons
+        for (int frames: {1, 3, 8, 13, 256, 517}) {
+            for (bool accumulate: {false, true}) {
+                const Rendered scalar = render(MixKernels::InstructionSet::Scalar, table, layers, frames, accumulate);
+                for (MixKernels::InstructionSet instructionSet: VECTOR_SETS) {
+                    const Rendered vector = render(instructionSet, table, layers, frames, accumulate);
+                    double maximum = 0.0;
+                    for (std::size_t i = 0; i < scalar.samples.size(); ++i) {
+                        maximum = std::max(maximum, static_cast<double>(std::fabs(scalar.samples[i] -
+                                                                                  vector.samples[i])));
+                    }
+                    CHECK(maximum < 1e-5);
+                    CHECK_EQ(vector.block.phase, scalar.block.phase);
+                    CHECK(std::fabs(vector.block.level - scalar.block.level) < 1e-5f);
+                }
+            }
+        }
+    }
+}
+
+// Les versions SSE2 et AVX2 donnent le même signal que la version scalaire, phase et niveau compris
+// (sur un processeur sans ces extensions, forceInstructionSet retombe sur le scalaire)
+static void testVectorKernelsMatchScalar() {
+    compareWithScalar(Wavetables::sine(), 1);
+    compareWithScalar(Wavetables::square(), 1);
+    compareWithScalar(Wavetables::xylophone(), 3);
+    compareWithScalar(Wavetables::piano(), 4);
+}
+
+int main() {
+    MixKernels::prepare();
+    testVectorKernelsMatchScalar();
+    return TEST_RESULT();
+}
@@ -0,0 +1,71 @@
+#include "../include/Core/Note.h"
+#include "TestCheck.h"
+#include <set>
+
+using MusicApp::Core::Note;
+
+// Dièses et bémols : les deux orthographes donnent le même numéro MIDI, et format() les redonne
+static void testSharpAndFlatNames() {
+    CHECK_EQ(Note::parse("C4"), 60);
+    CHECK_EQ(Note::parse("C#4"), 61);
+    CHECK_EQ(Note::parse("Db4"), 61);
+    CHECK_EQ(Note::parse("A4"), 69);
+    CHECK_EQ(Note::parse("B3"), 59);
+    CHECK_EQ(Note::parse("Cb4"), 59);  // Le bémol descend sous le do de la même octave
+    CHECK_EQ(Note::parse("B#3"), 60);
+    CHECK_EQ(Note::parse("C0"), 12);
+    CHECK_EQ(Note::parse("G9"), 127);
+
+    CHECK_EQ(Note::format(61), std::string("C#4"));
+    CHECK_EQ(Note::format(61, true), std::string("Db4"));
+    CHECK_EQ(Note(std::string("Db4")).midiNumber, 61);
+    CHECK_EQ(Note(61).pitchName, std::string("C#4"));
+}
+
+// Tout numéro nommable revient identique après format() puis parse(), en dièses comme en bémols
+static void testRoundTrip() {
+    for (int midiNumber = 12; midiNumber < Note::COUNT; ++midiNumber) {
+        CHECK_EQ(Note::parse(Note::format(midiNumber)), midiNumber);
+        CHECK_EQ(Note::parse(Note::format(midiNumber, true)), midiNumber);
+    }
+    // Octave -1 : pas de nom, et rien hors de 0..127
+    CHECK(Note::format(11).empty());
+    CHECK(Note::format(-1).empty());
+    CHECK(Note::format(Note::COUNT).empty());
+    CHECK(!Note(Note::COUNT).isValid());
+}
+
+// Boutons de la console 8-bit : 24 boutons, deux octaves chromatiques à partir de C4, sans doublon
+static void testEightBitButtons() {
+    CHECK_EQ(Note::parse("8bit_0"), 60);  // C4
+    CHECK_EQ(Note::parse("8bit_6"), 71);  // B4, dernière touche blanche
+    CHECK_EQ(Note::parse("8bit_7"), 61);  // C#4, première touche noire
+    CHECK_EQ(Note::parse("8bit_12"), 72); // C5
+    CHECK_EQ(Note::parse("8bit_23"), 82); // A#5
+
+    std::set<int> notes;
+    for (int button = 0; button < 24; ++button) {
+        const int midiNumber = Note::parse("8bit_" + std::to_string(button));
+        CHECK(midiNumber >= 60 && midiNumber < 84);
+        notes.insert(midiNumber);
+        // Le nom usuel du son joué par le bouton redonne le même numéro
+        CHECK_EQ(Note::parse(Note::format(midiNumber)), midiNumber);
+    }
+    CHECK_EQ(notes.size(), static_cast<std::size_t>(24));
+}
+
+// Noms mal formés ou hors limites : INVALID, jamais d'exception
+static void testMalformedNames() {
+    for (const char *name: {"", "C", "H4", "c4", "C#", "C10", "C-1", "C4x", "8bit_", "8bit_24", "8bit_x", "G#9"}) {
+        CHECK_EQ(Note::parse(name), Note::INVALID);
+    }
+    CHECK(!Note(std::string("X9")).isValid());
+}
+
+int main() {
+    testSharpAndFlatNames();
+    testRoundTrip();
+    testEightBitButtons();
+    testMalformedNames();
+    return TEST_RESULT();
+}
@@ -0,0 +1,69 @@
+#include "../include/Audio/OfflineRenderer.h"
+#include "TestCheck.h"
+#include <cmath>
+
+using Model::Score;
+using MusicApp::Audio::InstrumentId;
+using MusicApp::Audio::OfflineRenderer;
+using MusicApp::Audio::Synthesizer;
+
+namespace {
+    const Uint32 SAMPLE_RATE = Synthesizer::SAMPLE_RATE;
+    const float TAIL_SECONDS = 1.0f;
+
+    // Note longue de 2 s, et si doubled la même hauteur sur une autre piste de 0,25 s à 0,5 s
+    // (mélodie doublée sur deux canaux MIDI)
+    std::vector<int16_t> render(InstrumentId instrument, bool doubled) {
+        Score score;
+        score.addEvent(0, SAMPLE_RATE * 2, 60, 100, score.addTrack("Long", instrument));
+        if (doubled) {
+            score.addEvent(SAMPLE_RATE / 4, SAMPLE_RATE / 4, 60, 100, score.addTrack("Short", instrument));
+        }
+        score.sortByOnset();
+
+        OfflineRenderer renderer;
+        renderer.setTailSeconds(TAIL_SECONDS);
+        renderer.setDitherEnabled(false);
+        return renderer.render(score);
+    }
+
+    // Valeur efficace du canal gauche entre deux instants
+    double rms(const std::vector<int16_t> &samples, double fromSeconds, double toSeconds) {
+        const std::size_t first = static_cast<std::size_t>(fromSeconds * SAMPLE_RATE);
+        const std::size_t last = std::min(static_cast<std::size_t>(toSeconds * SAMPLE_RATE),
+                                          samples.size() / OfflineRenderer::CHANNELS);
+        double sum = 0.0;
+        for (std::size_t frame = first; frame < last; ++frame) {
+            const double sample = samples[frame * OfflineRenderer::CHANNELS];
+            sum += sample * sample;
+        }
+        return last > first ? std::sqrt(sum / static_cast<double>(last - first)) : 0.0;
+    }
+
+    void checkLongNoteOutlivesShortOne(InstrumentId instrument) {
+        const std::vector<int16_t> single = render(instrument, false);
+        const std::vector<int16_t> doubled = render(instrument, true);
+
+        // Bien après la fin de la note courte et de son relâchement, la note longue sonne toujours
+        const double reference = rms(single, 1.0, 1.8);
+        const double measured = rms(doubled, 1.0, 1.8);
+        CHECK(reference > 100.0);
+        CHECK(measured > reference * 0.5);
+
+        // Et elle s'arrête avec son propre note-off : le rendu finit avant la fin de la traîne
+        const std::size_t maximumFrames = static_cast<std::size_t>((2.0f + TAIL_SECONDS) * SAMPLE_RATE);
+        CHECK(doubled.size() / OfflineRenderer::CHANNELS < maximumFrames);
+        CHECK(rms(doubled, 2.5, 3.0) < 1.0);
+    }
+}
+
+// Deux notes superposées de même hauteur : le note-off de la plus courte ne coupe pas la plus longue
+static void testOverlappingSamePitch() {
+    checkLongNoteOutlivesShortOne(InstrumentId::Piano);
+    checkLongNoteOutlivesShortOne(InstrumentId::Chiptune8Bit);
+}
+
+int main() {
+    testOverlappingSamePitch();
+    return TEST_RESULT();
+}
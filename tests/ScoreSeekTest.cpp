@@ -0,0 +1,95 @@
+#include "../include/Model/Score.h"
+#include "TestCheck.h"
+
+using Model::Score;
+using MusicApp::Audio::InstrumentId;
+
+namespace {
+    // 0 : [0, 100)  1 : [100, 200)  2 : [100, 500), note longue  3 : [300, 350)  4 : [600, 700)
+    Score boundaryScore() {
+        Score score;
+        const std::size_t track = score.addTrack("Test", InstrumentId::Piano);
+        score.addEvent(0, 100, 60, 100, track);
+        score.addEvent(100, 100, 62, 100, track);
+        score.addEvent(100, 400, 64, 100, track);
+        score.addEvent(300, 50, 65, 100, track);
+        score.addEvent(600, 100, 67, 100, track);
+        return score;
+    }
+
+    void checkSeek(const Score &score, Uint64 frame, std::size_t firstActive, std::size_t next) {
+        const Score::SeekPosition position = score.seek(frame);
+        if (position.firstActive != firstActive || position.next != next) {
+            std::cerr << "seek(" << frame << ") = {" << position.firstActive << ", " << position.next
+                      << "}, expected {" << firstActive << ", " << next << "}" << std::endl;
+        }
+        CHECK_EQ(position.firstActive, firstActive);
+        CHECK_EQ(position.next, next);
+    }
+
+    // Définition de seek() vérifiée par énumération : rien de ce qui sonne encore n'est avant firstActive,
+    // rien de ce qui a commencé n'est à partir de next
+    void checkAgainstDefinition(const Score &score, Uint64 frame) {
+        const Score::SeekPosition position = score.seek(frame);
+        CHECK(position.firstActive <= position.next);
+        for (std::size_t i = 0; i < score.size(); ++i) {
+            if (i < position.firstActive) CHECK(score.endFrame(i) <= frame);
+            if (i < position.next) CHECK(score.onsetFrame(i) < frame);
+            else CHECK(score.onsetFrame(i) >= frame);
+            if (score.onsetFrame(i) < frame && score.endFrame(i) > frame) CHECK(i >= position.firstActive);
+        }
+    }
+}
+
+// Exactement sur une limite : une note qui finit à frame est terminée, une note qui commence à frame est à venir
+static void testSeekOnBoundaries() {
+    const Score score = boundaryScore();
+    checkSeek(score, 0, 0, 0);
+    checkSeek(score, 100, 1, 1);   // Fin de 0, début de 1 et 2
+    checkSeek(score, 200, 2, 3);   // Fin de 1, 2 sonne encore
+    checkSeek(score, 300, 2, 3);   // Début de 3
+    checkSeek(score, 350, 2, 4);   // Fin de 3, mais 2 la précède et sonne encore
+    checkSeek(score, 500, 4, 4);   // Fin de la note longue
+    checkSeek(score, 600, 4, 4);
+    checkSeek(score, 700, 5, 5);   // Fin du morceau
+}
+
+// Entre deux limites
+static void testSeekBetweenBoundaries() {
+    const Score score = boundaryScore();
+    checkSeek(score, 50, 0, 1);
+    checkSeek(score, 150, 1, 3);
+    checkSeek(score, 320, 2, 4);
+    checkSeek(score, 550, 4, 4);   // Silence entre deux notes
+    checkSeek(score, 650, 4, 5);
+    checkSeek(score, 10000, 5, 5); // Au-delà de la fin
+}
+
+// Toutes les positions, y compris après un tri d'événements ajoutés dans le désordre
+static void testSeekEveryFrameAfterSort() {
+    Score score;
+    const std::size_t track = score.addTrack("Test", InstrumentId::Piano);
+    score.addEvent(600, 100, 67, 100, track);
+    score.addEvent(100, 400, 64, 100, track);
+    score.addEvent(0, 100, 60, 100, track);
+    score.addEvent(300, 50, 65, 100, track);
+    score.addEvent(100, 100, 62, 100, track);
+    score.addEvent(100, 0, 61, 100, track); // Durée nulle
+    CHECK(!score.isSorted());
+    score.sortByOnset();
+    CHECK(score.isSorted());
+    CHECK_EQ(score.lengthFrames(), static_cast<Uint64>(700));
+
+    for (Uint64 frame = 0; frame <= 800; ++frame) {
+        checkAgainstDefinition(score, frame);
+    }
+    checkAgainstDefinition(boundaryScore(), 0);
+    checkSeek(Score(), 0, 0, 0);
+}
+
+int main() {
+    testSeekOnBoundaries();
+    testSeekBetweenBoundaries();
+    testSeekEveryFrameAfterSort();
+    return TEST_RESULT();
+}
@@ -0,0 +1,104 @@
+#include "../include/Audio/ScoreTextParser.h"
+#include "TestCheck.h"
+#include <cstring>
+
+using MusicApp::Audio::ScoreEventRecord;
+using MusicApp::Audio::ScoreTextParser;
+
+namespace {
+    const Uint64 SAMPLE_RATE = 44100;
+
+    ScoreTextParser::Result parse(const char *text) {
+        return ScoreTextParser::parseBuffer(text, std::strlen(text));
+    }
+}
+
+// Notes, silences et lignes vides : les notes se suivent sur l'axe des trames, les silences font avancer le temps
+static void testNotesAndRests() {
+    const ScoreTextParser::Result result = parse("C4 0.5\n\n0 0.25\r\nC#4 1\nUnknown 0.25\nDb5 0.5");
+    CHECK(result.ok());
+    CHECK_EQ(result.lineCount, static_cast<std::size_t>(6));
+    CHECK_EQ(result.events.size(), static_cast<std::size_t>(3));
+    if (result.events.size() == 3) {
+        CHECK_EQ(static_cast<int>(result.events[0].midiNumber), 60);
+        CHECK_EQ(result.events[0].onsetFrame, 0u);
+        CHECK_EQ(result.events[0].durationFrames, static_cast<Uint32>(SAMPLE_RATE / 2));
+        CHECK_EQ(static_cast<int>(result.events[1].midiNumber), 61);
+        CHECK_EQ(result.events[1].onsetFrame, static_cast<Uint32>(SAMPLE_RATE * 3 / 4));
+        CHECK_EQ(static_cast<int>(result.events[2].midiNumber), 73);
+        CHECK_EQ(result.events[2].onsetFrame, static_cast<Uint32>(SAMPLE_RATE * 2));
+    }
+    CHECK_EQ(result.lengthFrames, SAMPLE_RATE * 5 / 2);
+}
+
+// Lignes fautives : chaque erreur porte sa ligne et sa colonne (à partir de 1), l'analyse continue
+static void testMalformedLinesReportPosition() {
+    const ScoreTextParser::Result result = parse("C4 0.5\n"
+                                                 "  D4\n"          // Durée manquante
+                                                 "E4 abc\n"        // Durée invalide
+                                                 "F4 -1\n"         // Durée négative
+                                                 "\tH4 0.5\n"      // Note inconnue : le temps avance quand même
+                                                 "G4 0.5\n");
+    CHECK(result.opened);
+    CHECK(!result.ok());
+    CHECK_EQ(result.errorCount, static_cast<std::size_t>(4));
+    CHECK_EQ(result.errors.size(), static_cast<std::size_t>(4));
+    if (result.errors.size() == 4) {
+        CHECK_EQ(result.errors[0].line, static_cast<std::size_t>(2));
+        CHECK_EQ(result.errors[0].column, static_cast<std::size_t>(3));
+        CHECK_EQ(result.errors[1].line, static_cast<std::size_t>(3));
+        CHECK_EQ(result.errors[1].column, static_cast<std::size_t>(4));
+        CHECK_EQ(result.errors[2].line, static_cast<std::size_t>(4));
+        CHECK_EQ(result.errors[2].column, static_cast<std::size_t>(4));
+        CHECK_EQ(result.errors[3].line, static_cast<std::size_t>(5));
+        CHECK_EQ(result.errors[3].column, static_cast<std::size_t>(2));
+    }
+    CHECK_EQ(result.events.size(), static_cast<std::size_t>(2));
+    if (result.events.size() == 2) {
+        CHECK_EQ(static_cast<int>(result.events[1].midiNumber), 67);
+        CHECK_EQ(result.events[1].onsetFrame, static_cast<Uint32>(SAMPLE_RATE));
+    }
+}
+
+// Le texte après la durée est ignoré, comme dans l'ancien parseMusicFile, et la ligne fait avancer le temps
+static void testTrailingTextIsIgnored() {
+    const ScoreTextParser::Result result = parse("C4 0.5   \n"
+                                                 "D4 0.5 # refrain\n"
+                                                 "0 0.5 pause\n"
+                                                 "E4 0.5\t2\n");
+    CHECK(result.ok());
+    CHECK_EQ(result.events.size(), static_cast<std::size_t>(3));
+    if (result.events.size() == 3) {
+        CHECK_EQ(result.events[1].onsetFrame, static_cast<Uint32>(SAMPLE_RATE / 2));
+        CHECK_EQ(static_cast<int>(result.events[2].midiNumber), 64);
+        CHECK_EQ(result.events[2].onsetFrame, static_cast<Uint32>(SAMPLE_RATE * 3 / 2));
+    }
+    CHECK_EQ(result.lengthFrames, SAMPLE_RATE * 2);
+}
+
+// Analyse par tranches : mêmes événements qu'en une seule passe
+static void testChunkedParsingMatchesWholeBuffer() {
+    const char *text = "C4 0.1\nD4 0.2\n0 0.3\nE4 0.1\nF4 0.2\nG4 0.3\nA4 0.1\n";
+    const ScoreTextParser::Result whole = parse(text);
+
+    ScoreTextParser parser(text, std::strlen(text));
+    std::vector<ScoreEventRecord> events;
+    while (!parser.done()) {
+        CHECK(parser.parseChunk(events, 2) <= 2);
+    }
+    CHECK_EQ(events.size(), whole.events.size());
+    for (std::size_t i = 0; i < events.size() && i < whole.events.size(); ++i) {
+        CHECK_EQ(events[i].onsetFrame, whole.events[i].onsetFrame);
+        CHECK_EQ(events[i].durationFrames, whole.events[i].durationFrames);
+        CHECK_EQ(events[i].midiNumber, whole.events[i].midiNumber);
+    }
+    CHECK_EQ(parser.lengthFrames(), whole.lengthFrames);
+}
+
+int main() {
+    testNotesAndRests();
+    testMalformedLinesReportPosition();
+    testTrailingTextIsIgnored();
+    testChunkedParsingMatchesWholeBuffer();
+    return TEST_RESULT();
+}
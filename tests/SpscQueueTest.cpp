@@ -0,0 +1,93 @@
+#include "../include/Audio/SpscQueue.h"
+#include "TestCheck.h"
+#include <thread>
+
+using MusicApp::Audio::SpscQueue;
+
+// File pleine puis vide : les bornes exactes de la capacité
+static void testFullAndEmpty() {
+    SpscQueue<int, 4> queue;
+    int value = -1;
+    CHECK(queue.empty());
+    CHECK(!queue.tryPop(value));
+    CHECK_EQ(value, -1);
+
+    for (int i = 0; i < 4; ++i) {
+        CHECK(queue.tryPush(i));
+    }
+    CHECK(!queue.tryPush(99)); // Pleine : rien n'est écrasé
+    CHECK(!queue.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        CHECK(queue.tryPop(value));
+        CHECK_EQ(value, i);
+    }
+    CHECK(!queue.tryPop(value));
+    CHECK(queue.empty());
+}
+
+// Les indices dépassent plusieurs fois la capacité : l'ordre FIFO et les limites tiennent à chaque tour
+static void testWrapAround() {
+    SpscQueue<int, 4> queue;
+    int next = 0;
+    int expected = 0;
+    int value = 0;
+    for (int round = 0; round < 50; ++round) {
+        // Remplissage partiel puis complet, en décalant la tête d'un cran à chaque tour
+        const int pushes = 1 + round % 4;
+        for (int i = 0; i < pushes; ++i) {
+            CHECK(queue.tryPush(next++));
+        }
+        if (pushes == 4) {
+            CHECK(!queue.tryPush(-1));
+        }
+        const int pops = round % 2 == 0 ? pushes : pushes - 1;
+        for (int i = 0; i < pops; ++i) {
+            CHECK(queue.tryPop(value));
+            CHECK_EQ(value, expected++);
+        }
+        // Vider ce qui reste avant le tour suivant
+        while (queue.tryPop(value)) {
+            CHECK_EQ(value, expected++);
+        }
+        CHECK(queue.empty());
+    }
+    CHECK_EQ(expected, next);
+}
+
+// Un producteur et un consommateur réels : aucune perte, aucun doublon, ordre conservé
+static void testProducerConsumer() {
+    const int COUNT = 200000;
+    SpscQueue<int, 64> queue;
+    std::thread producer([&queue]() {
+        for (int i = 0; i < COUNT; ++i) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int value = 0;
+    while (expected < COUNT) {
+        if (queue.tryPop(value)) {
+            if (value != expected) {
+                CHECK_EQ(value, expected);
+                break;
+            }
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    CHECK_EQ(expected, COUNT);
+    CHECK(queue.empty());
+}
+
+int main() {
+    testFullAndEmpty();
+    testWrapAround();
+    testProducerConsumer();
+    return TEST_RESULT();
+}
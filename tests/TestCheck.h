@@ -0,0 +1,36 @@
+#ifndef MUSICALAU_TESTS_TESTCHECK_H
+#define MUSICALAU_TESTS_TESTCHECK_H
+
+#include <iostream>
+
+// Vérifications minimales des tests : un échec est signalé avec sa ligne, le test continue et
+// TEST_RESULT() renvoie le code de sortie lu par ctest (0 si tout est passé).
+namespace TestCheck {
+    inline int &failures() {
+        static int count = 0;
+        return count;
+    }
+}
+
+#define CHECK(condition)                                                                            \
+    do {                                                                                            \
+        if (!(condition)) {                                                                         \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            ++TestCheck::failures();                                                                \
+        }                                                                                           \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                                  \
+    do {                                                                                            \
+        const auto &checkActual_ = (actual);                                                        \
+        const auto &checkExpected_ = (expected);                                                    \
+        if (!(checkActual_ == checkExpected_)) {                                                    \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK_EQ failed: " #actual " == " #expected \
+                      << " (" << checkActual_ << " != " << checkExpected_ << ")" << std::endl;      \
+            ++TestCheck::failures();                                                                \
+        }                                                                                           \
+    } while (0)
+
+#define TEST_RESULT() (TestCheck::failures() == 0 ? 0 : 1)
+
+#endif // MUSICALAU_TESTS_TESTCHECK_H
@@ -0,0 +1,124 @@
+#include "../include/Audio/Wavetable.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using MusicApp::Audio::Wavetable;
+namespace Wavetables = MusicApp::Audio::Wavetables;
+
+namespace {
+    const float SAMPLE_RATE = 44100.0f;
+    const int FRAMES = 4096;
+
+    // Écart entre la table et l'ancien générateur sur une note
+    struct Deviation {
+        double maximum;
+        double rms;
+    };
+
+    double midiToFrequency(int midiNumber) {
+        return 440.0 * std::pow(2.0, (midiNumber - 69) / 12.0);
+    }
+
+    // Fait avancer la table comme les générateurs (accumulateur 32 bits) et compare chaque échantillon
+    // à la référence, calculée avec std::sin sur la même phase en double précision
+    template<int Layers, typename Weights, typename Reference>
+    Deviation compare(const Wavetable &table, double frequency, Weights weights, Reference reference) {
+        const float *mip = table.mipFor(static_cast<float>(frequency));
+        const Uint32 increment = Wavetable::phaseIncrement(static_cast<float>(frequency), SAMPLE_RATE);
+        const double radiansPerStep = 2.0 * M_PI * increment / 4294967296.0;
+
+        Uint32 phase = 0;
+        double maximum = 0.0;
+        double squares = 0.0;
+        for (int i = 0; i < FRAMES; ++i) {
+            float layers[Layers];
+            Wavetable::read<Layers>(mip, phase, layers);
+            const double error = weights(layers) - reference(radiansPerStep * i);
+            maximum = std::max(maximum, std::abs(error));
+            squares += error * error;
+            phase += increment;
+        }
+        return {maximum, std::sqrt(squares / FRAMES)};
+    }
+}
+
+// Mélange du piano (PianoInstrument) contre l'ancienne somme de std::sin de SDLAudioEngine::generateAudioChunk,
+// de Do2 à Do7 : toutes les harmoniques y restent sous Nyquist, seule l'interpolation de la table diffère
+static void testPianoMatchesSineSum() {
+    for (float velocity: {0.4f, 1.0f}) {
+        const float harmonic_factor = velocity * 1.3f;
+        for (int midiNumber = 36; midiNumber <= 96; midiNumber += 5) {
+            const Deviation deviation = compare<4>(
+                    Wavetables::piano(), midiToFrequency(midiNumber),
+                    [&](const float *layers) {
+                        return layers[0] + layers[1] * harmonic_factor + layers[2] * harmonic_factor * velocity +
+                               layers[3] * harmonic_factor * velocity * velocity;
+                    },
+                    [&](double phase) {
+                        return std::sin(phase) + 0.5 * std::sin(phase * 2.0) * harmonic_factor +
+                               0.3 * std::sin(phase * 3.0) * harmonic_factor +
+                               0.2 * std::sin(phase * 4.0) * harmonic_factor * velocity +
+                               0.1 * std::sin(phase * 5.0) * harmonic_factor * velocity * velocity;
+                    });
+            CHECK(deviation.maximum < 1e-4);
+            CHECK(deviation.rms < 5e-5);
+        }
+    }
+}
+
+// Même comparaison pour le xylophone (generateXylophoneAudioChunk), de Do2 à Do6 (harmonique 6 sous Nyquist)
+static void testXylophoneMatchesSineSum() {
+    for (float velocity: {0.4f, 1.0f}) {
+        const float brightness_factor = 0.8f + velocity * 0.4f;
+        for (int midiNumber = 36; midiNumber <= 84; midiNumber += 4) {
+            const Deviation deviation = compare<3>(
+                    Wavetables::xylophone(), midiToFrequency(midiNumber),
+                    [&](const float *layers) {
+                        return layers[0] + layers[1] * brightness_factor + layers[2] * brightness_factor * velocity;
+                    },
+                    [&](double phase) {
+                        return std::sin(phase) + 0.5 * std::sin(phase * 2.0) * brightness_factor +
+                               0.33 * std::sin(phase * 4.0) * brightness_factor +
+                               0.25 * std::sin(phase * 6.0) * brightness_factor * velocity;
+                    });
+            CHECK(deviation.maximum < 1e-4);
+            CHECK(deviation.rms < 5e-5);
+        }
+    }
+}
+
+// Au-dessus, l'ancien générateur repliait les harmoniques au-delà de Nyquist : la table les retire.
+// Do8 (4186 Hz) au xylophone : l'harmonique 6 (25 kHz) disparaît, les autres restent identiques
+static void testHighNotesDropAliasedHarmonics() {
+    const Deviation deviation = compare<3>(
+            Wavetables::xylophone(), midiToFrequency(108),
+            [](const float *layers) { return layers[0] + layers[1] + layers[2]; },
+            [](double phase) { return std::sin(phase) + 0.5 * std::sin(phase * 2.0) + 0.33 * std::sin(phase * 4.0); });
+    CHECK(deviation.maximum < 1e-4);
+}
+
+// Console 8-bit : l'ancien signe de std::sin contre le carré à bande limitée ; seuls les fronts diffèrent
+// (phénomène de Gibbs et harmoniques retirées), l'écart quadratique reste faible pour les notes jouées
+static void testSquareFollowsSignOfSine() {
+    for (int midiNumber = 36; midiNumber <= 72; midiNumber += 12) {
+        const double frequency = midiToFrequency(midiNumber);
+        const Deviation deviation = compare<1>(
+                Wavetables::square(), frequency,
+                [](const float *layers) { return layers[0]; },
+                [](double phase) { return std::sin(phase) > 0.0 ? 1.0 : -1.0; });
+        CHECK(deviation.rms < 0.15);
+    }
+}
+
+int main() {
+    testPianoMatchesSineSum();
+    testXylophoneMatchesSineSum();
+    testHighNotesDropAliasedHarmonics();
+    testSquareFollowsSignOfSine();
+    return TEST_RESULT();
+}